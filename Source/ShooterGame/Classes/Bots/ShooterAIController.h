@@ -25,8 +25,13 @@ public:
 	virtual void GameHasEnded(class AActor* EndGameFocus = NULL, bool bIsWinner = false) override;
 	virtual void Possess(class APawn* InPawn) override;
 	virtual void BeginInactiveState() override;
+	virtual void UnPossess() override;
 	// End APlayerController interface
 
+	// Begin AActor interface
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	// End AActor interface
+
 	void Respawn();
 
 	void CheckAmmo(const class AShooterWeapon* CurrentWeapon);
@@ -48,6 +53,20 @@ public:
 		
 	bool HasWeaponLOSToEnemy(AActor* InEnemyActor, const bool bAnyEnemy) const;
 
+	/**
+	 * Line of sight trace for bot decisions. Goes through the game mode's async trace service when there is one,
+	 * in which case the result is the one of the same query made last frame.
+	 *
+	 * @return false if no result is known yet
+	 */
+	bool TraceLineOfSight(const AActor* Target, const FVector& Start, const FVector& End, ECollisionChannel Channel, const FCollisionQueryParams& Params, FHitResult& OutHit) const;
+
+	/** [server] notify that our pawn took damage, makes the brain scheduler favor us for a while */
+	void NotifyTookDamage();
+
+	/** get world time of last damage taken, 0 if never */
+	float GetLastDamageTime() const;
+
 	// Begin AAIController interface
 	/** Update direction AI is looking based on FocalPoint */
 	virtual void UpdateControlRotation(float DeltaTime, bool bUpdatePawn = true) override;
@@ -60,6 +79,12 @@ protected:
 	int32 EnemyKeyID;
 	int32 NeedAmmoKeyID;
 
+	/** world time of last damage taken */
+	float LastDamageTime;
+
+	/** tell the game mode's lightweight bots or brain scheduler to take over (or give back) our decisions */
+	void SetScheduledByGameMode(bool bScheduled);
+
 public:
 	/** Returns BlackboardComp subobject **/
 	FORCEINLINE UBlackboardComponent* GetBlackboardComp() const { return BlackboardComp; }
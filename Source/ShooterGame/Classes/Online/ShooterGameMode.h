@@ -15,6 +15,13 @@ class AShooterGameMode : public AGameMode
 	UFUNCTION(exec)
 	void SetAllowBots(bool bInAllowBots, int32 InMaxBots = 8);
 
+	/** change time budget for bot behavior trees, in microseconds per frame */
+	UFUNCTION(exec)
+	void SetBotBrainBudget(float InBudgetMicroseconds);
+
+	/** ticks bot brains within budget */
+	virtual void Tick(float DeltaSeconds) override;
+
 	/** Initialize the game. This is called before actors' PreInitializeComponents. */
 	virtual void InitGame(const FString& MapName, const FString& Options, FString& ErrorMessage) override;
 
@@ -39,6 +46,9 @@ class AShooterGameMode : public AGameMode
 	/** notify about kills */
 	virtual void Killed(AController* Killer, AController* KilledPlayer, APawn* KilledPawn, const UDamageType* DamageType);
 
+	/** [server] notify about damage taken by a pawn, marks the area as dangerous */
+	void NotifyPawnDamaged(class AShooterCharacter* DamagedPawn, float Damage);
+
 	/** can players damage each other? */
 	virtual bool CanDealDamage(class AShooterPlayerState* DamageInstigator, class AShooterPlayerState* DamagedPlayer) const;
 
@@ -63,6 +73,36 @@ class AShooterGameMode : public AGameMode
 	/** Create a bot */
 	AShooterAIController* CreateBot(int32 BotNum);	
 
+	/** get scheduler running bot behavior trees, NULL when bots tick on their own */
+	class FShooterBotScheduler* GetBotScheduler() const;
+
+	/** get service running bot line of sight traces asynchronously, NULL when bots trace synchronously */
+	class FShooterAITraceService* GetAITraceService() const;
+
+	/** get positions bots pick when fighting, NULL when disabled */
+	class FShooterTacticalPoints* GetTacticalPoints() const;
+
+	/** get map of where the fighting is, NULL when disabled */
+	class FShooterInfluenceMap* GetInfluenceMap() const;
+
+	/** get system driving all bots without behavior trees, NULL unless bUseLightweightBots is set */
+	class FShooterLightweightBots* GetLightweightBots() const;
+
+	/** [server] send match event to everyone subscribed to it */
+	void BroadcastMatchEvent(struct FShooterMatchEvent& Event);
+
+	/** get match event bus, for subscribing */
+	class FShooterMatchEventBus* GetMatchEvents() const;
+
+	/** get stats aggregated from match events */
+	const class FShooterMatchStats* GetMatchStats() const;
+
+	/** get numbers of player in the match that just ended, from the match stats */
+	FShooterMatchResult MakeMatchResult(class AShooterPlayerState* PlayerState, bool bRoundCompleted) const;
+
+	/** get rate limit of client RPC, NULL when client RPCs are not limited */
+	const FShooterRpcLimit* GetClientRpcLimit(EShooterServerRpc::Type Rpc) const;
+
 protected:
 
 	/** delay between first player login and starting match */
@@ -91,8 +131,117 @@ protected:
 	UPROPERTY(config)
 	int32 MaxBots;
 
+	/** run bot behavior trees from a central scheduler instead of every frame */
+	UPROPERTY(config)
+	bool bUseBotScheduler;
+
+	/** time budget for bot behavior trees (microseconds per frame) */
+	UPROPERTY(config)
+	float BotBrainBudgetMicroseconds;
+
+	/** how long a damaged bot gets scheduled ahead of others (seconds) */
+	UPROPERTY(config)
+	float BotUrgencyWindow;
+
+	/** drive bots from one data oriented tick instead of behavior trees, for load tests; also set by the LightweightBots URL option */
+	UPROPERTY(config)
+	bool bUseLightweightBots;
+
+	/** keep blackboards of lightweight bots up to date, for debugging only */
+	UPROPERTY(config)
+	bool bMirrorLightweightBotsToBlackboard;
+
+	/** run bot line of sight traces on the async trace queue, results arrive one frame late */
+	UPROPERTY(config)
+	bool bUseAsyncAITraces;
+
+	/** move bots between precomputed tactical points instead of random navmesh points when fighting */
+	UPROPERTY(config)
+	bool bUseTacticalPoints;
+
+	/** keep a coarse map of recent kills, damage and pawn presence for bots and spawn selection */
+	UPROPERTY(config)
+	bool bUseInfluenceMap;
+
+	/** how often pawn presence is stamped into the influence map (per second) */
+	UPROPERTY(config)
+	float InfluenceUpdateRate;
+
+	/** time for danger and presence to fade to half (seconds) */
+	UPROPERTY(config)
+	float InfluenceHalfLife;
+
+	/** spawn points with more danger than this are used only when nothing else is free, 1 is about one recent kill */
+	UPROPERTY(config)
+	float SpawnDangerThreshold;
+
+	/** time between replay keyframes while a demo is recorded (seconds) */
+	UPROPERTY(config)
+	float ReplayKeyframeInterval;
+
+	/** on dedicated servers, write pawn positions, shots and hits of every match to Saved/Telemetry */
+	UPROPERTY(config)
+	bool bRecordTelemetry;
+
+	/** on dedicated servers, serve live metrics on this loopback port, 0 to disable; -MetricsPort= on the command line overrides it */
+	UPROPERTY(config)
+	int32 MetricsPort;
+
+	/** rate limit RPCs sent by each client, calls over the limit are ignored and floods get the client kicked */
+	UPROPERTY(config)
+	bool bLimitClientRpcs;
+
+	UPROPERTY(config)
+	FShooterRpcLimit ServerNotifyHitLimit;
+
+	UPROPERTY(config)
+	FShooterRpcLimit ServerNotifyMissLimit;
+
+	UPROPERTY(config)
+	FShooterRpcLimit ServerSetGravityModeLimit;
+
+	/** sent every client frame, so only dropped, never kicked by default */
+	UPROPERTY(config)
+	FShooterRpcLimit ServerSetFullControlRotationLimit;
+
+	UPROPERTY(config)
+	FShooterRpcLimit ServerHandleFiringLimit;
+
 	UPROPERTY()
 	TArray<AShooterAIController*> BotControllers;
+
+	/** runs bot behavior trees within BotBrainBudgetMicroseconds */
+	TSharedPtr<class FShooterBotScheduler> BotScheduler;
+
+	/** replaces behavior trees of all bots, only when bUseLightweightBots is set */
+	TSharedPtr<class FShooterLightweightBots> LightweightBots;
+
+	/** batches bot line of sight traces, only when bUseAsyncAITraces is set */
+	TSharedPtr<class FShooterAITraceService> AITraceService;
+
+	/** loaded or baked over several frames once the first match starts, only when bUseTacticalPoints is set */
+	TSharedPtr<class FShooterTacticalPoints> TacticalPoints;
+
+	/** danger and presence grid, sized when the first match starts, only when bUseInfluenceMap is set */
+	TSharedPtr<class FShooterInfluenceMap> InfluenceMap;
+
+	/** samples frame times and quits after -SoakTicks frames, only when that is on the command line */
+	TSharedPtr<class FShooterSoakTest> SoakTest;
+
+	/** dispatches kills, shots, pickups, flips and match end to subscribers */
+	TSharedPtr<class FShooterMatchEventBus> MatchEvents;
+
+	/** match totals, kept up to date from MatchEvents */
+	TSharedPtr<class FShooterMatchStats> MatchStats;
+
+	/** keyframes and notable events of the demo being recorded, followed by the camera during playback */
+	TSharedPtr<class FShooterReplayRecorder> ReplayRecorder;
+
+	/** streams match telemetry to disk, only when bRecordTelemetry is set on a dedicated server */
+	TSharedPtr<class FShooterTelemetryRecorder> TelemetryRecorder;
+
+	/** serves frame times, counts and RPC rates to local scrapers, only when MetricsPort is set on a dedicated server */
+	TSharedPtr<class FShooterServerMetrics> ServerMetrics;
 	
 	bool bNeedsBotCreation;
 
@@ -107,6 +256,12 @@ protected:
 	/** check who won */
 	virtual void DetermineMatchWinner();
 
+	/** finish current match and lock players, won/lost events are only sent for a round that ran out of time */
+	void EndMatchAndNotify(bool bRoundCompleted);
+
+	/** send results to every player in one pass, subscribed to the match end event */
+	void HandleMatchEnd(const struct FShooterMatchEvent& Event);
+
 	/** check if PlayerState is a winner */
 	virtual bool IsWinner(class AShooterPlayerState* PlayerState) const;
 
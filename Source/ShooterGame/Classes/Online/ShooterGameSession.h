@@ -15,6 +15,10 @@ struct FShooterGameSessionParams
 	TSharedPtr<FUniqueNetId> UserId;
 	/** Current search result choice to join */
 	int32 BestSessionIdx;
+	/** Game type matchmaking prefers, empty for any */
+	FString PreferredGameType;
+	/** Map matchmaking prefers, empty for any */
+	FString PreferredMapName;
 
 	FShooterGameSessionParams()
 		: SessionName(NAME_None)
@@ -49,6 +53,34 @@ protected:
 	TSharedPtr<class FShooterOnlineSessionSettings> HostSettings;
 	/** Current search settings */
 	TSharedPtr<class FShooterOnlineSearchSettings> SearchSettings;
+	/** Search result indices in the order matchmaking tries them, best first */
+	TArray<int32> RankedSessionIndices;
+	/** Next entry of RankedSessionIndices to try */
+	int32 NextRankedSession;
+	/** FindMatch is searching or joining */
+	bool bMatchmaking;
+	/** CancelMatchmaking was called, no further session is tried */
+	bool bMatchmakingCanceled;
+
+	/** Sessions with a higher ping are never picked by matchmaking (ms) */
+	UPROPERTY(config)
+	int32 MatchmakingMaxPing;
+
+	/** Matchmaking score lost per ms of ping */
+	UPROPERTY(config)
+	float MatchmakingPingWeight;
+
+	/** Matchmaking score of a session with one slot left, scaled down as it empties */
+	UPROPERTY(config)
+	float MatchmakingFillWeight;
+
+	/** Matchmaking score for the preferred game type */
+	UPROPERTY(config)
+	float MatchmakingGameTypeWeight;
+
+	/** Matchmaking score for the preferred map */
+	UPROPERTY(config)
+	float MatchmakingMapWeight;
 
 	/**
 	 * Delegate fired when a session create request has completed
@@ -99,6 +131,21 @@ protected:
 	 */
 	void ChooseBestSession();
 
+	/**
+	 * Score all search results and order them for matchmaking, sessions that can't be joined are left out
+	 */
+	void RankSearchResults();
+
+	/**
+	 * Score a search result for matchmaking
+	 *
+	 * @param Result search result to score
+	 * @param OutScore score, higher is better
+	 *
+	 * @return false if matchmaking should not try this session at all
+	 */
+	bool ScoreSearchResult(const FOnlineSessionSearchResult& Result, float& OutScore) const;
+
 	/**
 	 * Entry point for matchmaking after search results are returned
 	 */
@@ -114,6 +161,11 @@ protected:
 	 */
 	void OnNoMatchesAvailable();
 
+	/**
+	 * Ends FindMatch and reports the result
+	 */
+	void FinishMatchmaking(bool bWasSuccessful);
+
 	/* 
 	 * Event triggered when a presence session is created
 	 *
@@ -140,6 +192,15 @@ protected:
 	DECLARE_EVENT_OneParam(AShooterGameSession, FOnFindSessionsComplete, bool /*bWasSuccessful*/);
 	FOnFindSessionsComplete FindSessionsCompleteEvent;
 
+	/*
+	 * Event triggered when FindMatch joined a session or ran out of sessions to try
+	 *
+	 * @param SessionName name of session that was joined
+	 * @param bWasSuccessful was a session joined
+	 */
+	DECLARE_EVENT_TwoParams(AShooterGameSession, FOnMatchmakingComplete, FName /*SessionName*/, bool /*bWasSuccessful*/);
+	FOnMatchmakingComplete MatchmakingCompleteEvent;
+
 public:
 
 	/** Default number of players allowed in a game */
@@ -168,6 +229,21 @@ public:
 	 */
 	void FindSessions(TSharedPtr<FUniqueNetId> UserId, FName SessionName, bool bIsLAN, bool bIsPresence);
 
+	/**
+	 * Find online sessions and join the best ranked one, moving down the ranking while joins fail
+	 *
+	 * @param UserId user that initiated the request
+	 * @param SessionName name of session this search will generate
+	 * @param bIsLAN are we searching LAN matches
+	 * @param bIsPresence are we searching presence sessions
+	 */
+	void FindMatch(TSharedPtr<FUniqueNetId> UserId, FName SessionName, bool bIsLAN, bool bIsPresence);
+
+	/**
+	 * Stop FindMatch from trying further sessions, a join already in flight still reports its result
+	 */
+	void CancelMatchmaking();
+
 	/**
 	 * Joins one of the session in search results
 	 *
@@ -192,6 +268,14 @@ public:
 	/** @return true if any online async work is in progress, false otherwise */
 	bool IsBusy() const;
 
+	/**
+	 * Set what matchmaking prefers when ranking sessions
+	 *
+	 * @param GameType preferred game type, empty for any
+	 * @param MapName preferred map, empty for any
+	 */
+	void SetMatchmakingPreferences(const FString& GameType, const FString& MapName);
+
 	/**
 	 * Get the search results found and the current search result being probed
 	 *
@@ -218,6 +302,9 @@ public:
 	/** @return the delegate fired when search of session completes */
 	FOnFindSessionsComplete& OnFindSessionsComplete() { return FindSessionsCompleteEvent; }
 
+	/** @return the delegate fired when FindMatch completes */
+	FOnMatchmakingComplete& OnMatchmakingComplete() { return MatchmakingCompleteEvent; }
+
 	/** Handle starting the match */
 	virtual void HandleMatchHasStarted() override;
 
@@ -31,5 +31,33 @@ public:
 	/** gets ranked PlayerState map for specific team */
 	void GetRankedMap(int32 TeamIndex, RankedPlayerMap& OutRankedMap) const;	
 
+	/** gets counter that changes every time the ranking of any team changes */
+	int32 GetRankedVersion() const;
+
+	/** ranking needs to be rebuilt, called when scores or teams change */
+	void MarkRankingDirty();
+
+	// Begin AGameState interface
+	virtual void AddPlayerState(class APlayerState* PlayerState) override;
+	virtual void RemovePlayerState(class APlayerState* PlayerState) override;
+	// End AGameState interface
+
 	void RequestFinishAndExitToMainMenu();
+
+protected:
+
+	/** sorts players of each team again if ranking was marked dirty, bumps version if the order changed */
+	void UpdateRankedPlayers() const;
+
+	/** players of each team, best score first */
+	mutable TArray<TArray<TWeakObjectPtr<AShooterPlayerState> > > RankedPlayers;
+
+	/** players of one team, reused while sorting */
+	mutable TArray<AShooterPlayerState*> RankingScratch;
+
+	/** changes every time RankedPlayers changes */
+	mutable int32 RankedVersion;
+
+	/** RankedPlayers is out of date */
+	mutable bool bRankingDirty;
 };
@@ -21,6 +21,9 @@ class AShooterPlayerState : public APlayerState
 
 	virtual void UnregisterPlayerWithSession() override;
 
+	/** score replicated, ranking may have changed */
+	virtual void OnRep_Score() override;
+
 	// End APlayerState interface
 
 	/**
@@ -111,4 +114,7 @@ protected:
 
 	/** helper for scoring points */
 	void ScorePoints(int32 Points);
+
+	/** tell GameState that the ranked player lists need to be sorted again */
+	void MarkRankingDirty();
 };
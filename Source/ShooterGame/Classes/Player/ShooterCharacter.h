@@ -246,6 +246,22 @@ class AShooterCharacter : public ACharacter
 	FVector currentGravityRotatingAxis;
 	float accumulatedGravityAngle;
 	virtual void FaceRotation(FRotator NewControlRotation, float DeltaTime) override;
+
+	/** get rotation from the Z up frame to the frame of GravityMode, rebuilt only when the mode changes */
+	const FQuat& GetGravityFrame() const;
+
+	/** get up direction of GravityMode */
+	FVector GetGravityUpVector() const;
+
+	/** get rotation from the Z up frame to the frame of gravity mode */
+	static FQuat MakeGravityFrame(SBGravityMode Mode);
+
+	/** get gravity mode whose up direction is closest to Up */
+	static SBGravityMode GetGravityModeForUp(const FVector& Up);
+
+	/** eyes are BaseEyeHeight along gravity up, not world Z */
+	virtual FVector GetPawnViewLocation() const override;
+
 	/** get firing state */
 	UFUNCTION(BlueprintCallable, Category="Game|Weapon")
 	bool IsFiring() const;
@@ -491,6 +507,15 @@ protected:
 	UFUNCTION(Unreliable, Server, WithValidation)
 		void ServerSetFullControlRotation(const FRotator& NewFullControlRotation);
 
+	/** frame of CachedGravityFrameMode */
+	mutable FQuat CachedGravityFrame;
+
+	/** mode CachedGravityFrame was built for */
+	mutable TEnumAsByte<SBGravityMode> CachedGravityFrameMode;
+
+	/** set once CachedGravityFrame was built */
+	mutable bool bGravityFrameCached;
+
 protected:
 	/** Returns Mesh1P subobject **/
 	FORCEINLINE USkeletalMeshComponent* GetMesh1P() const { return Mesh1P; }
@@ -13,7 +13,45 @@ public:
 
 	virtual void SetupInputComponent() override;
 	virtual void SetPlayer( UPlayer* Player ) override;
+	virtual void PlayerTick( float DeltaTime ) override;
 
 	void OnToggleInGameMenu();
+
+	/**
+	 * toggle moving the camera to the player of each kill or gravity flip of the replay index, shortly before it happens.
+	 * The 4.6 demo driver can't load checkpoints, so playback can't seek; following events is what the index is used for.
+	 */
+	UFUNCTION(exec)
+	void DemoFollowEvents( bool bEnable );
+
+	/** is camera following events */
+	bool IsFollowingEvents() const;
+
+	/** get time since start of the demo (seconds) */
+	float GetDemoTime() const;
+
+protected:
+	/** follow events when playback starts */
+	UPROPERTY(config)
+	bool bFollowEvents;
+
+	/** how long before an event the camera moves to its player (seconds) */
+	UPROPERTY(config)
+	float EventLeadTime;
+
+	/** keyframes and events recorded with the demo, empty if it has none */
+	TSharedPtr<struct FShooterReplayIndex> ReplayIndex;
+
+	/** name of demo being played */
+	FString DemoName;
+
+	/** world time playback started at */
+	float PlaybackStartTime;
+
+	/** time of the last event the camera moved for */
+	float LastFollowedEventTime;
+
+	/** puts camera on player, or where the keyframe before Time had them if they have no pawn */
+	void LookAtPlayer( const FString& PlayerName, float Time );
 };
 
@@ -14,6 +14,9 @@ public:
 
 	virtual FString GetNickname() const;
 
+	/** nickname this player would get for online nickname when using controller, also names its persistent user slot */
+	FString GetNicknameFor(const FString& OnlineNickname, int32 InControllerId) const;
+
 	class UShooterPersistentUser* GetPersistentUser() const;
 	
 	/** Initializes the PersistentUser */
@@ -12,12 +12,18 @@ public:
 	/** Loads user persistence data if it exists, creates an empty record otherwise. */
 	static UShooterPersistentUser* LoadPersistentUser(FString SlotName, const int32 UserIndex);
 
+	/** Starts reading user persistence data in the background, so a later LoadPersistentUser doesn't have to wait for the disk. */
+	static void PrefetchPersistentUser(const FString& SlotName);
+
 	/** Saves data if anything has changed. */
 	void SaveIfDirty();
 
 	/** Records the result of a match. */
 	void AddMatchResult(int32 MatchKills, int32 MatchDeaths, int32 MatchBulletsFired, int32 MatchRocketsFired, bool bIsMatchWinner);
 
+	/** Adds a finished match to the match history. The file is written in the background. */
+	void AddMatchRecord(const struct FShooterMatchRecord& Record);
+
 	/** needed because we can recreate the subsystem that stores it */
 	void TellInputAboutKeybindings();
 
@@ -99,9 +105,15 @@ protected:
 	/** Checks if the Inverted Mouse user setting is different from current */
 	bool IsInvertedYAxisDirty() const;
 
-	/** Triggers a save of this data. */
+	/** Triggers a save of this data. The file is written in the background. */
 	void SavePersistentUser();
 
+	/** Copies saved fields to snapshot. */
+	void WriteTo(struct FShooterPersistentUserData& OutData) const;
+
+	/** Copies saved fields from snapshot. */
+	void ReadFrom(const struct FShooterPersistentUserData& Data);
+
 	/** Lifetime count of kills */
 	UPROPERTY()
 	int32 Kills;
@@ -32,6 +32,10 @@ public:
 	UFUNCTION(reliable, client)
 	void ClientSendRoundEndEvent(bool bIsWinner, int32 ExpendedTimeInSeconds);
 
+	/** save results of finished match, update achievements and leaderboards and send the end-of-round event */
+	UFUNCTION(reliable, client)
+	void ClientMatchEnded(const FShooterMatchResult& Result);
+
 	/** used for input simulation from blueprint (for automatic perf tests) */
 	UFUNCTION(BlueprintCallable, Category="Input")
 	void SimulateInputKey(FKey Key, bool bPressed = true);
@@ -169,6 +173,9 @@ public:
 	/** Associate a new UPlayer with this PlayerController. */
 	virtual void SetPlayer(UPlayer* Player);
 
+	/** [server] get rate limits of RPCs sent by this client, NULL on clients */
+	class FShooterRpcLimiter* GetRpcLimiter();
+
 	// end AShooterPlayerController-specific
 
 	virtual void PreClientTravel(const FString& PendingURL, ETravelType TravelType, bool bIsSeamlessTravel) override;
@@ -210,6 +217,9 @@ protected:
 	/** shooter in-game menu */
 	TSharedPtr<class FShooterIngameMenu> ShooterIngameMenu;
 
+	/** [server] token buckets for RPCs of this client, created on first RPC */
+	TSharedPtr<class FShooterRpcLimiter> RpcLimiter;
+
 	/** Achievements write object */
 	FOnlineAchievementsWritePtr WriteObject;
 
@@ -244,14 +254,6 @@ protected:
 	/** sets up input */
 	virtual void SetupInputComponent() override;
 
-	/**
-	 * Called from game info upon end of the game, used to transition to proper state. 
-	 *
-	 * @param EndGameFocus Actor to set as the view target on end game
-	 * @param bIsWinner true if this controller is on winning team
-	 */
-	virtual void GameHasEnded(class AActor* EndGameFocus = NULL, bool bIsWinner = false) override;	
-
 	/** Return the client to the main menu gracefully.  ONLY sets GI state. */
 	void ClientReturnToMainMenu_Implementation(const FString& ReturnReason) override;
 
@@ -263,8 +265,11 @@ protected:
 	UFUNCTION(reliable, server, WithValidation)
 	void ServerSuicide();
 
-	/** Updates achievements based on the PersistentUser stats at the end of a round */
-	void UpdateAchievementsOnGameEnd();
+	/** Updates achievements based on the PersistentUser stats and the results of the round that just ended */
+	void UpdateAchievementsOnGameEnd(const FShooterMatchResult& Result);
+
+	/** Makes match history entry from the results the server sent for the match that just ended */
+	struct FShooterMatchRecord MakeMatchRecord(const FShooterMatchResult& Result) const;
 
 	// End APlayerController interface
 
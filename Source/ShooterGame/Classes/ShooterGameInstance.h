@@ -91,6 +91,15 @@ public:
 	/** Begin a hosted quick match */
 	void BeginHostingQuickMatch();
 
+	/** Start loading map package (e.g. /Game/Maps/Sanctuary) in the background, so travelling to it later is quick */
+	void PreloadMap(const FString& MapPackageName);
+
+	/** Drop reference to map requested by PreloadMap, so garbage collection can reclaim it */
+	void CancelMapPreload();
+
+	/** Percentage of the preloaded map that is loaded, 100 when done, negative if no map is being preloaded */
+	float GetMapPreloadPercentage() const;
+
 	/** Initiates the session searching */
 	bool FindSessions(ULocalPlayer* PlayerOwner, bool bLANMatch);
 
@@ -208,6 +217,16 @@ private:
 	/** Delegate for callbacks to Tick */
 	FTickerDelegate TickDelegate;
 
+	/** scripted latency test, only when -NetTest is on the command line */
+	TSharedPtr<class FShooterNetTest> NetTest;
+
+	/** Map package requested by PreloadMap */
+	FName PreloadMapName;
+
+	/** Preloaded map package, referenced so it survives garbage collection until we travel to it */
+	UPROPERTY()
+	UPackage* PreloadedMapPackage;
+
 	void HandleSessionUserInviteAccepted( 
 		const bool							bWasSuccess, 
 		const int32							ControllerId, 
@@ -284,6 +303,12 @@ private:
 
 	bool LoadFrontEndMap(const FString& MapName);
 
+	/** Called when a map package requested by PreloadMap has finished loading */
+	void OnMapPreloaded(const FName& PackageName, UPackage* LoadedPackage);
+
+	/** Feeds map preloading and level streaming progress to the loading screen */
+	void UpdateLoadingProgress();
+
 	/** Sets a rich presence string for all local players. */
 	void SetPresenceForLocalPlayers(const FVariantData& PresenceData);
 
@@ -59,6 +59,20 @@ namespace EShooterPhysMaterialType
 	};
 }
 
+/** client to server RPCs that are counted and rate limited */
+namespace EShooterServerRpc
+{
+	enum Type
+	{
+		NotifyHit,
+		NotifyMiss,
+		SetGravityMode,
+		SetFullControlRotation,
+		HandleFiring,
+		MAX,
+	};
+}
+
 namespace EShooterDialogType
 {
 	enum Type
@@ -212,4 +226,90 @@ public:
 	{
 		EnsureReplicationByte++;
 	}
-};
\ No newline at end of file
+};
+
+/** token bucket limit for one client to server RPC, per connection */
+USTRUCT()
+struct FShooterRpcLimit
+{
+	GENERATED_USTRUCT_BODY()
+
+	/** calls per second refilled into the bucket, 0 for no limit */
+	UPROPERTY()
+	float CallsPerSecond;
+
+	/** calls allowed in a burst, size of the bucket */
+	UPROPERTY()
+	float Burst;
+
+	/** calls dropped within 10 seconds before the client is kicked, 0 to only drop */
+	UPROPERTY()
+	int32 KickAfterDrops;
+
+	FShooterRpcLimit()
+		: CallsPerSecond(0.0f)
+		, Burst(0.0f)
+		, KickAfterDrops(0)
+	{}
+
+	FShooterRpcLimit(float InCallsPerSecond, float InBurst, int32 InKickAfterDrops)
+		: CallsPerSecond(InCallsPerSecond)
+		, Burst(InBurst)
+		, KickAfterDrops(InKickAfterDrops)
+	{}
+};
+
+/** numbers of one player in a finished match, from the match stats of the server */
+USTRUCT()
+struct FShooterMatchResult
+{
+	GENERATED_USTRUCT_BODY()
+
+	UPROPERTY()
+	uint32 bWon:1;
+
+	/** match ran out of time, rather than being ended early by the host */
+	UPROPERTY()
+	uint32 bRoundCompleted:1;
+
+	UPROPERTY()
+	int32 DurationSeconds;
+
+	UPROPERTY()
+	int32 Score;
+
+	UPROPERTY()
+	int32 Kills;
+
+	UPROPERTY()
+	int32 Deaths;
+
+	UPROPERTY()
+	int32 BulletsFired;
+
+	UPROPERTY()
+	int32 RocketsFired;
+
+	UPROPERTY()
+	int32 BulletsHit;
+
+	UPROPERTY()
+	int32 RocketsHit;
+
+	UPROPERTY()
+	int32 GravityFlips;
+
+	FShooterMatchResult()
+		: bWon(false)
+		, bRoundCompleted(false)
+		, DurationSeconds(0)
+		, Score(0)
+		, Kills(0)
+		, Deaths(0)
+		, BulletsFired(0)
+		, RocketsFired(0)
+		, BulletsHit(0)
+		, RocketsHit(0)
+		, GravityFlips(0)
+	{}
+};
@@ -19,13 +19,95 @@ struct FHitData
 	}
 };
 
+/** Text drawn by the HUD, formatted only when the values it shows change and measured only once. */
+struct FHUDCachedText
+{
+	/** Text as drawn. */
+	FText Text;
+
+	/** Values the text was made from. */
+	int32 KeyA;
+	int32 KeyB;
+
+	/** Unscaled size of the text, valid once MeasuredFont is set. */
+	FVector2D Size;
+
+	/** Font the text was measured with. */
+	UFont* MeasuredFont;
+
+	/** Has the text been set at all. */
+	bool bIsSet;
+
+	/** Initialise defaults. */
+	FHUDCachedText()
+		: KeyA(0)
+		, KeyB(0)
+		, Size(FVector2D::ZeroVector)
+		, MeasuredFont(NULL)
+		, bIsSet(false)
+	{
+	}
+
+	/** Does the text show given values. */
+	bool Matches(int32 InKeyA, int32 InKeyB = 0) const
+	{
+		return bIsSet && KeyA == InKeyA && KeyB == InKeyB;
+	}
+
+	/** Sets new text, it will be measured again on next draw. */
+	void Set(const FText& InText, int32 InKeyA = 0, int32 InKeyB = 0)
+	{
+		Text = InText;
+		KeyA = InKeyA;
+		KeyB = InKeyB;
+		MeasuredFont = NULL;
+		bIsSet = true;
+	}
+};
+
+/** Icon queued for batched drawing. */
+struct FHUDBatchedIcon
+{
+	/** Texture of the icon. */
+	UTexture* Texture;
+
+	/** Top left corner on canvas. */
+	FVector2D Position;
+
+	/** Size on canvas. */
+	FVector2D Size;
+
+	/** Texture coordinates. */
+	FVector2D UV0;
+	FVector2D UV1;
+
+	/** Vertex color. */
+	FLinearColor Color;
+};
+
+/** Info string drawn in the middle of the screen (Waiting to respawn etc). */
+struct FHUDInfoItem
+{
+	/** Text item to draw. */
+	FCanvasTextItem TextItem;
+
+	/** Unscaled size of the text. */
+	FVector2D Size;
+
+	FHUDInfoItem(const FCanvasTextItem& InTextItem, const FVector2D& InSize)
+		: TextItem(InTextItem)
+		, Size(InSize)
+	{
+	}
+};
+
 struct FDeathMessage
 {
 	/** Name of player scoring kill. */
-	FString KillerDesc;
+	FHUDCachedText KillerDesc;
 
 	/** Name of killed player. */
-	FString VictimDesc;
+	FHUDCachedText VictimDesc;
 
 	/** Killer is local player. */
 	uint8 bKillerIsOwner : 1;
@@ -240,7 +322,7 @@ protected:
 	FFontRenderInfo ShadowedFont;
 
 	/** Big "KILLED [PLAYER]" message text above the crosshair. */
-	FText CenteredKillMessage;
+	FHUDCachedText CenteredKillMessage;
 
 	/** last time we killed someone. */
 	float LastKillTime;
@@ -303,7 +385,34 @@ protected:
 	TSharedPtr<class SChatWidget> ChatWidget;
 
 	/** Array of information strings to render (Waiting to respawn etc) */
-	TArray<FCanvasTextItem> InfoItems;
+	TArray<FHUDInfoItem> InfoItems;
+
+	/** Icons waiting for FlushIcons. */
+	TArray<FHUDBatchedIcon> BatchedIcons;
+
+	/** Cached HUD texts, see FHUDCachedText. */
+	FHUDCachedText NetModeText;
+	FHUDCachedText WarmupText;
+	FHUDCachedText MatchTimeText;
+	FHUDCachedText PlaceText;
+	FHUDCachedText KillsLabelText;
+	FHUDCachedText KillsText;
+	FHUDCachedText KilledText;
+	FHUDCachedText PrimaryClipText;
+	FHUDCachedText PrimaryAmmoText;
+	FHUDCachedText SecondaryAmmoText;
+	FHUDCachedText RespawnText;
+	FHUDCachedText NoAmmoText;
+
+	/** GameState ranking version the placement was computed for. */
+	int32 PlaceRankedVersion;
+
+	/** PlayerState the placement was computed for. */
+	TWeakObjectPtr<class AShooterPlayerState> PlacePlayerState;
+
+	/** Owner position and number of ranked players (or teams with players in team games). */
+	int32 PlacePosition;
+	int32 PlaceCount;
 
 	/** Called every time game is started. */
 	virtual void PostInitializeComponents() override;
@@ -348,7 +457,16 @@ protected:
 	float DrawRecentlyKilledPlayer();
 
 	/** Temporary helper for drawing text-in-a-box. */
-	void DrawDebugInfoString(const FString& Text, float PosX, float PosY, bool bAlignLeft, bool bAlignTop, const FColor& TextColor);
+	void DrawDebugInfoString(FHUDCachedText& Text, float PosX, float PosY, bool bAlignLeft, bool bAlignTop, const FColor& TextColor);
+
+	/** Gets unscaled size of cached text in given font, measuring it only if needed. */
+	const FVector2D& GetTextSize(FHUDCachedText& Text, UFont* Font);
+
+	/** Queues icon to be drawn by FlushIcons, with Canvas->DrawIcon placement and clipping rules. */
+	void BatchIcon(const FCanvasIcon& Icon, float X, float Y, float Scale, const FColor& Color);
+
+	/** Draws queued icons, icons sharing texture are submitted in a single batch. */
+	void FlushIcons();
 
 	/** helper for getting uv coords in normalized top,left, bottom, right format */
 	void MakeUV(FCanvasIcon& Icon, FVector2D& UV0, FVector2D& UV1, uint16 U, uint16 V, uint16 UL, uint16 VL);
@@ -364,8 +482,9 @@ protected:
 	 * Add information string that will be displayed on the hud. They are added as required and rendered together to prevent overlaps 
 	 * 
 	 * @param InInfoString	InInfoString
+	 * @param InTextSize	Unscaled size of the text
 	*/
-	void AddMatchInfoString(const FCanvasTextItem InfoItem);
+	void AddMatchInfoString(const FCanvasTextItem InfoItem, const FVector2D& InTextSize);
 
 	/*
 	* Render the info messages.
@@ -114,8 +114,8 @@ bool UBTDecorator_HasLoSTo::LOSTrace(AActor* InActor, AActor* InEnemyActor, cons
 			TraceParams.AddIgnoredActor(MyBot);
 			const FVector StartLocation = MyBot->GetActorLocation();
 			FHitResult Hit(ForceInit);
-			GetWorld()->LineTraceSingle(Hit, StartLocation, EndLocation, COLLISION_WEAPON, TraceParams);
-			if (Hit.bBlockingHit == true)
+			const bool bHasResult = MyController->TraceLineOfSight(InEnemyActor, StartLocation, EndLocation, COLLISION_WEAPON, TraceParams, Hit);
+			if (bHasResult && Hit.bBlockingHit == true)
 			{
 				// We hit something. If we have an actor supplied, just check if the hit actor is an enemy. If it is consider that 'has LOS'
 				AActor* HitActor = Hit.GetActor();
@@ -150,8 +150,9 @@ bool UBTDecorator_HasLoSTo::LOSTrace(AActor* InActor, AActor* InEnemyActor, cons
 					if (InEnemyActor == NULL)
 					{
 						// We were not given an actor - so check of the distance between what we hit and the target. If what we hit is further away than the target we should be able to hit our target.
-						FVector HitDelta = Hit.ImpactPoint - StartLocation;
-						FVector TargetDelta = EndLocation - StartLocation;
+						// the result may be from last frame, measure from where it was traced
+						FVector HitDelta = Hit.ImpactPoint - Hit.TraceStart;
+						FVector TargetDelta = EndLocation - Hit.TraceStart;
 						if (TargetDelta.Size() < HitDelta.Size())
 						{
 							bHasLOS = true;
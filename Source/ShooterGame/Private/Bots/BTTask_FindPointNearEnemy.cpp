@@ -3,6 +3,7 @@
 #include "ShooterGame.h"
 #include "BehaviorTree/BehaviorTreeComponent.h"
 #include "BehaviorTree/BlackboardComponent.h"
+#include "Bots/ShooterTacticalPoints.h"
 
 UBTTask_FindPointNearEnemy::UBTTask_FindPointNearEnemy(const FObjectInitializer& ObjectInitializer) 
 	: Super(ObjectInitializer)
@@ -22,8 +23,23 @@ EBTNodeResult::Type UBTTask_FindPointNearEnemy::ExecuteTask(UBehaviorTreeCompone
 	AShooterCharacter* Enemy = MyController->GetEnemy();
 	if (Enemy && MyBot)
 	{
+		const float IdealDistance = 600.0f;
+
+		// prefer a baked point that sees the enemy and nobody else went for
+		AShooterGameMode* GameMode = MyBot->GetWorld()->GetAuthGameMode<AShooterGameMode>();
+		FShooterTacticalPoints* TacticalPoints = GameMode ? GameMode->GetTacticalPoints() : NULL;
+		if (TacticalPoints && TacticalPoints->IsBuilt())
+		{
+			const int32 PointIndex = TacticalPoints->FindPointNearEnemy(MyController, MyBot->GetActorLocation(), Enemy->GetActorLocation(), IdealDistance, MyBot->GetWorld()->GetTimeSeconds());
+			if (PointIndex != INDEX_NONE)
+			{
+				MyComp->GetBlackboardComponent()->SetValueAsVector(BlackboardKey.GetSelectedKeyID(), TacticalPoints->GetLocation(PointIndex));
+				return EBTNodeResult::Succeeded;
+			}
+		}
+
 		const float SearchRadius = 200.0f;
-		const FVector SearchOrigin = Enemy->GetActorLocation() + 600.0f * (MyBot->GetActorLocation() - Enemy->GetActorLocation()).SafeNormal();
+		const FVector SearchOrigin = Enemy->GetActorLocation() + IdealDistance * (MyBot->GetActorLocation() - Enemy->GetActorLocation()).SafeNormal();
 		const FVector Loc = UNavigationSystem::GetRandomPointInRadius(MyController, SearchOrigin, SearchRadius);
 		if (Loc != FVector::ZeroVector)
 		{
@@ -4,6 +4,12 @@
 #include "BehaviorTree/BehaviorTree.h"
 #include "BehaviorTree/BehaviorTreeComponent.h"
 #include "BehaviorTree/BlackboardComponent.h"
+#include "Bots/ShooterBotScheduler.h"
+#include "Bots/ShooterAITraceService.h"
+#include "Bots/ShooterTacticalPoints.h"
+#include "Bots/ShooterLightweightBots.h"
+#include "Online/ShooterInfluenceMap.h"
+#include "ShooterSoakTest.h"
 
 AShooterAIController::AShooterAIController(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
@@ -12,6 +18,7 @@ AShooterAIController::AShooterAIController(const FObjectInitializer& ObjectIniti
 	BrainComponent = BehaviorComp = ObjectInitializer.CreateDefaultSubobject<UBehaviorTreeComponent>(this, TEXT("BehaviorComp"));	
 
 	bWantsPlayerState = true;
+	LastDamageTime = 0.0f;
 }
 
 void AShooterAIController::Possess(APawn* InPawn)
@@ -20,8 +27,23 @@ void AShooterAIController::Possess(APawn* InPawn)
 
 	AShooterBot* Bot = Cast<AShooterBot>(InPawn);
 
+	// lightweight bots have no behavior tree, the blackboard is only filled for debugging
+	AShooterGameMode* GameMode = GetWorld()->GetAuthGameMode<AShooterGameMode>();
+	FShooterLightweightBots* LightweightBots = GameMode ? GameMode->GetLightweightBots() : NULL;
+	if (LightweightBots)
+	{
+		if (LightweightBots->IsMirroringToBlackboard() && Bot && Bot->BotBehavior)
+		{
+			BlackboardComp->InitializeBlackboard(Bot->BotBehavior->BlackboardAsset);
+
+			EnemyKeyID = BlackboardComp->GetKeyID("Enemy");
+			NeedAmmoKeyID = BlackboardComp->GetKeyID("NeedAmmo");
+		}
+
+		SetScheduledByGameMode(true);
+	}
 	// start behavior
-	if (Bot && Bot->BotBehavior)
+	else if (Bot && Bot->BotBehavior)
 	{
 		BlackboardComp->InitializeBlackboard(Bot->BotBehavior->BlackboardAsset);
 
@@ -29,9 +51,71 @@ void AShooterAIController::Possess(APawn* InPawn)
 		NeedAmmoKeyID = BlackboardComp->GetKeyID("NeedAmmo");
 
 		BehaviorComp->StartTree(*(Bot->BotBehavior));
+		SetScheduledByGameMode(true);
+	}
+}
+
+void AShooterAIController::UnPossess()
+{
+	SetScheduledByGameMode(false);
+
+	// dead bots don't hold on to their spot
+	AShooterGameMode* GameMode = GetWorld() ? GetWorld()->GetAuthGameMode<AShooterGameMode>() : NULL;
+	FShooterTacticalPoints* TacticalPoints = GameMode ? GameMode->GetTacticalPoints() : NULL;
+	if (TacticalPoints)
+	{
+		TacticalPoints->ReleaseClaim(this);
+	}
+
+	Super::UnPossess();
+}
+
+void AShooterAIController::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	SetScheduledByGameMode(false);
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void AShooterAIController::SetScheduledByGameMode(bool bScheduled)
+{
+	AShooterGameMode* GameMode = GetWorld() ? GetWorld()->GetAuthGameMode<AShooterGameMode>() : NULL;
+	FShooterLightweightBots* LightweightBots = GameMode ? GameMode->GetLightweightBots() : NULL;
+	FShooterBotScheduler* Scheduler = GameMode ? GameMode->GetBotScheduler() : NULL;
+	if (LightweightBots)
+	{
+		if (bScheduled)
+		{
+			LightweightBots->RegisterBot(this);
+		}
+		else
+		{
+			LightweightBots->UnregisterBot(this);
+		}
+	}
+	else if (Scheduler)
+	{
+		if (bScheduled)
+		{
+			Scheduler->RegisterBot(this);
+		}
+		else
+		{
+			Scheduler->UnregisterBot(this);
+		}
 	}
 }
 
+void AShooterAIController::NotifyTookDamage()
+{
+	LastDamageTime = GetWorld()->GetTimeSeconds();
+}
+
+float AShooterAIController::GetLastDamageTime() const
+{
+	return LastDamageTime;
+}
+
 void AShooterAIController::BeginInactiveState()
 {
 	Super::BeginInactiveState();
@@ -56,6 +140,13 @@ void AShooterAIController::FindClosestEnemy()
 		return;
 	}
 
+	// hurt bots steer clear of enemies standing where the fighting is, or in a crowd
+	AShooterCharacter* MyShooter = Cast<AShooterCharacter>(MyBot);
+	AShooterGameMode* GameMode = GetWorld()->GetAuthGameMode<AShooterGameMode>();
+	const FShooterInfluenceMap* InfluenceMap = GameMode ? GameMode->GetInfluenceMap() : NULL;
+	const bool bAvoidDanger = InfluenceMap && MyShooter && MyShooter->Health < MyShooter->GetMaxHealth() * 0.5f;
+	const float WorldTimeSeconds = GetWorld()->GetTimeSeconds();
+
 	const FVector MyLoc = MyBot->GetActorLocation();
 	float BestDistSq = MAX_FLT;
 	AShooterCharacter* BestPawn = NULL;
@@ -65,7 +156,12 @@ void AShooterAIController::FindClosestEnemy()
 		AShooterCharacter* TestPawn = Cast<AShooterCharacter>(*It);
 		if (TestPawn && TestPawn->IsAlive() && TestPawn->IsEnemyFor(this))
 		{
-			const float DistSq = (TestPawn->GetActorLocation() - MyLoc).SizeSquared();
+			float DistSq = (TestPawn->GetActorLocation() - MyLoc).SizeSquared();
+			if (bAvoidDanger)
+			{
+				const float OtherPawns = FMath::Max(0.0f, InfluenceMap->GetPawnCount(TestPawn->GetActorLocation(), WorldTimeSeconds) - 1.0f);
+				DistSq *= 1.0f + InfluenceMap->GetDanger(TestPawn->GetActorLocation(), WorldTimeSeconds) + OtherPawns;
+			}
 			if (DistSq < BestDistSq)
 			{
 				BestDistSq = DistSq;
@@ -82,6 +178,8 @@ void AShooterAIController::FindClosestEnemy()
 
 bool AShooterAIController::FindClosestEnemyWithLOS(AShooterCharacter* ExcludeEnemy)
 {
+	SCOPE_CYCLE_COUNTER(STAT_ShooterFindClosestEnemyWithLOS);
+
 	bool bGotEnemy = false;
 	APawn* MyBot = GetPawn();
 	if (MyBot != NULL)
@@ -127,13 +225,12 @@ bool AShooterAIController::HasWeaponLOSToEnemy(AActor* InEnemyActor, const bool
 	TraceParams.bTraceAsyncScene = true;
 
 	TraceParams.bReturnPhysicalMaterial = true;	
-	FVector StartLocation = MyBot->GetActorLocation();	
-	StartLocation.Z += GetPawn()->BaseEyeHeight; //look from eyes
+	const FVector StartLocation = MyBot->GetPawnViewLocation(); //look from eyes, along gravity up
 	
 	FHitResult Hit(ForceInit);
 	const FVector EndLocation = InEnemyActor->GetActorLocation();
-	GetWorld()->LineTraceSingle(Hit, StartLocation, EndLocation, COLLISION_WEAPON, TraceParams);
-	if (Hit.bBlockingHit == true)
+	const bool bHasResult = TraceLineOfSight(InEnemyActor, StartLocation, EndLocation, COLLISION_WEAPON, TraceParams, Hit);
+	if (bHasResult && Hit.bBlockingHit == true)
 	{
 		// Theres a blocking hit - check if its our enemy actor
 		AActor* HitActor = Hit.GetActor();
@@ -168,6 +265,20 @@ bool AShooterAIController::HasWeaponLOSToEnemy(AActor* InEnemyActor, const bool
 	return bHasLOS;
 }
 
+bool AShooterAIController::TraceLineOfSight(const AActor* Target, const FVector& Start, const FVector& End, ECollisionChannel Channel, const FCollisionQueryParams& Params, FHitResult& OutHit) const
+{
+	AShooterGameMode* GameMode = GetWorld()->GetAuthGameMode<AShooterGameMode>();
+	FShooterAITraceService* TraceService = GameMode ? GameMode->GetAITraceService() : NULL;
+	if (TraceService)
+	{
+		return TraceService->RequestTrace(this, Target, Start, End, Channel, Params, OutHit);
+	}
+
+	INC_DWORD_STAT(STAT_ShooterAITraces);
+	GetWorld()->LineTraceSingle(OutHit, Start, End, Channel, Params);
+	return true;
+}
+
 void AShooterAIController::ShootEnemy()
 {
 	AShooterBot* MyBot = Cast<AShooterBot>(GetPawn());
@@ -181,9 +292,18 @@ void AShooterAIController::ShootEnemy()
 	AShooterCharacter* Enemy = GetEnemy();
 	if ( Enemy && ( Enemy->IsAlive() )&& (MyWeapon->GetCurrentAmmo() > 0) && ( MyWeapon->CanFire() == true ) )
 	{
-		if (LineOfSightTo(Enemy, MyBot->GetActorLocation()))
+		static FName ShootLosTag = FName(TEXT("AIShootLosTrace"));
+
+		FCollisionQueryParams TraceParams(ShootLosTag, true, MyBot);
+		TraceParams.bTraceAsyncScene = true;
+
+		const FVector StartLocation = MyBot->GetPawnViewLocation();
+
+		// clear view or the first thing in the way is the enemy
+		FHitResult Hit(ForceInit);
+		if (TraceLineOfSight(Enemy, StartLocation, Enemy->GetActorLocation(), ECC_Visibility, TraceParams, Hit))
 		{
-			bCanShoot = true;
+			bCanShoot = !Hit.bBlockingHit || Hit.GetActor() == Enemy;
 		}
 	}
 
@@ -199,7 +319,7 @@ void AShooterAIController::ShootEnemy()
 
 void AShooterAIController::CheckAmmo(const class AShooterWeapon* CurrentWeapon)
 {
-	if (CurrentWeapon && BlackboardComp)
+	if (CurrentWeapon && BlackboardComp && BlackboardComp->GetBlackboardAsset())
 	{
 		const int32 Ammo = CurrentWeapon->GetCurrentAmmo();
 		const int32 MaxAmmo = CurrentWeapon->GetMaxAmmo();
@@ -211,16 +331,16 @@ void AShooterAIController::CheckAmmo(const class AShooterWeapon* CurrentWeapon)
 
 void AShooterAIController::SetEnemy(class APawn* InPawn)
 {
-	if (BlackboardComp)
+	if (BlackboardComp && BlackboardComp->GetBlackboardAsset())
 	{
 		BlackboardComp->SetValueAsObject(EnemyKeyID, InPawn);
-		SetFocus(InPawn);
 	}
+	SetFocus(InPawn);
 }
 
 class AShooterCharacter* AShooterAIController::GetEnemy() const
 {
-	if (BlackboardComp)
+	if (BlackboardComp && BlackboardComp->GetBlackboardAsset())
 	{
 		return Cast<AShooterCharacter>(BlackboardComp->GetValueAsObject(EnemyKeyID));
 	}
@@ -231,11 +351,13 @@ class AShooterCharacter* AShooterAIController::GetEnemy() const
 
 void AShooterAIController::UpdateControlRotation(float DeltaTime, bool bUpdatePawn)
 {
+	FShooterSoakScope SoakScope(EShooterSoakSubsystem::AI);
+
 	// Look toward focus
 	FVector FocalPoint = GetFocalPoint();
 	if( !FocalPoint.IsZero() && GetPawn())
 	{
-		FVector Direction = FocalPoint - GetPawn()->GetActorLocation();
+		FVector Direction = FocalPoint - GetPawn()->GetPawnViewLocation();
 		FRotator NewControlRotation = Direction.Rotation();
 		
 		NewControlRotation.Yaw = FRotator::ClampAxis(NewControlRotation.Yaw);
@@ -255,6 +377,7 @@ void AShooterAIController::GameHasEnded(AActor* EndGameFocus, bool bIsWinner)
 {
 	// Stop the behaviour tree/logic
 	BehaviorComp->StopTree();
+	SetScheduledByGameMode(false);
 
 	// Stop any movement we already have
 	StopMovement();
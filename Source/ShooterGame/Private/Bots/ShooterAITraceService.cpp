@@ -0,0 +1,134 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Bots/ShooterAITraceService.h"
+
+DECLARE_CYCLE_STAT(TEXT("Collect AI traces"), STAT_ShooterAITraceCollect, STATGROUP_ShooterGame);
+DECLARE_DWORD_COUNTER_STAT(TEXT("AI trace requests"), STAT_ShooterAITraceRequests, STATGROUP_ShooterGame);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Coalesced AI trace requests"), STAT_ShooterAITraceCoalesced, STATGROUP_ShooterGame);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Async AI traces started"), STAT_ShooterAITraceIssued, STATGROUP_ShooterGame);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Cached AI trace results"), STAT_ShooterAITraceEntries, STATGROUP_ShooterGame);
+
+FShooterAITraceService::FShooterAITraceService()
+	: ResultLifetimeSeconds(1.0f)
+{
+}
+
+bool FShooterAITraceService::RequestTrace(const AActor* Requester, const AActor* Target, const FVector& Start, const FVector& End, ECollisionChannel Channel, const FCollisionQueryParams& Params, FHitResult& OutHit)
+{
+	UWorld* World = Requester ? Requester->GetWorld() : NULL;
+	if (World == NULL)
+	{
+		return false;
+	}
+
+	FrameStats.NumRequests++;
+
+	FTraceEntry& Entry = Entries.FindOrAdd(FTraceKey(Requester, Target, Params.TraceTag));
+
+	// same address but a different actor, the old one was destroyed
+	if (Entry.Requester.Get() != Requester || Entry.Target.Get() != Target)
+	{
+		Entry = FTraceEntry();
+		Entry.Requester = Requester;
+		Entry.Target = Target;
+	}
+
+	Entry.LastRequestTime = World->GetTimeSeconds();
+
+	if (Entry.bPending && Entry.PendingFrame == GFrameCounter)
+	{
+		// already traced this frame, the first request wins
+		FrameStats.NumCoalesced++;
+	}
+	else
+	{
+		ResolvePending(World, Entry);
+
+		INC_DWORD_STAT(STAT_ShooterAITraces);
+		Entry.PendingHandle = World->AsyncLineTrace(Start, End, Channel, Params);
+		Entry.PendingFrame = GFrameCounter;
+		Entry.PendingStart = Start;
+		Entry.PendingEnd = End;
+		Entry.bPending = true;
+		FrameStats.NumIssued++;
+	}
+
+	if (Entry.bHasResult)
+	{
+		OutHit = Entry.Result;
+	}
+	return Entry.bHasResult;
+}
+
+void FShooterAITraceService::ResolvePending(UWorld* World, FTraceEntry& Entry)
+{
+	// results show up the frame after the trace was started
+	if (!Entry.bPending || Entry.PendingFrame == GFrameCounter)
+	{
+		return;
+	}
+
+	FTraceDatum Data;
+	if (World->QueryTraceData(Entry.PendingHandle, Data))
+	{
+		if (Data.OutHits.Num() > 0)
+		{
+			Entry.Result = Data.OutHits[0];
+		}
+		else
+		{
+			Entry.Result = FHitResult(ForceInit);
+		}
+		Entry.Result.TraceStart = Entry.PendingStart;
+		Entry.Result.TraceEnd = Entry.PendingEnd;
+		Entry.bHasResult = true;
+		FrameStats.NumResolved++;
+	}
+
+	// either collected or too old to be collected
+	Entry.bPending = false;
+}
+
+void FShooterAITraceService::Tick(UWorld* World)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ShooterAITraceCollect);
+
+	if (World == NULL)
+	{
+		return;
+	}
+
+	// a trace is only queryable during the frame after it was started, so collect everything now
+	const float WorldTimeSeconds = World->GetTimeSeconds();
+	for (auto It = Entries.CreateIterator(); It; ++It)
+	{
+		FTraceEntry& Entry = It.Value();
+		if (!Entry.Requester.IsValid() || WorldTimeSeconds - Entry.LastRequestTime > ResultLifetimeSeconds)
+		{
+			It.RemoveCurrent();
+			continue;
+		}
+
+		ResolvePending(World, Entry);
+	}
+
+	FrameStats.NumEntries = Entries.Num();
+	Stats = FrameStats;
+	FrameStats = FShooterAITraceStats();
+
+	SET_DWORD_STAT(STAT_ShooterAITraceRequests, Stats.NumRequests);
+	SET_DWORD_STAT(STAT_ShooterAITraceCoalesced, Stats.NumCoalesced);
+	SET_DWORD_STAT(STAT_ShooterAITraceIssued, Stats.NumIssued);
+	SET_DWORD_STAT(STAT_ShooterAITraceEntries, Stats.NumEntries);
+}
+
+void FShooterAITraceService::SetResultLifetime(float InResultLifetimeSeconds)
+{
+	ResultLifetimeSeconds = FMath::Max(0.0f, InResultLifetimeSeconds);
+}
+
+const FShooterAITraceStats& FShooterAITraceService::GetStats() const
+{
+	return Stats;
+}
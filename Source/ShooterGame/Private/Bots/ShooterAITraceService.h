@@ -0,0 +1,144 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+/** per-frame numbers reported by the AI trace service */
+struct FShooterAITraceStats
+{
+	/** trace requests made by bots this frame */
+	int32 NumRequests;
+
+	/** requests that reused a trace already queued this frame */
+	int32 NumCoalesced;
+
+	/** async traces started this frame */
+	int32 NumIssued;
+
+	/** results collected this frame from traces started last frame */
+	int32 NumResolved;
+
+	/** number of cached results */
+	int32 NumEntries;
+
+	FShooterAITraceStats()
+		: NumRequests(0)
+		, NumCoalesced(0)
+		, NumIssued(0)
+		, NumResolved(0)
+		, NumEntries(0)
+	{
+	}
+};
+
+/**
+ * Runs line of sight traces for bots on the engine's async trace queue instead of blocking the game thread.
+ * A request queues a trace and returns the result of the previous one made with the same requester, target and tag,
+ * so bots see results one frame late. Identical requests made in the same frame share a single trace.
+ */
+class FShooterAITraceService
+{
+public:
+
+	FShooterAITraceService();
+
+	/**
+	 * queue trace for this frame and get latest known result for it
+	 *
+	 * @param Requester		actor asking, usually the AI controller
+	 * @param Target		actor traced to, NULL when tracing to a location
+	 * @param Start			trace start
+	 * @param End			trace end
+	 * @param Channel		collision channel
+	 * @param Params		query params, its TraceTag tells different queries of the same requester apart
+	 * @param OutHit		latest result, its TraceStart and TraceEnd tell where it was traced from
+	 * @return true if a result is known, false on the first request
+	 */
+	bool RequestTrace(const AActor* Requester, const AActor* Target, const FVector& Start, const FVector& End, ECollisionChannel Channel, const FCollisionQueryParams& Params, FHitResult& OutHit);
+
+	/** collect results of last frame's traces and forget queries nobody asked for in a while */
+	void Tick(UWorld* World);
+
+	/** sets how long an unused result is kept */
+	void SetResultLifetime(float InResultLifetimeSeconds);
+
+	/** get numbers from the last frame */
+	const FShooterAITraceStats& GetStats() const;
+
+private:
+
+	struct FTraceKey
+	{
+		const AActor* Requester;
+		const AActor* Target;
+		FName Tag;
+
+		FTraceKey(const AActor* InRequester, const AActor* InTarget, FName InTag)
+			: Requester(InRequester)
+			, Target(InTarget)
+			, Tag(InTag)
+		{
+		}
+
+		bool operator==(const FTraceKey& Other) const
+		{
+			return Requester == Other.Requester && Target == Other.Target && Tag == Other.Tag;
+		}
+
+		friend uint32 GetTypeHash(const FTraceKey& Key)
+		{
+			return HashCombine(HashCombine(PointerHash(Key.Requester), PointerHash(Key.Target)), GetTypeHash(Key.Tag));
+		}
+	};
+
+	struct FTraceEntry
+	{
+		/** requester and target, to spot entries left behind by destroyed actors */
+		TWeakObjectPtr<const AActor> Requester;
+		TWeakObjectPtr<const AActor> Target;
+
+		/** trace in flight */
+		FTraceHandle PendingHandle;
+
+		/** set while PendingHandle is not collected */
+		bool bPending;
+
+		/** frame PendingHandle was started in */
+		uint64 PendingFrame;
+
+		/** start and end of the trace in flight */
+		FVector PendingStart;
+		FVector PendingEnd;
+
+		/** latest result */
+		FHitResult Result;
+
+		/** set once Result holds a real trace */
+		bool bHasResult;
+
+		/** world time of last request */
+		float LastRequestTime;
+
+		FTraceEntry()
+			: bPending(false)
+			, PendingFrame(0)
+			, bHasResult(false)
+			, LastRequestTime(0.0f)
+		{
+		}
+	};
+
+	/** copy result of trace in flight to Result, if it is done */
+	void ResolvePending(UWorld* World, FTraceEntry& Entry);
+
+	/** cached results and traces in flight */
+	TMap<FTraceKey, FTraceEntry> Entries;
+
+	/** how long an entry nobody asked for is kept (seconds) */
+	float ResultLifetimeSeconds;
+
+	/** numbers gathered since last tick */
+	FShooterAITraceStats FrameStats;
+
+	/** numbers from last frame */
+	FShooterAITraceStats Stats;
+};
@@ -23,10 +23,21 @@ bool AShooterBot::IsFirstPerson() const
 void AShooterBot::FaceRotation(FRotator NewRotation, float DeltaTime)
 {
 	IsBot = true;
-	FRotator CurrentRotation = FMath::RInterpTo(GetActorRotation(), NewRotation, DeltaTime, 8.0f);
-	CurrentRotation.Roll = 0.0f;
-	CurrentRotation.Pitch = 0.0f;
-	SetActorRotation(CurrentRotation);
+
+	// turn only around gravity up: drop pitch and roll in the gravity frame, not in world space
+	const FQuat& GravityFrame = GetGravityFrame();
+	FVector LocalDirection = GravityFrame.Inverse().RotateVector(NewRotation.Vector());
+	LocalDirection.Z = 0.0f;
+	if (!LocalDirection.Normalize())
+	{
+		// looking straight up or down, keep current heading
+		return;
+	}
+
+	const FQuat TargetQuat = GravityFrame * LocalDirection.Rotation().Quaternion();
+	const FQuat CurrentQuat = GetActorRotation().Quaternion();
+	const FQuat NewQuat = FQuat::Slerp(CurrentQuat, TargetQuat, FMath::Clamp(DeltaTime * 8.0f, 0.0f, 1.0f));
+	SetActorRotation(NewQuat.Rotator());
 
 	//SetFullControlRotation(CurrentRotation);
 	//Super::FaceRotation(CurrentRotation, DeltaTime);
@@ -0,0 +1,170 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Bots/ShooterBotScheduler.h"
+#include "BehaviorTree/BehaviorTreeComponent.h"
+
+DECLARE_CYCLE_STAT(TEXT("Bot brain ticks"), STAT_ShooterBotBrainTicks, STATGROUP_ShooterGame);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Bots scheduled"), STAT_ShooterBotsScheduled, STATGROUP_ShooterGame);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Bots ticked"), STAT_ShooterBotsTicked, STATGROUP_ShooterGame);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Urgent bots ticked"), STAT_ShooterBotsUrgentTicked, STATGROUP_ShooterGame);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Bot budget used (us)"), STAT_ShooterBotBudgetUsed, STATGROUP_ShooterGame);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Bot budget overrun (us)"), STAT_ShooterBotBudgetOverrun, STATGROUP_ShooterGame);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Avg bot decision latency (ms)"), STAT_ShooterBotDecisionLatency, STATGROUP_ShooterGame);
+
+/** urgent bots are treated as if they had been waiting this many times longer */
+static const float UrgentPriorityScale = 4.0f;
+
+/** weight of the newest sample in the smoothed decision latency */
+static const float LatencySmoothing = 0.1f;
+
+FShooterBotScheduler::FShooterBotScheduler()
+	: BudgetMicroseconds(1000.0f)
+	, UrgencyWindowSeconds(2.0f)
+{
+}
+
+void FShooterBotScheduler::RegisterBot(AShooterAIController* Bot)
+{
+	if (Bot == NULL || Bot->GetBehaviorComp() == NULL)
+	{
+		return;
+	}
+
+	// the engine must not tick the tree on its own anymore
+	Bot->GetBehaviorComp()->SetComponentTickEnabled(false);
+
+	for (int32 i = 0; i < Bots.Num(); i++)
+	{
+		if (Bots[i].Controller.Get() == Bot)
+		{
+			return;
+		}
+	}
+
+	FScheduledBot NewBot;
+	NewBot.Controller = Bot;
+	NewBot.LastTickTime = Bot->GetWorld() ? Bot->GetWorld()->GetTimeSeconds() : 0.0f;
+	NewBot.Priority = 0.0f;
+	NewBot.bUrgent = false;
+	Bots.Add(NewBot);
+}
+
+void FShooterBotScheduler::UnregisterBot(AShooterAIController* Bot)
+{
+	for (int32 i = Bots.Num() - 1; i >= 0; i--)
+	{
+		if (Bots[i].Controller.Get() == Bot)
+		{
+			Bots.RemoveAtSwap(i);
+		}
+	}
+
+	if (Bot && Bot->GetBehaviorComp())
+	{
+		Bot->GetBehaviorComp()->SetComponentTickEnabled(true);
+	}
+}
+
+void FShooterBotScheduler::SetBudget(float InBudgetMicroseconds)
+{
+	BudgetMicroseconds = FMath::Max(0.0f, InBudgetMicroseconds);
+}
+
+void FShooterBotScheduler::SetUrgencyWindow(float InUrgencyWindowSeconds)
+{
+	UrgencyWindowSeconds = FMath::Max(0.0f, InUrgencyWindowSeconds);
+}
+
+const FShooterBotSchedulerStats& FShooterBotScheduler::GetStats() const
+{
+	return Stats;
+}
+
+bool FShooterBotScheduler::IsUrgent(const AShooterAIController* Bot, float WorldTimeSeconds) const
+{
+	if (Bot->GetEnemy() != NULL)
+	{
+		return true;
+	}
+
+	const float LastDamageTime = Bot->GetLastDamageTime();
+	return LastDamageTime > 0.0f && (WorldTimeSeconds - LastDamageTime) < UrgencyWindowSeconds;
+}
+
+void FShooterBotScheduler::Tick(float WorldTimeSeconds)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ShooterBotBrainTicks);
+
+	Stats.NumTicked = 0;
+	Stats.NumUrgentTicked = 0;
+	Stats.UsedMicroseconds = 0.0f;
+	Stats.OverrunMicroseconds = 0.0f;
+
+	// drop controllers that went away, compute priority of everyone else
+	TickOrder.Reset();
+	for (int32 i = Bots.Num() - 1; i >= 0; i--)
+	{
+		FScheduledBot& Entry = Bots[i];
+		AShooterAIController* Bot = Entry.Controller.Get();
+		if (Bot == NULL || Bot->IsPendingKill())
+		{
+			Bots.RemoveAtSwap(i);
+			continue;
+		}
+
+		const float WaitTime = FMath::Max(0.0f, WorldTimeSeconds - Entry.LastTickTime);
+		Entry.bUrgent = IsUrgent(Bot, WorldTimeSeconds);
+		Entry.Priority = Entry.bUrgent ? WaitTime * UrgentPriorityScale : WaitTime;
+	}
+
+	Stats.NumBots = Bots.Num();
+	for (int32 i = 0; i < Bots.Num(); i++)
+	{
+		TickOrder.Add(i);
+	}
+
+	const TArray<FScheduledBot>& SortedBots = Bots;
+	TickOrder.Sort([&SortedBots](int32 A, int32 B)
+	{
+		return SortedBots[A].Priority > SortedBots[B].Priority;
+	});
+
+	// tick in priority order until the budget is spent, but always serve at least one bot so nobody starves
+	const uint32 StartCycles = FPlatformTime::Cycles();
+	for (int32 i = 0; i < TickOrder.Num(); i++)
+	{
+		if (Stats.NumTicked > 0 && Stats.UsedMicroseconds >= BudgetMicroseconds)
+		{
+			break;
+		}
+
+		FScheduledBot& Entry = Bots[TickOrder[i]];
+		AShooterAIController* Bot = Entry.Controller.Get();
+		UBehaviorTreeComponent* BehaviorComp = Bot->GetBehaviorComp();
+
+		const float TimeSinceLastTick = FMath::Max(0.0f, WorldTimeSeconds - Entry.LastTickTime);
+		if (BehaviorComp && BehaviorComp->IsRegistered())
+		{
+			BehaviorComp->TickComponent(TimeSinceLastTick, LEVELTICK_All, NULL);
+		}
+		Entry.LastTickTime = WorldTimeSeconds;
+
+		Stats.NumTicked++;
+		if (Entry.bUrgent)
+		{
+			Stats.NumUrgentTicked++;
+		}
+		Stats.AvgDecisionLatencyMs = FMath::Lerp(Stats.AvgDecisionLatencyMs, TimeSinceLastTick * 1000.0f, LatencySmoothing);
+		Stats.UsedMicroseconds = FPlatformTime::ToMilliseconds(FPlatformTime::Cycles() - StartCycles) * 1000.0f;
+	}
+
+	Stats.OverrunMicroseconds = FMath::Max(0.0f, Stats.UsedMicroseconds - BudgetMicroseconds);
+
+	SET_DWORD_STAT(STAT_ShooterBotsScheduled, Stats.NumBots);
+	SET_DWORD_STAT(STAT_ShooterBotsTicked, Stats.NumTicked);
+	SET_DWORD_STAT(STAT_ShooterBotsUrgentTicked, Stats.NumUrgentTicked);
+	SET_FLOAT_STAT(STAT_ShooterBotBudgetUsed, Stats.UsedMicroseconds);
+	SET_FLOAT_STAT(STAT_ShooterBotBudgetOverrun, Stats.OverrunMicroseconds);
+	SET_FLOAT_STAT(STAT_ShooterBotDecisionLatency, Stats.AvgDecisionLatencyMs);
+}
@@ -0,0 +1,100 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+/** per-frame numbers reported by the bot scheduler */
+struct FShooterBotSchedulerStats
+{
+	/** number of registered bots */
+	int32 NumBots;
+
+	/** bots whose behavior tree was ticked this frame */
+	int32 NumTicked;
+
+	/** bots that were ticked ahead of the others because they are fighting or were hurt */
+	int32 NumUrgentTicked;
+
+	/** time spent ticking behavior trees this frame (microseconds) */
+	float UsedMicroseconds;
+
+	/** time spent over the budget this frame (microseconds) */
+	float OverrunMicroseconds;
+
+	/** smoothed time between two decisions of the same bot (milliseconds) */
+	float AvgDecisionLatencyMs;
+
+	FShooterBotSchedulerStats()
+		: NumBots(0)
+		, NumTicked(0)
+		, NumUrgentTicked(0)
+		, UsedMicroseconds(0.0f)
+		, OverrunMicroseconds(0.0f)
+		, AvgDecisionLatencyMs(0.0f)
+	{
+	}
+};
+
+/**
+ * Runs the behavior trees of all bots from a single place, within a fixed per-frame time budget.
+ * Bots that are fighting or were recently damaged go first, the rest are served by how long they have been waiting.
+ * Aiming (UpdateControlRotation) is not scheduled, it still runs every frame from the controller tick.
+ */
+class FShooterBotScheduler
+{
+public:
+
+	FShooterBotScheduler();
+
+	/** start scheduling bot, takes over ticking of its behavior tree */
+	void RegisterBot(class AShooterAIController* Bot);
+
+	/** stop scheduling bot, gives ticking of its behavior tree back to the engine */
+	void UnregisterBot(class AShooterAIController* Bot);
+
+	/** tick as many behavior trees as the budget allows */
+	void Tick(float WorldTimeSeconds);
+
+	/** sets budget for behavior tree ticks, in microseconds per frame */
+	void SetBudget(float InBudgetMicroseconds);
+
+	/** sets how long a damaged bot stays urgent */
+	void SetUrgencyWindow(float InUrgencyWindowSeconds);
+
+	/** get numbers from the last tick */
+	const FShooterBotSchedulerStats& GetStats() const;
+
+private:
+
+	struct FScheduledBot
+	{
+		/** scheduled controller */
+		TWeakObjectPtr<class AShooterAIController> Controller;
+
+		/** world time of last behavior tree tick */
+		float LastTickTime;
+
+		/** priority computed for the current frame */
+		float Priority;
+
+		/** urgency computed for the current frame */
+		bool bUrgent;
+	};
+
+	/** all scheduled bots */
+	TArray<FScheduledBot> Bots;
+
+	/** indices into Bots, reused every frame to avoid allocations */
+	TArray<int32> TickOrder;
+
+	/** budget for behavior tree ticks (microseconds per frame) */
+	float BudgetMicroseconds;
+
+	/** how long a bot is considered urgent after taking damage */
+	float UrgencyWindowSeconds;
+
+	/** numbers from last tick */
+	FShooterBotSchedulerStats Stats;
+
+	/** check if bot should be ticked before the others */
+	bool IsUrgent(const class AShooterAIController* Bot, float WorldTimeSeconds) const;
+};
@@ -0,0 +1,357 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Bots/ShooterLightweightBots.h"
+#include "Bots/ShooterTacticalPoints.h"
+
+DECLARE_CYCLE_STAT(TEXT("Lightweight bots tick"), STAT_ShooterLightweightBotsTick, STATGROUP_ShooterGame);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Lightweight bots"), STAT_ShooterLightweightBots, STATGROUP_ShooterGame);
+
+/** ammo ratio below which bots go for pickups, same as CheckAmmo */
+static const float NeedAmmoRatio = 0.1f;
+
+/** bots get a new goal after this long even if they are still walking (seconds) */
+static const float MaxMoveTime = 3.0f;
+
+/** preferred distance to the enemy when moving in to fight */
+static const float FightDistance = 600.0f;
+
+/** radius of wander goals when there is nobody to fight */
+static const float WanderRadius = 2000.0f;
+
+FShooterLightweightBots::FShooterLightweightBots()
+	: bTeamGame(false)
+	, bMirrorToBlackboard(false)
+{
+}
+
+void FShooterLightweightBots::RegisterBot(AShooterAIController* Bot)
+{
+	if (Bot == NULL || Controllers.Contains(Bot))
+	{
+		return;
+	}
+
+	Controllers.Add(Bot);
+	Pawns.Add(NULL);
+	Locations.Add(FVector::ZeroVector);
+	Teams.Add(0);
+	BotFlags.Add(0);
+	EnemyIndices.Add(INDEX_NONE);
+	Enemies.Add(NULL);
+	LastMoveTimes.Add(-MaxMoveTime);
+	BotPlayerStates.Add(NULL);
+}
+
+void FShooterLightweightBots::UnregisterBot(AShooterAIController* Bot)
+{
+	const int32 BotIndex = Controllers.Find(Bot);
+	if (BotIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	AShooterBot* Pawn = Pawns[BotIndex].Get();
+	if (Pawn && (BotFlags[BotIndex] & Flag_Firing))
+	{
+		Pawn->StopWeaponFire();
+	}
+	RemoveBotAt(BotIndex);
+}
+
+void FShooterLightweightBots::RemoveBotAt(int32 BotIndex)
+{
+	Controllers.RemoveAtSwap(BotIndex);
+	Pawns.RemoveAtSwap(BotIndex);
+	Locations.RemoveAtSwap(BotIndex);
+	Teams.RemoveAtSwap(BotIndex);
+	BotFlags.RemoveAtSwap(BotIndex);
+	EnemyIndices.RemoveAtSwap(BotIndex);
+	Enemies.RemoveAtSwap(BotIndex);
+	LastMoveTimes.RemoveAtSwap(BotIndex);
+	BotPlayerStates.RemoveAtSwap(BotIndex);
+}
+
+void FShooterLightweightBots::SetMirrorToBlackboard(bool bInMirrorToBlackboard)
+{
+	bMirrorToBlackboard = bInMirrorToBlackboard;
+}
+
+bool FShooterLightweightBots::IsMirroringToBlackboard() const
+{
+	return bMirrorToBlackboard;
+}
+
+int32 FShooterLightweightBots::Num() const
+{
+	return Controllers.Num();
+}
+
+void FShooterLightweightBots::Tick(UWorld* World, float DeltaSeconds)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ShooterLightweightBotsTick);
+
+	if (World == NULL)
+	{
+		return;
+	}
+
+	AShooterGameState* GameState = Cast<AShooterGameState>(World->GameState);
+	bTeamGame = GameState && GameState->NumTeams > 1;
+
+	GatherBots();
+	GatherTargets(World);
+	PickEnemies();
+	UpdateFiring();
+	UpdateMovement(World, World->GetTimeSeconds());
+
+	SET_DWORD_STAT(STAT_ShooterLightweightBots, Controllers.Num());
+}
+
+void FShooterLightweightBots::GatherBots()
+{
+	for (int32 i = Controllers.Num() - 1; i >= 0; i--)
+	{
+		AShooterAIController* Controller = Controllers[i].Get();
+		if (Controller == NULL || Controller->IsPendingKill())
+		{
+			RemoveBotAt(i);
+			continue;
+		}
+
+		AShooterBot* Pawn = Cast<AShooterBot>(Controller->GetPawn());
+		const AShooterPlayerState* PlayerState = Cast<AShooterPlayerState>(Controller->PlayerState);
+		uint8 Flags = BotFlags[i] & Flag_Firing;
+
+		Pawns[i] = Pawn;
+		BotPlayerStates[i] = PlayerState;
+		Teams[i] = PlayerState ? PlayerState->GetTeamNum() : 0;
+		if (Pawn && Pawn->IsAlive())
+		{
+			Flags |= Flag_Alive;
+			Locations[i] = Pawn->GetActorLocation();
+
+			const AShooterWeapon* Weapon = Pawn->GetWeapon();
+			if (Weapon && Weapon->GetMaxAmmo() > 0 && (float)Weapon->GetCurrentAmmo() / (float)Weapon->GetMaxAmmo() <= NeedAmmoRatio)
+			{
+				Flags |= Flag_NeedAmmo;
+			}
+
+			// only touch the blackboard when ammo state changes
+			if (bMirrorToBlackboard && Weapon && (Flags & Flag_NeedAmmo) != (BotFlags[i] & Flag_NeedAmmo))
+			{
+				Controller->CheckAmmo(Weapon);
+			}
+		}
+		BotFlags[i] = Flags;
+	}
+}
+
+void FShooterLightweightBots::GatherTargets(UWorld* World)
+{
+	TargetPawns.Reset();
+	TargetLocations.Reset();
+	TargetTeams.Reset();
+	TargetPlayerStates.Reset();
+
+	for (FConstPawnIterator It = World->GetPawnIterator(); It; ++It)
+	{
+		AShooterCharacter* Pawn = Cast<AShooterCharacter>(*It);
+		if (Pawn && Pawn->IsAlive())
+		{
+			const AShooterPlayerState* PlayerState = Cast<AShooterPlayerState>(Pawn->PlayerState);
+			TargetPawns.Add(Pawn);
+			TargetLocations.Add(Pawn->GetActorLocation());
+			TargetTeams.Add(PlayerState ? PlayerState->GetTeamNum() : 0);
+			TargetPlayerStates.Add(PlayerState);
+		}
+	}
+}
+
+void FShooterLightweightBots::PickEnemies()
+{
+	const int32 NumTargets = TargetLocations.Num();
+	for (int32 i = 0; i < Controllers.Num(); i++)
+	{
+		int32 BestTarget = INDEX_NONE;
+		if (BotFlags[i] & Flag_Alive)
+		{
+			const FVector MyLocation = Locations[i];
+			float BestDistSq = MAX_FLT;
+			for (int32 t = 0; t < NumTargets; t++)
+			{
+				// same rules as AShooterGameMode::CanDealDamage: anybody else in free for all, other teams otherwise
+				const bool bIsEnemy = TargetPlayerStates[t] != BotPlayerStates[i] && (!bTeamGame || TargetTeams[t] != Teams[i]);
+				if (bIsEnemy)
+				{
+					const float DistSq = (TargetLocations[t] - MyLocation).SizeSquared();
+					if (DistSq < BestDistSq)
+					{
+						BestDistSq = DistSq;
+						BestTarget = t;
+					}
+				}
+			}
+		}
+		EnemyIndices[i] = BestTarget;
+
+		// only touch the controller when the enemy changes
+		AShooterCharacter* NewEnemy = BestTarget != INDEX_NONE ? TargetPawns[BestTarget].Get() : NULL;
+		AShooterAIController* Controller = Controllers[i].Get();
+		if (Controller && Enemies[i].Get() != NewEnemy)
+		{
+			Enemies[i] = NewEnemy;
+			if (bMirrorToBlackboard)
+			{
+				Controller->SetEnemy(NewEnemy);
+			}
+			else
+			{
+				Controller->SetFocus(NewEnemy);
+			}
+		}
+	}
+}
+
+void FShooterLightweightBots::UpdateFiring()
+{
+	static FName LosTag = FName(TEXT("LightweightBotLosTrace"));
+
+	for (int32 i = 0; i < Controllers.Num(); i++)
+	{
+		AShooterBot* Pawn = Pawns[i].Get();
+		AShooterAIController* Controller = Controllers[i].Get();
+		const int32 EnemyIndex = EnemyIndices[i];
+		AShooterCharacter* Enemy = EnemyIndex != INDEX_NONE ? TargetPawns[EnemyIndex].Get() : NULL;
+
+		bool bWantsToFire = false;
+		BotFlags[i] &= ~Flag_HasLOS;
+		if (Pawn && Controller && Enemy)
+		{
+
+			FCollisionQueryParams TraceParams(LosTag, true, Pawn);
+			TraceParams.bTraceAsyncScene = true;
+
+			FHitResult Hit(ForceInit);
+			if (Controller->TraceLineOfSight(Enemy, Pawn->GetPawnViewLocation(), TargetLocations[EnemyIndex], ECC_Visibility, TraceParams, Hit)
+				&& (!Hit.bBlockingHit || Hit.GetActor() == Enemy))
+			{
+				BotFlags[i] |= Flag_HasLOS;
+
+				const AShooterWeapon* Weapon = Pawn->GetWeapon();
+				bWantsToFire = Weapon && Weapon->GetCurrentAmmo() > 0 && Weapon->CanFire();
+			}
+		}
+
+		const bool bFiring = (BotFlags[i] & Flag_Firing) != 0;
+		if (Pawn && bWantsToFire != bFiring)
+		{
+			if (bWantsToFire)
+			{
+				Pawn->StartWeaponFire();
+				BotFlags[i] |= Flag_Firing;
+			}
+			else
+			{
+				Pawn->StopWeaponFire();
+				BotFlags[i] &= ~Flag_Firing;
+			}
+		}
+		else if (Pawn == NULL)
+		{
+			BotFlags[i] &= ~Flag_Firing;
+		}
+	}
+}
+
+void FShooterLightweightBots::UpdateMovement(UWorld* World, float WorldTimeSeconds)
+{
+	for (int32 i = 0; i < Controllers.Num(); i++)
+	{
+		if ((BotFlags[i] & Flag_Alive) == 0)
+		{
+			continue;
+		}
+
+		AShooterAIController* Controller = Controllers[i].Get();
+		if (Controller == NULL)
+		{
+			continue;
+		}
+
+		const bool bIdle = Controller->GetMoveStatus() == EPathFollowingStatus::Idle;
+		if (!bIdle && WorldTimeSeconds - LastMoveTimes[i] < MaxMoveTime)
+		{
+			continue;
+		}
+
+		FVector Goal;
+		if (FindMoveGoal(World, i, WorldTimeSeconds, Goal))
+		{
+			Controller->MoveToLocation(Goal);
+			LastMoveTimes[i] = WorldTimeSeconds;
+		}
+	}
+}
+
+bool FShooterLightweightBots::FindMoveGoal(UWorld* World, int32 BotIndex, float WorldTimeSeconds, FVector& OutGoal)
+{
+	AShooterAIController* Controller = Controllers[BotIndex].Get();
+	AShooterBot* Pawn = Pawns[BotIndex].Get();
+	const FVector MyLocation = Locations[BotIndex];
+	AShooterGameMode* GameMode = World->GetAuthGameMode<AShooterGameMode>();
+
+	// low on ammo: closest pickup for our weapon, like BTTask_FindPickup
+	if ((BotFlags[BotIndex] & Flag_NeedAmmo) && GameMode && Pawn)
+	{
+		float BestDistSq = MAX_FLT;
+		for (int32 i = 0; i < GameMode->LevelPickups.Num(); i++)
+		{
+			AShooterPickup_Ammo* AmmoPickup = Cast<AShooterPickup_Ammo>(GameMode->LevelPickups[i]);
+			if (AmmoPickup && AmmoPickup->IsForWeapon(AShooterWeapon_Instant::StaticClass()) && AmmoPickup->CanBePickedUp(Pawn))
+			{
+				const float DistSq = (AmmoPickup->GetActorLocation() - MyLocation).SizeSquared();
+				if (DistSq < BestDistSq)
+				{
+					BestDistSq = DistSq;
+					OutGoal = AmmoPickup->GetActorLocation();
+				}
+			}
+		}
+
+		if (BestDistSq < MAX_FLT)
+		{
+			return true;
+		}
+	}
+
+	// enemy out of sight: move in, like BTTask_FindPointNearEnemy
+	const int32 EnemyIndex = EnemyIndices[BotIndex];
+	if (EnemyIndex != INDEX_NONE)
+	{
+		if (BotFlags[BotIndex] & Flag_HasLOS)
+		{
+			return false;
+		}
+
+		const FVector EnemyLocation = TargetLocations[EnemyIndex];
+		FShooterTacticalPoints* TacticalPoints = GameMode ? GameMode->GetTacticalPoints() : NULL;
+		if (TacticalPoints && TacticalPoints->IsBuilt())
+		{
+			const int32 PointIndex = TacticalPoints->FindPointNearEnemy(Controller, MyLocation, EnemyLocation, FightDistance, WorldTimeSeconds);
+			if (PointIndex != INDEX_NONE)
+			{
+				OutGoal = TacticalPoints->GetLocation(PointIndex);
+				return true;
+			}
+		}
+
+		const FVector SearchOrigin = EnemyLocation + FightDistance * (MyLocation - EnemyLocation).SafeNormal();
+		OutGoal = UNavigationSystem::GetRandomPointInRadius(Controller, SearchOrigin, 200.0f);
+		return OutGoal != FVector::ZeroVector;
+	}
+
+	// nobody around, wander
+	OutGoal = UNavigationSystem::GetRandomPointInRadius(Controller, MyLocation, WanderRadius);
+	return OutGoal != FVector::ZeroVector;
+}
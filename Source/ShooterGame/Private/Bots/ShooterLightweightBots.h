@@ -0,0 +1,98 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+/**
+ * Drives all bots from one tick without behavior trees, for load testing servers with many bots.
+ * Perception and decision state lives in parallel arrays indexed by bot, one pass each for gathering,
+ * picking enemies, shooting and moving. Controllers and pawns are still regular actors, only the brain is replaced.
+ * The blackboard is left alone unless mirroring is turned on, which only helps when looking at bots in the debugger.
+ */
+class FShooterLightweightBots
+{
+public:
+
+	FShooterLightweightBots();
+
+	/** start driving bot */
+	void RegisterBot(class AShooterAIController* Bot);
+
+	/** stop driving bot, stops its weapon */
+	void UnregisterBot(class AShooterAIController* Bot);
+
+	/** update all bots */
+	void Tick(UWorld* World, float DeltaSeconds);
+
+	/** copy enemy and ammo state to the blackboard of each bot */
+	void SetMirrorToBlackboard(bool bInMirrorToBlackboard);
+
+	/** check if blackboards are kept up to date */
+	bool IsMirroringToBlackboard() const;
+
+	/** get number of bots */
+	int32 Num() const;
+
+private:
+
+	/** bits in BotFlags */
+	enum EBotFlags
+	{
+		Flag_Alive = 1 << 0,
+		Flag_NeedAmmo = 1 << 1,
+		Flag_HasLOS = 1 << 2,
+		Flag_Firing = 1 << 3,
+	};
+
+	/** remove bot at index from every array */
+	void RemoveBotAt(int32 BotIndex);
+
+	/** gather pawn state of every bot */
+	void GatherBots();
+
+	/** gather every living pawn bots can shoot at */
+	void GatherTargets(UWorld* World);
+
+	/** pick closest enemy of every bot */
+	void PickEnemies();
+
+	/** trace line of sight and start or stop firing */
+	void UpdateFiring();
+
+	/** give new move goals to bots that are done moving */
+	void UpdateMovement(UWorld* World, float WorldTimeSeconds);
+
+	/** get goal for bot that needs a new one, false if there is none */
+	bool FindMoveGoal(UWorld* World, int32 BotIndex, float WorldTimeSeconds, FVector& OutGoal);
+
+	/** per bot, all the same length */
+	TArray<TWeakObjectPtr<class AShooterAIController>> Controllers;
+	TArray<TWeakObjectPtr<class AShooterBot>> Pawns;
+	TArray<FVector> Locations;
+	TArray<int32> Teams;
+	TArray<uint8> BotFlags;
+
+	/** index into Target arrays, INDEX_NONE if no enemy */
+	TArray<int32> EnemyIndices;
+
+	/** enemy pawn of last tick, to change focus only when it changes */
+	TArray<TWeakObjectPtr<class AShooterCharacter>> Enemies;
+
+	/** world time last move was issued */
+	TArray<float> LastMoveTimes;
+
+	/** per living pawn, rebuilt every tick */
+	TArray<TWeakObjectPtr<class AShooterCharacter>> TargetPawns;
+	TArray<FVector> TargetLocations;
+	TArray<int32> TargetTeams;
+
+	/** player state of each target, to keep bots from picking themselves */
+	TArray<const class APlayerState*> TargetPlayerStates;
+
+	/** player state of each bot */
+	TArray<const class APlayerState*> BotPlayerStates;
+
+	/** teams matter for picking enemies, set from game state every tick */
+	bool bTeamGame;
+
+	bool bMirrorToBlackboard;
+};
@@ -0,0 +1,393 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Bots/ShooterTacticalPoints.h"
+#include "EngineUtils.h"
+
+/** "STAC" */
+static const uint32 TacticalPointsMagic = 0x43415453;
+
+/** bump when the baked data changes */
+static const int32 TacticalPointsVersion = 2;
+
+/** upper bound on points, visibility data grows with its square */
+static const int32 MaxPoints = 256;
+
+/** random navmesh samples taken while baking */
+static const int32 NumNavSamples = 2048;
+
+/** points closer than this to an existing one are rejected */
+static const float MinPointSpacing = 250.0f;
+
+/** height of visibility traces above a point */
+static const float EyeHeight = 64.0f;
+
+/** height and length of cover traces */
+static const float CoverHeight = 40.0f;
+static const float CoverDistance = 150.0f;
+static const int32 NumCoverDirections = 8;
+
+/** time spent tracing per frame while baking (seconds) */
+static const double BakeTimeBudget = 0.002;
+
+/** how long a picked point stays taken */
+static const float ClaimLifetime = 5.0f;
+
+/** enemy farther than this from every point makes precomputed visibility meaningless */
+static const float MaxEnemySnapDistance = 400.0f;
+
+/** points closer than this to the enemy are never picked */
+static const float MinEnemyDistance = 200.0f;
+
+/** scoring weights */
+static const float VisibilityWeight = 1.0f;
+static const float CoverWeight = 0.5f;
+static const float TravelDistanceScale = 2000.0f;
+
+FShooterTacticalPoints::FShooterTacticalPoints()
+	: bBuilt(false)
+	, bBaking(false)
+	, NextCoverPoint(0)
+	, NextVisibilityRow(0)
+	, NextVisibilityColumn(0)
+	, BakeMapTimeStamp(0)
+	, BakeSeconds(0.0)
+{
+}
+
+void FShooterTacticalPoints::Build(UWorld* World)
+{
+	if (World == NULL || bBaking)
+	{
+		return;
+	}
+
+	// PIE and unsaved maps have no file to compare against, always bake those
+	int64 MapTimeStamp = 0;
+	FString MapFilename;
+	if (FPackageName::DoesPackageExist(World->GetOutermost()->GetName(), NULL, &MapFilename))
+	{
+		MapTimeStamp = IFileManager::Get().GetTimeStamp(*MapFilename).GetTicks();
+	}
+
+	const FString Path = FPaths::GameSavedDir() + TEXT("TacticalPoints/") + World->GetMapName() + TEXT(".tactical");
+	if (MapTimeStamp != 0 && Load(Path, MapTimeStamp))
+	{
+		FinishBuild();
+		return;
+	}
+
+	BakePath = Path;
+	BakeMapTimeStamp = MapTimeStamp;
+	BeginBake(World);
+}
+
+void FShooterTacticalPoints::Tick(UWorld* World)
+{
+	if (!bBaking || World == NULL || !ContinueBake(World))
+	{
+		return;
+	}
+
+	bBaking = false;
+	UE_LOG(LogShooter, Log, TEXT("Baked %d tactical points for %s in %.1f ms of traces"), Locations.Num(), *World->GetMapName(), BakeSeconds * 1000.0);
+
+	if (BakeMapTimeStamp != 0)
+	{
+		Save(BakePath, BakeMapTimeStamp);
+	}
+	FinishBuild();
+}
+
+void FShooterTacticalPoints::FinishBuild()
+{
+	Claims.Reset();
+	Claims.AddZeroed(Locations.Num());
+	bBuilt = true;
+}
+
+bool FShooterTacticalPoints::IsBuilt() const
+{
+	return bBuilt;
+}
+
+int32 FShooterTacticalPoints::Num() const
+{
+	return Locations.Num();
+}
+
+const FVector& FShooterTacticalPoints::GetLocation(int32 PointIndex) const
+{
+	return Locations[PointIndex];
+}
+
+bool FShooterTacticalPoints::IsVisible(int32 PointA, int32 PointB) const
+{
+	const int32 Bit = PointA * Locations.Num() + PointB;
+	return (Visibility[Bit >> 5] & (1u << (Bit & 31))) != 0;
+}
+
+int32 FShooterTacticalPoints::FindClosestPoint(const FVector& Location, float& OutDistSq) const
+{
+	int32 BestIndex = INDEX_NONE;
+	OutDistSq = MAX_FLT;
+	for (int32 i = 0; i < Locations.Num(); i++)
+	{
+		const float DistSq = (Locations[i] - Location).SizeSquared();
+		if (DistSq < OutDistSq)
+		{
+			OutDistSq = DistSq;
+			BestIndex = i;
+		}
+	}
+
+	return BestIndex;
+}
+
+int32 FShooterTacticalPoints::FindPointNearEnemy(const AController* Bot, const FVector& BotLocation, const FVector& EnemyLocation, float IdealDistance, float WorldTimeSeconds)
+{
+	if (!bBuilt || Locations.Num() == 0 || IdealDistance <= 0.0f)
+	{
+		return INDEX_NONE;
+	}
+
+	ReleaseClaim(Bot);
+
+	float EnemySnapDistSq = 0.0f;
+	const int32 EnemyPoint = FindClosestPoint(EnemyLocation, EnemySnapDistSq);
+	const bool bUseVisibility = EnemyPoint != INDEX_NONE && EnemySnapDistSq < FMath::Square(MaxEnemySnapDistance);
+
+	int32 BestIndex = INDEX_NONE;
+	float BestScore = -MAX_FLT;
+	for (int32 i = 0; i < Locations.Num(); i++)
+	{
+		// taken by someone else
+		const FClaim& Claim = Claims[i];
+		if (Claim.Claimant.IsValid() && WorldTimeSeconds - Claim.TimeSeconds < ClaimLifetime)
+		{
+			continue;
+		}
+
+		const float EnemyDist = (Locations[i] - EnemyLocation).Size();
+		if (EnemyDist < MinEnemyDistance || EnemyDist > IdealDistance * 2.0f)
+		{
+			continue;
+		}
+
+		float Score = -FMath::Abs(EnemyDist - IdealDistance) / IdealDistance;
+		Score -= (Locations[i] - BotLocation).Size() / TravelDistanceScale;
+		Score += CoverWeight * Cover[i] / 255.0f;
+		if (bUseVisibility && IsVisible(i, EnemyPoint))
+		{
+			Score += VisibilityWeight;
+		}
+
+		if (Score > BestScore)
+		{
+			BestScore = Score;
+			BestIndex = i;
+		}
+	}
+
+	if (BestIndex != INDEX_NONE)
+	{
+		Claims[BestIndex].Claimant = Bot;
+		Claims[BestIndex].TimeSeconds = WorldTimeSeconds;
+	}
+
+	return BestIndex;
+}
+
+void FShooterTacticalPoints::ReleaseClaim(const AController* Bot)
+{
+	for (int32 i = 0; i < Claims.Num(); i++)
+	{
+		if (Claims[i].Claimant.Get() == Bot)
+		{
+			Claims[i].Claimant.Reset();
+		}
+	}
+}
+
+FVector FShooterTacticalPoints::GetUpVector(int32 PointIndex) const
+{
+	return AShooterCharacter::MakeGravityFrame((SBGravityMode)GravityModes[PointIndex]).GetAxisZ();
+}
+
+void FShooterTacticalPoints::BeginBake(UWorld* World)
+{
+	Locations.Reset();
+	GravityModes.Reset();
+	Cover.Reset();
+	Visibility.Reset();
+
+	// player starts first, they are known to be sensible places to stand, and their rotation gives their gravity
+	TArray<FVector> Candidates;
+	TArray<uint8> CandidateGravityModes;
+	for (TActorIterator<APlayerStart> It(World); It; ++It)
+	{
+		Candidates.Add(It->GetActorLocation());
+		CandidateGravityModes.Add((uint8)AShooterCharacter::GetGravityModeForUp(It->GetActorQuat().GetAxisZ()));
+	}
+
+	// the navmesh only covers floors walkable under default gravity
+	for (int32 i = 0; i < NumNavSamples; i++)
+	{
+		const FVector Sample = UNavigationSystem::GetRandomPoint(World);
+		if (Sample != FVector::ZeroVector)
+		{
+			Candidates.Add(Sample);
+			CandidateGravityModes.Add((uint8)GRAVITY_ZNEGATIVE);
+		}
+	}
+
+	for (int32 i = 0; i < Candidates.Num() && Locations.Num() < MaxPoints; i++)
+	{
+		bool bTooClose = false;
+		for (int32 j = 0; j < Locations.Num() && !bTooClose; j++)
+		{
+			bTooClose = (Locations[j] - Candidates[i]).SizeSquared() < FMath::Square(MinPointSpacing);
+		}
+
+		if (!bTooClose)
+		{
+			Locations.Add(Candidates[i]);
+			GravityModes.Add(CandidateGravityModes[i]);
+		}
+	}
+
+	const int32 NumPoints = Locations.Num();
+	Cover.AddZeroed(NumPoints);
+	Visibility.AddZeroed((NumPoints * NumPoints + 31) / 32);
+
+	NextCoverPoint = 0;
+	NextVisibilityRow = 0;
+	NextVisibilityColumn = 1;
+	BakeSeconds = 0.0;
+	bBaking = true;
+}
+
+bool FShooterTacticalPoints::ContinueBake(UWorld* World)
+{
+	const double StartTime = FPlatformTime::Seconds();
+	const double EndTime = StartTime + BakeTimeBudget;
+
+	// only level geometry matters, pawns move
+	static FName TacticalTraceTag = FName(TEXT("TacticalPointsBake"));
+	FCollisionQueryParams TraceParams(TacticalTraceTag, true);
+	const FCollisionObjectQueryParams ObjectParams(ECC_WorldStatic);
+
+	const int32 NumPoints = Locations.Num();
+	for (; NextCoverPoint < NumPoints; NextCoverPoint++)
+	{
+		if (FPlatformTime::Seconds() > EndTime)
+		{
+			BakeSeconds += FPlatformTime::Seconds() - StartTime;
+			return false;
+		}
+
+		// directions around the point, in the plane of its floor
+		const int32 i = NextCoverPoint;
+		const FQuat GravityFrame = AShooterCharacter::MakeGravityFrame((SBGravityMode)GravityModes[i]);
+		const FVector Start = Locations[i] + GravityFrame.GetAxisZ() * CoverHeight;
+		int32 NumBlocked = 0;
+		for (int32 Dir = 0; Dir < NumCoverDirections; Dir++)
+		{
+			const float Angle = 2.0f * PI * Dir / NumCoverDirections;
+			const FVector End = Start + GravityFrame.RotateVector(FVector(FMath::Cos(Angle), FMath::Sin(Angle), 0.0f)) * CoverDistance;
+			if (World->LineTraceTest(Start, End, TraceParams, ObjectParams))
+			{
+				NumBlocked++;
+			}
+		}
+		Cover[i] = (uint8)(NumBlocked * 255 / NumCoverDirections);
+	}
+
+	// visibility is symmetric, trace each pair once
+	for (; NextVisibilityRow < NumPoints; NextVisibilityRow++, NextVisibilityColumn = NextVisibilityRow + 1)
+	{
+		const int32 i = NextVisibilityRow;
+		const int32 SelfBit = i * NumPoints + i;
+		Visibility[SelfBit >> 5] |= 1u << (SelfBit & 31);
+
+		const FVector EyeA = Locations[i] + GetUpVector(i) * EyeHeight;
+		for (; NextVisibilityColumn < NumPoints; NextVisibilityColumn++)
+		{
+			if (FPlatformTime::Seconds() > EndTime)
+			{
+				BakeSeconds += FPlatformTime::Seconds() - StartTime;
+				return false;
+			}
+
+			const int32 j = NextVisibilityColumn;
+			const FVector EyeB = Locations[j] + GetUpVector(j) * EyeHeight;
+			if (!World->LineTraceTest(EyeA, EyeB, TraceParams, ObjectParams))
+			{
+				const int32 BitAB = i * NumPoints + j;
+				const int32 BitBA = j * NumPoints + i;
+				Visibility[BitAB >> 5] |= 1u << (BitAB & 31);
+				Visibility[BitBA >> 5] |= 1u << (BitBA & 31);
+			}
+		}
+	}
+
+	BakeSeconds += FPlatformTime::Seconds() - StartTime;
+	return true;
+}
+
+bool FShooterTacticalPoints::Load(const FString& Path, int64 MapTimeStamp)
+{
+	TScopedPointer<FArchive> File(IFileManager::Get().CreateFileReader(*Path));
+	if (!File.IsValid())
+	{
+		return false;
+	}
+
+	uint32 Magic = 0;
+	int32 Version = 0;
+	int64 FileMapTimeStamp = 0;
+	*File << Magic;
+	*File << Version;
+	*File << FileMapTimeStamp;
+	if (File->IsError() || Magic != TacticalPointsMagic || Version != TacticalPointsVersion || FileMapTimeStamp != MapTimeStamp)
+	{
+		return false;
+	}
+
+	*File << Locations;
+	*File << GravityModes;
+	*File << Cover;
+	*File << Visibility;
+
+	const int32 NumPoints = Locations.Num();
+	if (File->IsError() || GravityModes.Num() != NumPoints || Cover.Num() != NumPoints || Visibility.Num() != (NumPoints * NumPoints + 31) / 32)
+	{
+		Locations.Reset();
+		GravityModes.Reset();
+		Cover.Reset();
+		Visibility.Reset();
+		return false;
+	}
+
+	return true;
+}
+
+void FShooterTacticalPoints::Save(const FString& Path, int64 MapTimeStamp) const
+{
+	TScopedPointer<FArchive> File(IFileManager::Get().CreateFileWriter(*Path));
+	if (!File.IsValid())
+	{
+		UE_LOG(LogShooter, Warning, TEXT("Failed to write tactical points to %s"), *Path);
+		return;
+	}
+
+	uint32 Magic = TacticalPointsMagic;
+	int32 Version = TacticalPointsVersion;
+	*File << Magic;
+	*File << Version;
+	*File << MapTimeStamp;
+	*File << const_cast<TArray<FVector>&>(Locations);
+	*File << const_cast<TArray<uint8>&>(GravityModes);
+	*File << const_cast<TArray<uint8>&>(Cover);
+	*File << const_cast<TArray<uint32>&>(Visibility);
+}
@@ -0,0 +1,116 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+/**
+ * Fixed set of positions bots move to when fighting, with cover and point to point visibility precomputed.
+ * The set is baked from the navmesh and player starts the first time a map is played and saved to
+ * Saved/TacticalPoints, so later matches on the same map only load it. It is rebaked when the map file changes.
+ * Baking traces a few milliseconds per frame from Tick; queries fail until IsBuilt. Cover and eye height are measured
+ * along the up direction of each point's gravity, player starts keep the gravity their rotation implies.
+ * Queries only score cached points; a point picked by a bot is claimed for a while so others go elsewhere.
+ */
+class FShooterTacticalPoints
+{
+public:
+
+	FShooterTacticalPoints();
+
+	/** load points of World's map from disk, or start baking them */
+	void Build(UWorld* World);
+
+	/** continue bake started by Build for a slice of the frame, saves the points once done */
+	void Tick(UWorld* World);
+
+	/** check if points are ready to be queried */
+	bool IsBuilt() const;
+
+	/** get number of points */
+	int32 Num() const;
+
+	/** get location of point */
+	const FVector& GetLocation(int32 PointIndex) const;
+
+	/**
+	 * pick best point to fight an enemy from, and claim it for the bot
+	 *
+	 * @param Bot				asking controller, its previous claim is released
+	 * @param BotLocation		where the bot is now
+	 * @param EnemyLocation		where the enemy is now
+	 * @param IdealDistance		preferred distance to the enemy
+	 * @param WorldTimeSeconds	current world time, for claim expiry
+	 * @return point index, INDEX_NONE if there is no suitable point
+	 */
+	int32 FindPointNearEnemy(const AController* Bot, const FVector& BotLocation, const FVector& EnemyLocation, float IdealDistance, float WorldTimeSeconds);
+
+	/** drop claim of bot */
+	void ReleaseClaim(const AController* Bot);
+
+private:
+
+	struct FClaim
+	{
+		TWeakObjectPtr<const AController> Claimant;
+
+		/** world time of claim */
+		float TimeSeconds;
+	};
+
+	/** check precomputed visibility between two points */
+	bool IsVisible(int32 PointA, int32 PointB) const;
+
+	/** get index of point closest to Location, INDEX_NONE if none */
+	int32 FindClosestPoint(const FVector& Location, float& OutDistSq) const;
+
+	/** sample points, traces are left to ContinueBake */
+	void BeginBake(UWorld* World);
+
+	/** trace cover and visibility until time budget runs out, true when all is traced */
+	bool ContinueBake(UWorld* World);
+
+	/** get up direction of point */
+	FVector GetUpVector(int32 PointIndex) const;
+
+	/** get claims ready and allow queries */
+	void FinishBuild();
+
+	/** read baked data, false if file is missing or was baked for another version of the map */
+	bool Load(const FString& Path, int64 MapTimeStamp);
+
+	/** write baked data */
+	void Save(const FString& Path, int64 MapTimeStamp) const;
+
+	/** point locations, on the navmesh */
+	TArray<FVector> Locations;
+
+	/** SBGravityMode of each point */
+	TArray<uint8> GravityModes;
+
+	/** fraction of directions blocked close to each point, 0-255 */
+	TArray<uint8> Cover;
+
+	/** bit A * Num + B is set when eye height at A sees eye height at B */
+	TArray<uint32> Visibility;
+
+	/** current claim of each point */
+	TArray<FClaim> Claims;
+
+	bool bBuilt;
+
+	/** bake in progress */
+	bool bBaking;
+
+	/** next point to trace cover for */
+	int32 NextCoverPoint;
+
+	/** next pair to trace visibility for */
+	int32 NextVisibilityRow;
+	int32 NextVisibilityColumn;
+
+	/** where and for which map file the bake is saved */
+	FString BakePath;
+	int64 BakeMapTimeStamp;
+
+	/** time spent tracing so far (seconds) */
+	double BakeSeconds;
+};
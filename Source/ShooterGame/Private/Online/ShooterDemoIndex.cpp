@@ -0,0 +1,273 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Online/ShooterDemoIndex.h"
+#include "Engine/DemoNetDriver.h"
+
+/** first bytes of the index file */
+static const uint32 DemoIndexMagic = 0x49444753;
+
+/** first bytes of match info files */
+static const uint32 DemoMatchInfoMagic = 0x4D444753;
+
+/** bump when the layout of either file changes, old files are then ignored and rebuilt */
+static const int32 DemoIndexVersion = 1;
+
+/** name of the index file, in the demo directory */
+static const TCHAR* DemoIndexFileName = TEXT("DemoIndex.bin");
+
+FArchive& operator<<(FArchive& Ar, FShooterDemoInfo& Info)
+{
+	int64 Ticks = Info.TimeStamp.GetTicks();
+
+	Ar << Info.FileName;
+	Ar << Info.SizeBytes;
+	Ar << Ticks;
+	Ar << Info.MapName;
+	Ar << Info.DurationSeconds;
+	Ar << Info.PlayerNames;
+
+	if (Ar.IsLoading())
+	{
+		Info.TimeStamp = FDateTime(Ticks);
+	}
+	return Ar;
+}
+
+/** collects demo files and their stat data, in one pass over the directory */
+class FDemoFileVisitor : public IPlatformFile::FDirectoryStatVisitor
+{
+public:
+
+	TArray<FShooterDemoInfo> Files;
+
+	virtual bool Visit(const TCHAR* FilenameOrDirectory, const FFileStatData& StatData) override
+	{
+		const FString FileName = FPaths::GetCleanFilename(FilenameOrDirectory);
+		if (!StatData.bIsDirectory && FileName.EndsWith(TEXT(".demo")))
+		{
+			FShooterDemoInfo& Info = Files[Files.AddDefaulted()];
+			Info.FileName = FileName;
+			Info.SizeBytes = StatData.FileSize;
+			Info.TimeStamp = StatData.ModificationTime;
+		}
+		return true;
+	}
+};
+
+FShooterDemoIndexer::FShooterDemoIndexer()
+	: Thread(NULL)
+{
+}
+
+FShooterDemoIndexer::~FShooterDemoIndexer()
+{
+	if (Thread != NULL)
+	{
+		Stop();
+		Thread->WaitForCompletion();
+		delete Thread;
+		Thread = NULL;
+	}
+}
+
+void FShooterDemoIndexer::Start()
+{
+	if (Thread != NULL || Finished.GetValue() != 0)
+	{
+		return;
+	}
+
+	if (FPlatformProcess::SupportsMultithreading())
+	{
+		Thread = FRunnableThread::Create(this, TEXT("ShooterDemoIndexer"), 0, TPri_BelowNormal);
+	}
+	else
+	{
+		Run();
+	}
+}
+
+bool FShooterDemoIndexer::IsFinished() const
+{
+	FScopeLock ScopeLock(&ResultsLock);
+	return Finished.GetValue() != 0 && Results.Num() == 0;
+}
+
+void FShooterDemoIndexer::ConsumeResults(TArray<FShooterDemoInfo>& OutInfos)
+{
+	FScopeLock ScopeLock(&ResultsLock);
+	OutInfos.Append(Results);
+	Results.Reset();
+}
+
+void FShooterDemoIndexer::AddResult(const FShooterDemoInfo& Info)
+{
+	FScopeLock ScopeLock(&ResultsLock);
+	Results.Add(Info);
+}
+
+FString FShooterDemoIndexer::GetDemoDir()
+{
+	return FPaths::GameSavedDir() + TEXT("Demos/");
+}
+
+FString FShooterDemoIndexer::GetMatchInfoPath(const FString& DemoFileName)
+{
+	return GetDemoDir() + FPaths::GetBaseFilename(DemoFileName) + TEXT(".demoinfo");
+}
+
+void FShooterDemoIndexer::ReadMatchInfo(FShooterDemoInfo& Info)
+{
+	TArray<uint8> Bytes;
+	if (!FFileHelper::LoadFileToArray(Bytes, *GetMatchInfoPath(Info.FileName), FILEREAD_Silent))
+	{
+		return;
+	}
+
+	FMemoryReader Ar(Bytes);
+	uint32 Magic = 0;
+	int32 Version = 0;
+	Ar << Magic;
+	Ar << Version;
+	if (Magic != DemoMatchInfoMagic || Version != DemoIndexVersion)
+	{
+		return;
+	}
+
+	FShooterDemoInfo MatchInfo;
+	Ar << MatchInfo.MapName;
+	Ar << MatchInfo.DurationSeconds;
+	Ar << MatchInfo.PlayerNames;
+	if (!Ar.IsError())
+	{
+		Info.MapName = MatchInfo.MapName;
+		Info.DurationSeconds = MatchInfo.DurationSeconds;
+		Info.PlayerNames = MatchInfo.PlayerNames;
+	}
+}
+
+void FShooterDemoIndexer::WriteMatchInfo(UWorld* World)
+{
+	// only when recording, a playback driver has a server connection
+	UDemoNetDriver* DemoDriver = World ? World->DemoNetDriver : NULL;
+	if (DemoDriver == NULL || DemoDriver->ServerConnection != NULL || DemoDriver->DemoFilename.Len() == 0)
+	{
+		return;
+	}
+
+	FString MapName = World->GetMapName();
+	float DurationSeconds = 0.0f;
+	TArray<FString> PlayerNames;
+	if (World->GameState)
+	{
+		DurationSeconds = World->GameState->ElapsedTime;
+		for (int32 i = 0; i < World->GameState->PlayerArray.Num(); i++)
+		{
+			APlayerState* PlayerState = World->GameState->PlayerArray[i];
+			if (PlayerState && !PlayerState->bIsSpectator)
+			{
+				PlayerNames.Add(PlayerState->PlayerName);
+			}
+		}
+	}
+
+	TArray<uint8> Bytes;
+	FMemoryWriter Ar(Bytes);
+	uint32 Magic = DemoMatchInfoMagic;
+	int32 Version = DemoIndexVersion;
+	Ar << Magic;
+	Ar << Version;
+	Ar << MapName;
+	Ar << DurationSeconds;
+	Ar << PlayerNames;
+
+	FFileHelper::SaveArrayToFile(Bytes, *GetMatchInfoPath(FPaths::GetCleanFilename(DemoDriver->DemoFilename)));
+}
+
+uint32 FShooterDemoIndexer::Run()
+{
+	const FString DemoDir = GetDemoDir();
+	const FString IndexPath = DemoDir + DemoIndexFileName;
+
+	// cached demos, by file name
+	TMap<FString, FShooterDemoInfo> Cached;
+	TArray<uint8> IndexBytes;
+	if (FFileHelper::LoadFileToArray(IndexBytes, *IndexPath, FILEREAD_Silent))
+	{
+		FMemoryReader Ar(IndexBytes);
+		uint32 Magic = 0;
+		int32 Version = 0;
+		TArray<FShooterDemoInfo> CachedInfos;
+		Ar << Magic;
+		Ar << Version;
+		if (Magic == DemoIndexMagic && Version == DemoIndexVersion)
+		{
+			Ar << CachedInfos;
+		}
+
+		if (!Ar.IsError())
+		{
+			for (int32 i = 0; i < CachedInfos.Num(); i++)
+			{
+				Cached.Add(CachedInfos[i].FileName, CachedInfos[i]);
+			}
+		}
+	}
+
+	FDemoFileVisitor Visitor;
+	FPlatformFileManager::Get().GetPlatformFile().IterateDirectoryStat(*DemoDir, Visitor);
+
+	// report unchanged demos first, they cost nothing
+	TArray<FShooterDemoInfo> Index;
+	TArray<int32> Changed;
+	for (int32 i = 0; i < Visitor.Files.Num(); i++)
+	{
+		const FShooterDemoInfo& File = Visitor.Files[i];
+		const FShooterDemoInfo* CachedInfo = Cached.Find(File.FileName);
+		if (CachedInfo && CachedInfo->SizeBytes == File.SizeBytes && CachedInfo->TimeStamp == File.TimeStamp)
+		{
+			Index.Add(*CachedInfo);
+			AddResult(*CachedInfo);
+		}
+		else
+		{
+			Changed.Add(i);
+		}
+	}
+
+	const bool bIndexChanged = Changed.Num() > 0 || Index.Num() != Cached.Num();
+	for (int32 i = 0; i < Changed.Num() && StopRequested.GetValue() == 0; i++)
+	{
+		FShooterDemoInfo& Info = Visitor.Files[Changed[i]];
+		ReadMatchInfo(Info);
+		Index.Add(Info);
+		AddResult(Info);
+	}
+
+	// don't save a partial index, the next scan would drop the demos we did not get to
+	if (bIndexChanged && StopRequested.GetValue() == 0)
+	{
+		TArray<uint8> Bytes;
+		FMemoryWriter Ar(Bytes);
+		uint32 Magic = DemoIndexMagic;
+		int32 Version = DemoIndexVersion;
+		Ar << Magic;
+		Ar << Version;
+		Ar << Index;
+
+		const FString TempPath = IndexPath + TEXT(".tmp");
+		if (FFileHelper::SaveArrayToFile(Bytes, *TempPath))
+		{
+			IFileManager::Get().Move(*IndexPath, *TempPath, true);
+		}
+	}
+
+	Finished.Increment();
+	return 0;
+}
+
+void FShooterDemoIndexer::Stop()
+{
+	StopRequested.Increment();
+}
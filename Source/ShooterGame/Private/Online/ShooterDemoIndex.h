@@ -0,0 +1,92 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+/** what we know about a recorded demo */
+struct FShooterDemoInfo
+{
+	/** file name, without path */
+	FString FileName;
+
+	/** file size (bytes) */
+	int64 SizeBytes;
+
+	/** last modification time, UTC */
+	FDateTime TimeStamp;
+
+	/** map the demo was recorded on, empty if unknown */
+	FString MapName;
+
+	/** length of recorded match (seconds), 0 if unknown */
+	float DurationSeconds;
+
+	/** names of players in the recorded match */
+	TArray<FString> PlayerNames;
+
+	FShooterDemoInfo()
+		: SizeBytes(0)
+		, DurationSeconds(0.0f)
+	{
+	}
+
+	friend FArchive& operator<<(FArchive& Ar, FShooterDemoInfo& Info);
+};
+
+/**
+ * Scans the demo directory on a worker thread.
+ * Results are cached in an index file next to the demos, so a rescan only reads match info of demos that were added or changed.
+ * Demos are reported as soon as they are known, cached ones first.
+ */
+class FShooterDemoIndexer : public FRunnable
+{
+public:
+
+	FShooterDemoIndexer();
+	virtual ~FShooterDemoIndexer();
+
+	/** start scanning, does nothing if already started */
+	void Start();
+
+	/** check if scan is done and all results were handed out */
+	bool IsFinished() const;
+
+	/** move demos found since last call to OutInfos */
+	void ConsumeResults(TArray<FShooterDemoInfo>& OutInfos);
+
+	/** write match info of demo being recorded, so the demo list can show map, length and players */
+	static void WriteMatchInfo(class UWorld* World);
+
+	// Begin FRunnable interface
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+	// End FRunnable interface
+
+private:
+
+	/** get directory demos are saved to */
+	static FString GetDemoDir();
+
+	/** get match info file of demo */
+	static FString GetMatchInfoPath(const FString& DemoFileName);
+
+	/** fill match info fields of demo from its match info file */
+	static void ReadMatchInfo(FShooterDemoInfo& Info);
+
+	/** hand demo to the game thread */
+	void AddResult(const FShooterDemoInfo& Info);
+
+	/** demos found but not consumed yet */
+	TArray<FShooterDemoInfo> Results;
+
+	/** guards Results */
+	mutable FCriticalSection ResultsLock;
+
+	/** set when worker is done */
+	FThreadSafeCounter Finished;
+
+	/** set when worker should exit early */
+	FThreadSafeCounter StopRequested;
+
+	/** worker thread */
+	FRunnableThread* Thread;
+};
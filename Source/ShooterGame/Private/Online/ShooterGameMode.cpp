@@ -2,6 +2,17 @@
 
 #include "ShooterGame.h"
 #include "ShooterSpectatorPawn.h"
+#include "Bots/ShooterBotScheduler.h"
+#include "Bots/ShooterAITraceService.h"
+#include "Bots/ShooterTacticalPoints.h"
+#include "Bots/ShooterLightweightBots.h"
+#include "Online/ShooterMatchEvents.h"
+#include "Online/ShooterInfluenceMap.h"
+#include "Online/ShooterDemoIndex.h"
+#include "Online/ShooterReplayIndex.h"
+#include "Online/ShooterTelemetry.h"
+#include "Online/ShooterServerMetrics.h"
+#include "ShooterSoakTest.h"
 
 AShooterGameMode::AShooterGameMode(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
@@ -23,6 +34,29 @@ AShooterGameMode::AShooterGameMode(const FObjectInitializer& ObjectInitializer)
 	bAllowBots = true;	
 	bNeedsBotCreation = true;
 	bUseSeamlessTravel = true;	
+
+	bUseBotScheduler = true;
+	BotBrainBudgetMicroseconds = 1000.0f;
+	BotUrgencyWindow = 2.0f;
+	bUseLightweightBots = false;
+	bMirrorLightweightBotsToBlackboard = false;
+	bUseAsyncAITraces = true;
+	bUseTacticalPoints = true;
+	bUseInfluenceMap = true;
+	InfluenceUpdateRate = 30.0f;
+	InfluenceHalfLife = 5.0f;
+	SpawnDangerThreshold = 1.0f;
+	ReplayKeyframeInterval = 10.0f;
+	bRecordTelemetry = false;
+	MetricsPort = 0;
+	bLimitClientRpcs = true;
+	ServerNotifyHitLimit = FShooterRpcLimit(30.0f, 30.0f, 300);
+	ServerNotifyMissLimit = FShooterRpcLimit(30.0f, 30.0f, 300);
+	ServerSetGravityModeLimit = FShooterRpcLimit(10.0f, 10.0f, 100);
+	ServerSetFullControlRotationLimit = FShooterRpcLimit(250.0f, 125.0f, 0);
+	ServerHandleFiringLimit = FShooterRpcLimit(30.0f, 30.0f, 300);
+
+	PrimaryActorTick.bCanEverTick = true;
 }
 
 FString AShooterGameMode::GetBotsCountOptionName()
@@ -41,6 +75,71 @@ void AShooterGameMode::InitGame(const FString& MapName, const FString& Options,
 	{
 		bPauseable = false;
 	}
+
+	if (bUseBotScheduler)
+	{
+		BotScheduler = MakeShareable(new FShooterBotScheduler());
+		BotScheduler->SetBudget(BotBrainBudgetMicroseconds);
+		BotScheduler->SetUrgencyWindow(BotUrgencyWindow);
+	}
+
+	if (bUseLightweightBots || HasOption(Options, TEXT("LightweightBots")))
+	{
+		LightweightBots = MakeShareable(new FShooterLightweightBots());
+		LightweightBots->SetMirrorToBlackboard(bMirrorLightweightBotsToBlackboard);
+	}
+
+	if (bUseAsyncAITraces)
+	{
+		AITraceService = MakeShareable(new FShooterAITraceService());
+	}
+
+	if (bUseTacticalPoints)
+	{
+		TacticalPoints = MakeShareable(new FShooterTacticalPoints());
+	}
+
+	if (FShooterSoakTest::IsRequested())
+	{
+		SoakTest = MakeShareable(new FShooterSoakTest());
+
+		// the match must not end or travel while sampling
+		RoundTime = 0;
+	}
+
+	if (bUseInfluenceMap)
+	{
+		InfluenceMap = MakeShareable(new FShooterInfluenceMap());
+		InfluenceMap->SetUpdateRate(InfluenceUpdateRate);
+		InfluenceMap->SetHalfLife(InfluenceHalfLife);
+	}
+
+	MatchEvents = MakeShareable(new FShooterMatchEventBus());
+	MatchStats = MakeShareable(new FShooterMatchStats());
+	MatchStats->Subscribe(*MatchEvents);
+
+	ReplayRecorder = MakeShareable(new FShooterReplayRecorder());
+	ReplayRecorder->SetKeyframeInterval(ReplayKeyframeInterval);
+	ReplayRecorder->Subscribe(*MatchEvents);
+
+	if (bRecordTelemetry && IsRunningDedicatedServer())
+	{
+		TelemetryRecorder = MakeShareable(new FShooterTelemetryRecorder());
+		TelemetryRecorder->Subscribe(*MatchEvents);
+	}
+
+	// after the stats, so results include the end of the match
+	MatchEvents->OnEvent(EShooterMatchEvent::MatchEnd).AddUObject(this, &AShooterGameMode::HandleMatchEnd);
+
+	FParse::Value(FCommandLine::Get(), TEXT("MetricsPort="), MetricsPort);
+	if (MetricsPort > 0 && IsRunningDedicatedServer())
+	{
+		ServerMetrics = MakeShareable(new FShooterServerMetrics());
+		if (!ServerMetrics->Listen(MetricsPort))
+		{
+			ServerMetrics.Reset();
+		}
+	}
 }
 
 void AShooterGameMode::SetAllowBots(bool bInAllowBots, int32 InMaxBots)
@@ -49,6 +148,159 @@ void AShooterGameMode::SetAllowBots(bool bInAllowBots, int32 InMaxBots)
 	MaxBots = InMaxBots;
 }
 
+void AShooterGameMode::SetBotBrainBudget(float InBudgetMicroseconds)
+{
+	BotBrainBudgetMicroseconds = InBudgetMicroseconds;
+	if (BotScheduler.IsValid())
+	{
+		BotScheduler->SetBudget(BotBrainBudgetMicroseconds);
+	}
+}
+
+FShooterBotScheduler* AShooterGameMode::GetBotScheduler() const
+{
+	return BotScheduler.Get();
+}
+
+FShooterAITraceService* AShooterGameMode::GetAITraceService() const
+{
+	return AITraceService.Get();
+}
+
+FShooterTacticalPoints* AShooterGameMode::GetTacticalPoints() const
+{
+	return TacticalPoints.Get();
+}
+
+FShooterInfluenceMap* AShooterGameMode::GetInfluenceMap() const
+{
+	return InfluenceMap.Get();
+}
+
+FShooterLightweightBots* AShooterGameMode::GetLightweightBots() const
+{
+	return LightweightBots.Get();
+}
+
+void AShooterGameMode::BroadcastMatchEvent(FShooterMatchEvent& Event)
+{
+	if (MatchEvents.IsValid())
+	{
+		Event.TimeSeconds = GetWorld()->GetTimeSeconds();
+		MatchEvents->Broadcast(Event);
+	}
+}
+
+FShooterMatchEventBus* AShooterGameMode::GetMatchEvents() const
+{
+	return MatchEvents.Get();
+}
+
+const FShooterMatchStats* AShooterGameMode::GetMatchStats() const
+{
+	return MatchStats.Get();
+}
+
+FShooterMatchResult AShooterGameMode::MakeMatchResult(AShooterPlayerState* PlayerState, bool bRoundCompleted) const
+{
+	FShooterMatchResult Result;
+	Result.bWon = IsWinner(PlayerState);
+	Result.bRoundCompleted = bRoundCompleted;
+
+	AShooterGameState* const MyGameState = Cast<AShooterGameState>(GameState);
+	Result.DurationSeconds = MyGameState ? MyGameState->ElapsedTime : 0;
+	Result.Score = PlayerState ? FMath::TruncToInt(PlayerState->Score) : 0;
+
+	const FShooterPlayerMatchStats* PlayerStats = MatchStats.IsValid() ? MatchStats->Find(PlayerState) : NULL;
+	if (PlayerStats)
+	{
+		Result.Kills = PlayerStats->Kills;
+		Result.Deaths = PlayerStats->Deaths;
+		Result.BulletsFired = PlayerStats->BulletsFired;
+		Result.RocketsFired = PlayerStats->RocketsFired;
+		Result.BulletsHit = PlayerStats->BulletsHit;
+		Result.RocketsHit = PlayerStats->RocketsHit;
+		Result.GravityFlips = PlayerStats->GravityFlips;
+	}
+
+	return Result;
+}
+
+const FShooterRpcLimit* AShooterGameMode::GetClientRpcLimit(EShooterServerRpc::Type Rpc) const
+{
+	if (!bLimitClientRpcs)
+	{
+		return NULL;
+	}
+
+	switch (Rpc)
+	{
+	case EShooterServerRpc::NotifyHit:
+		return &ServerNotifyHitLimit;
+	case EShooterServerRpc::NotifyMiss:
+		return &ServerNotifyMissLimit;
+	case EShooterServerRpc::SetGravityMode:
+		return &ServerSetGravityModeLimit;
+	case EShooterServerRpc::SetFullControlRotation:
+		return &ServerSetFullControlRotationLimit;
+	case EShooterServerRpc::HandleFiring:
+		return &ServerHandleFiringLimit;
+	default:
+		return NULL;
+	}
+}
+
+void AShooterGameMode::Tick(float DeltaSeconds)
+{
+	Super::Tick(DeltaSeconds);
+
+	{
+		FShooterSoakScope SoakScope(EShooterSoakSubsystem::AI);
+
+		// collect last frame's traces before bots ask for them again
+		if (AITraceService.IsValid())
+		{
+			AITraceService->Tick(GetWorld());
+		}
+
+		if (BotScheduler.IsValid())
+		{
+			BotScheduler->Tick(GetWorld()->GetTimeSeconds());
+		}
+
+		if (LightweightBots.IsValid())
+		{
+			LightweightBots->Tick(GetWorld(), DeltaSeconds);
+		}
+
+		if (TacticalPoints.IsValid())
+		{
+			TacticalPoints->Tick(GetWorld());
+		}
+	}
+
+	if (ReplayRecorder.IsValid())
+	{
+		ReplayRecorder->Tick(GetWorld());
+	}
+
+	if (TelemetryRecorder.IsValid())
+	{
+		TelemetryRecorder->RecordFrame(GetWorld());
+	}
+
+	if (ServerMetrics.IsValid())
+	{
+		ServerMetrics->Tick(this);
+	}
+
+	if (InfluenceMap.IsValid())
+	{
+		FShooterSoakScope SoakScope(EShooterSoakSubsystem::AI);
+		InfluenceMap->Tick(GetWorld(), DeltaSeconds);
+	}
+}
+
 /** Returns game session class to use */
 TSubclassOf<AGameSession> AShooterGameMode::GetGameSessionClass() const
 {
@@ -83,23 +335,7 @@ void AShooterGameMode::DefaultTimer()
 			}
 			else if (GetMatchState() == MatchState::InProgress)
 			{
-				FinishMatch();
-
-				// Send end round events
-				AShooterGameState* const MyGameState = Cast<AShooterGameState>(GameState);
-				
-				for (FConstControllerIterator It = GetWorld()->GetControllerIterator(); It; ++It)
-				{
-					AShooterPlayerController* PlayerController = Cast<AShooterPlayerController>(*It);
-					
-					if (PlayerController && MyGameState)
-					{
-						AShooterPlayerState* PlayerState = Cast<AShooterPlayerState>((*It)->PlayerState);
-						const bool bIsWinner = IsWinner(PlayerState);
-					
-						PlayerController->ClientSendRoundEndEvent(bIsWinner, MyGameState->ElapsedTime);
-					}
-				}
+				EndMatchAndNotify(true);
 			}
 			else if (GetMatchState() == MatchState::WaitingToStart)
 			{
@@ -143,8 +379,45 @@ void AShooterGameMode::HandleMatchHasStarted()
 
 	AShooterGameState* const MyGameState = Cast<AShooterGameState>(GameState);
 	MyGameState->RemainingTime = RoundTime;	
+
+	// navigation is loaded by now, and bots only need the points once they fight; a bake runs over the next frames
+	if (TacticalPoints.IsValid() && !TacticalPoints->IsBuilt())
+	{
+		TacticalPoints->Build(GetWorld());
+	}
+
+	// cover the spawn points plus some room around them, fighting happens in between
+	if (InfluenceMap.IsValid() && !InfluenceMap->IsInitialized() && PlayerStarts.Num() > 0)
+	{
+		FBox Bounds(0);
+		for (int32 i = 0; i < PlayerStarts.Num(); i++)
+		{
+			if (PlayerStarts[i])
+			{
+				Bounds += PlayerStarts[i]->GetActorLocation();
+			}
+		}
+		InfluenceMap->Init(Bounds.ExpandBy(2000.0f));
+	}
+
 	StartBots();	
 
+	if (MatchStats.IsValid())
+	{
+		MatchStats->Reset();
+	}
+
+	if (TelemetryRecorder.IsValid())
+	{
+		const FString FileName = FString::Printf(TEXT("%s_%s.telemetry"), *GetWorld()->GetMapName(), *FDateTime::Now().ToString());
+		TelemetryRecorder->BeginRecording(FPaths::GameSavedDir() + TEXT("Telemetry/") + FileName);
+	}
+
+	if (SoakTest.IsValid())
+	{
+		SoakTest->Start(GetWorld());
+	}
+
 	// notify players
 	for (FConstControllerIterator It = GetWorld()->GetControllerIterator(); It; ++It)
 	{
@@ -157,6 +430,11 @@ void AShooterGameMode::HandleMatchHasStarted()
 }
 
 void AShooterGameMode::FinishMatch()
+{
+	EndMatchAndNotify(false);
+}
+
+void AShooterGameMode::EndMatchAndNotify(bool bRoundCompleted)
 {
 	AShooterGameState* const MyGameState = Cast<AShooterGameState>(GameState);
 	if (IsMatchInProgress())
@@ -164,13 +442,19 @@ void AShooterGameMode::FinishMatch()
 		EndMatch();
 		DetermineMatchWinner();		
 
-		// notify players
-		for (FConstControllerIterator It = GetWorld()->GetControllerIterator(); It; ++It)
-		{
-			AShooterPlayerState* PlayerState = Cast<AShooterPlayerState>((*It)->PlayerState);
-			const bool bIsWinner = IsWinner(PlayerState);
+		// players are notified by HandleMatchEnd
+		FShooterMatchEvent MatchEndEvent(EShooterMatchEvent::MatchEnd, NULL, NULL, bRoundCompleted ? 1 : 0);
+		BroadcastMatchEvent(MatchEndEvent);
 
-			(*It)->GameHasEnded(NULL, bIsWinner);
+		// lets the demo list show map, length and players of this match without opening the demo
+		FShooterDemoIndexer::WriteMatchInfo(GetWorld());
+		if (ReplayRecorder.IsValid())
+		{
+			ReplayRecorder->Save(GetWorld());
+		}
+		if (TelemetryRecorder.IsValid())
+		{
+			TelemetryRecorder->EndRecording();
 		}
 
 		// lock all pawns
@@ -186,6 +470,25 @@ void AShooterGameMode::FinishMatch()
 	}
 }
 
+void AShooterGameMode::HandleMatchEnd(const FShooterMatchEvent& Event)
+{
+	// every client needs its own numbers, so this stays one call per player, but nothing is recounted here
+	const bool bRoundCompleted = Event.Value != 0;
+	for (FConstControllerIterator It = GetWorld()->GetControllerIterator(); It; ++It)
+	{
+		AShooterPlayerState* PlayerState = Cast<AShooterPlayerState>((*It)->PlayerState);
+		const FShooterMatchResult Result = MakeMatchResult(PlayerState, bRoundCompleted);
+
+		(*It)->GameHasEnded(NULL, Result.bWon);
+
+		AShooterPlayerController* PlayerController = Cast<AShooterPlayerController>(*It);
+		if (PlayerController)
+		{
+			PlayerController->ClientMatchEnded(Result);
+		}
+	}
+}
+
 void AShooterGameMode::RequestFinishAndExitToMainMenu()
 {
 	FString RemoteReturnReason = NSLOCTEXT("NetworkErrors", "HostHasLeft", "Host has left the game.").ToString();
@@ -274,12 +577,33 @@ void AShooterGameMode::Killed(AController* Killer, AController* KilledPlayer, AP
 	{
 		KillerPlayerState->ScoreKill(VictimPlayerState, KillScore);
 		KillerPlayerState->InformAboutKill(KillerPlayerState, DamageType, VictimPlayerState);
+
+		FShooterMatchEvent KillEvent(EShooterMatchEvent::Kill, KillerPlayerState, VictimPlayerState);
+		BroadcastMatchEvent(KillEvent);
 	}
 
 	if (VictimPlayerState)
 	{
 		VictimPlayerState->ScoreDeath(KillerPlayerState, DeathScore);
 		VictimPlayerState->BroadcastDeath(KillerPlayerState, DamageType, VictimPlayerState);
+
+		FShooterMatchEvent DeathEvent(EShooterMatchEvent::Death, VictimPlayerState, KillerPlayerState);
+		BroadcastMatchEvent(DeathEvent);
+	}
+
+	if (InfluenceMap.IsValid() && KilledPawn)
+	{
+		InfluenceMap->AddDanger(KilledPawn->GetActorLocation(), 1.0f, GetWorld()->GetTimeSeconds());
+	}
+}
+
+void AShooterGameMode::NotifyPawnDamaged(AShooterCharacter* DamagedPawn, float Damage)
+{
+	// Killed stamps the lethal hit as a whole kill
+	if (InfluenceMap.IsValid() && DamagedPawn && DamagedPawn->Health > 0 && DamagedPawn->GetMaxHealth() > 0)
+	{
+		// losing a full health bar counts like a kill
+		InfluenceMap->AddDanger(DamagedPawn->GetActorLocation(), Damage / DamagedPawn->GetMaxHealth(), GetWorld()->GetTimeSeconds());
 	}
 }
 
@@ -336,6 +660,8 @@ UClass* AShooterGameMode::GetDefaultPawnClassForController(AController* InContro
 
 AActor* AShooterGameMode::ChoosePlayerStart(AController* Player)
 {
+	SCOPE_CYCLE_COUNTER(STAT_ShooterChoosePlayerStart);
+
 	TArray<APlayerStart*> PreferredSpawns;
 	TArray<APlayerStart*> FallbackSpawns;
 
@@ -403,6 +729,12 @@ bool AShooterGameMode::IsSpawnpointAllowed(APlayerStart* SpawnPoint, AController
 
 bool AShooterGameMode::IsSpawnpointPreferred(APlayerStart* SpawnPoint, AController* Player) const
 {
+	// don't drop anyone into a firefight
+	if (InfluenceMap.IsValid() && InfluenceMap->GetDanger(SpawnPoint->GetActorLocation(), GetWorld()->GetTimeSeconds()) > SpawnDangerThreshold)
+	{
+		return false;
+	}
+
 	ACharacter* MyPawn = Player ? Cast<ACharacter>(Player->GetPawn()) : NULL;
 	if (MyPawn)
 	{
@@ -10,7 +10,16 @@ namespace
 
 AShooterGameSession::AShooterGameSession(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
+	, NextRankedSession(0)
+	, bMatchmaking(false)
+	, bMatchmakingCanceled(false)
 {
+	MatchmakingMaxPing = 250;
+	MatchmakingPingWeight = 1.0f;
+	MatchmakingFillWeight = 100.0f;
+	MatchmakingGameTypeWeight = 150.0f;
+	MatchmakingMapWeight = 50.0f;
+
 	if (!HasAnyFlags(RF_ClassDefaultObject))
 	{
 		OnCreateSessionCompleteDelegate = FOnCreateSessionCompleteDelegate::CreateUObject(this, &AShooterGameSession::OnCreateSessionComplete);
@@ -255,20 +264,101 @@ void AShooterGameSession::OnFindSessionsComplete(bool bWasSuccessful)
 			OnFindSessionsComplete().Broadcast(bWasSuccessful);
 		}
 	}
+
+	if (bMatchmaking)
+	{
+		if (bWasSuccessful && !bMatchmakingCanceled)
+		{
+			StartMatchmaking();
+		}
+		else
+		{
+			FinishMatchmaking(false);
+		}
+	}
 }
 
 void AShooterGameSession::ResetBestSessionVars()
 {
 	CurrentSessionParams.BestSessionIdx = -1;
+	RankedSessionIndices.Reset();
+	NextRankedSession = 0;
+}
+
+void AShooterGameSession::SetMatchmakingPreferences(const FString& GameType, const FString& MapName)
+{
+	CurrentSessionParams.PreferredGameType = GameType;
+	CurrentSessionParams.PreferredMapName = MapName;
+}
+
+bool AShooterGameSession::ScoreSearchResult(const FOnlineSessionSearchResult& Result, float& OutScore) const
+{
+	// full sessions and distant ones would only cost a join round trip
+	const int32 NumOpenConnections = Result.Session.NumOpenPublicConnections;
+	if (NumOpenConnections <= 0 || Result.PingInMs > MatchmakingMaxPing)
+	{
+		return false;
+	}
+
+	// prefer sessions that already have players, a match that is about to fill up starts sooner
+	const int32 MaxPlayers = Result.Session.SessionSettings.NumPublicConnections;
+	const float Fill = MaxPlayers > 0 ? (float)(MaxPlayers - NumOpenConnections) / MaxPlayers : 0.0f;
+	OutScore = Fill * MatchmakingFillWeight - Result.PingInMs * MatchmakingPingWeight;
+
+	FString GameType;
+	if (CurrentSessionParams.PreferredGameType.Len() > 0 && Result.Session.SessionSettings.Get(SETTING_GAMEMODE, GameType) && GameType == CurrentSessionParams.PreferredGameType)
+	{
+		OutScore += MatchmakingGameTypeWeight;
+	}
+
+	FString MapName;
+	if (CurrentSessionParams.PreferredMapName.Len() > 0 && Result.Session.SessionSettings.Get(SETTING_MAPNAME, MapName) && MapName == CurrentSessionParams.PreferredMapName)
+	{
+		OutScore += MatchmakingMapWeight;
+	}
+	return true;
+}
+
+void AShooterGameSession::RankSearchResults()
+{
+	struct FRankedSession
+	{
+		int32 Index;
+		float Score;
+	};
+
+	TArray<FRankedSession> RankedSessions;
+	for (int32 SessionIndex = 0; SessionIndex < SearchSettings->SearchResults.Num(); SessionIndex++)
+	{
+		FRankedSession Ranked;
+		Ranked.Index = SessionIndex;
+		if (ScoreSearchResult(SearchSettings->SearchResults[SessionIndex], Ranked.Score))
+		{
+			RankedSessions.Add(Ranked);
+		}
+	}
+
+	RankedSessions.StableSort([](const FRankedSession& A, const FRankedSession& B)
+	{
+		return A.Score > B.Score;
+	});
+
+	RankedSessionIndices.Reset();
+	NextRankedSession = 0;
+	for (int32 i = 0; i < RankedSessions.Num(); i++)
+	{
+		RankedSessionIndices.Add(RankedSessions[i].Index);
+	}
+
+	UE_LOG(LogOnlineGame, Verbose, TEXT("Matchmaking ranked %d of %d sessions"), RankedSessionIndices.Num(), SearchSettings->SearchResults.Num());
 }
 
 void AShooterGameSession::ChooseBestSession()
 {
-	// Start searching from where we left off
-	for (int32 SessionIndex = CurrentSessionParams.BestSessionIdx+1; SessionIndex < SearchSettings->SearchResults.Num(); SessionIndex++)
+	// walk down the ranking, each call moves on to the next best session
+	if (NextRankedSession < RankedSessionIndices.Num())
 	{
-		// Found the match that we want
-		CurrentSessionParams.BestSessionIdx = SessionIndex;
+		CurrentSessionParams.BestSessionIdx = RankedSessionIndices[NextRankedSession++];
 		return;
 	}
 
@@ -278,13 +368,14 @@ void AShooterGameSession::ChooseBestSession()
 void AShooterGameSession::StartMatchmaking()
 {
 	ResetBestSessionVars();
+	RankSearchResults();
 	ContinueMatchmaking();
 }
 
 void AShooterGameSession::ContinueMatchmaking()
 {	
 	ChooseBestSession();
-	if (CurrentSessionParams.BestSessionIdx >= 0 && CurrentSessionParams.BestSessionIdx < SearchSettings->SearchResults.Num())
+	if (!bMatchmakingCanceled && CurrentSessionParams.BestSessionIdx >= 0 && CurrentSessionParams.BestSessionIdx < SearchSettings->SearchResults.Num())
 	{
 		IOnlineSubsystem* OnlineSub = IOnlineSubsystem::Get();
 		if (OnlineSub)
@@ -306,7 +397,35 @@ void AShooterGameSession::ContinueMatchmaking()
 void AShooterGameSession::OnNoMatchesAvailable()
 {
 	UE_LOG(LogOnlineGame, Verbose, TEXT("Matchmaking complete, no sessions available."));
+	ResetBestSessionVars();
 	SearchSettings = NULL;
+
+	if (bMatchmaking)
+	{
+		FinishMatchmaking(false);
+	}
+}
+
+void AShooterGameSession::FinishMatchmaking(bool bWasSuccessful)
+{
+	bMatchmaking = false;
+	bMatchmakingCanceled = false;
+	OnMatchmakingComplete().Broadcast(CurrentSessionParams.SessionName, bWasSuccessful);
+}
+
+void AShooterGameSession::FindMatch(TSharedPtr<FUniqueNetId> UserId, FName SessionName, bool bIsLAN, bool bIsPresence)
+{
+	bMatchmaking = true;
+	bMatchmakingCanceled = false;
+	FindSessions(UserId, SessionName, bIsLAN, bIsPresence);
+}
+
+void AShooterGameSession::CancelMatchmaking()
+{
+	if (bMatchmaking)
+	{
+		bMatchmakingCanceled = true;
+	}
 }
 
 void AShooterGameSession::FindSessions(TSharedPtr<FUniqueNetId> UserId, FName SessionName, bool bIsLAN, bool bIsPresence)
@@ -322,6 +441,10 @@ void AShooterGameSession::FindSessions(TSharedPtr<FUniqueNetId> UserId, FName Se
 		IOnlineSessionPtr Sessions = OnlineSub->GetSessionInterface();
 		if (Sessions.IsValid() && CurrentSessionParams.UserId.IsValid())
 		{
+			// ranking refers to the previous results
+			RankedSessionIndices.Reset();
+			NextRankedSession = 0;
+
 			SearchSettings = MakeShareable(new FShooterOnlineSearchSettings(bIsLAN, bIsPresence));
 			SearchSettings->QuerySettings.Set(SEARCH_KEYWORDS, CustomMatchKeyword, EOnlineComparisonOp::Equals);
 
@@ -387,7 +510,21 @@ void AShooterGameSession::OnJoinSessionComplete(FName SessionName, EOnJoinSessio
 		Sessions->ClearOnJoinSessionCompleteDelegate(OnJoinSessionCompleteDelegate);
 	}
 
+	// during matchmaking, a failed join moves on to the next best session
+	if (Result != EOnJoinSessionCompleteResult::Success && bMatchmaking && !bMatchmakingCanceled && NextRankedSession < RankedSessionIndices.Num())
+	{
+		ContinueMatchmaking();
+		return;
+	}
+	RankedSessionIndices.Reset();
+	NextRankedSession = 0;
+
 	OnJoinSessionComplete().Broadcast(Result);
+
+	if (bMatchmaking)
+	{
+		FinishMatchmaking(Result == EOnJoinSessionCompleteResult::Success);
+	}
 }
 
 bool AShooterGameSession::TravelToSession(int32 ControllerId, FName SessionName)
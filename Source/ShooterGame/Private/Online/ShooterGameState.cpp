@@ -7,6 +7,8 @@ AShooterGameState::AShooterGameState(const FObjectInitializer& ObjectInitializer
 	NumTeams = 0;
 	RemainingTime = 0;
 	bTimerPaused = false;
+	RankedVersion = 0;
+	bRankingDirty = true;
 }
 
 void AShooterGameState::GetLifetimeReplicatedProps( TArray< FLifetimeProperty > & OutLifetimeProps ) const
@@ -23,33 +25,103 @@ void AShooterGameState::GetRankedMap(int32 TeamIndex, RankedPlayerMap& OutRanked
 {
 	OutRankedMap.Empty();
 
-	//first, we need to go over all the PlayerStates, grab their score, and rank them
-	TMultiMap<int32, AShooterPlayerState*> SortedMap;
-	for(int32 i = 0; i < PlayerArray.Num(); ++i)
+	UpdateRankedPlayers();
+	if (!RankedPlayers.IsValidIndex(TeamIndex))
 	{
-		int32 Score = 0;
-		AShooterPlayerState* CurPlayerState = Cast<AShooterPlayerState>(PlayerArray[i]);
-		if (CurPlayerState && (CurPlayerState->GetTeamNum() == TeamIndex))
+		return;
+	}
+
+	const TArray<TWeakObjectPtr<AShooterPlayerState> >& TeamPlayers = RankedPlayers[TeamIndex];
+	for (int32 Rank = 0; Rank < TeamPlayers.Num(); Rank++)
+	{
+		OutRankedMap.Add(Rank, TeamPlayers[Rank]);
+	}
+}
+
+int32 AShooterGameState::GetRankedVersion() const
+{
+	UpdateRankedPlayers();
+	return RankedVersion;
+}
+
+void AShooterGameState::MarkRankingDirty()
+{
+	bRankingDirty = true;
+}
+
+void AShooterGameState::AddPlayerState(class APlayerState* PlayerState)
+{
+	Super::AddPlayerState(PlayerState);
+	MarkRankingDirty();
+}
+
+void AShooterGameState::RemovePlayerState(class APlayerState* PlayerState)
+{
+	Super::RemovePlayerState(PlayerState);
+	MarkRankingDirty();
+}
+
+void AShooterGameState::UpdateRankedPlayers() const
+{
+	// NumTeams is replicated without notify, so catch team count changes here
+	const int32 NumRankedTeams = FMath::Max(NumTeams, 1);
+	if (!bRankingDirty && RankedPlayers.Num() == NumRankedTeams)
+	{
+		return;
+	}
+	bRankingDirty = false;
+
+	bool bChanged = false;
+	if (RankedPlayers.Num() != NumRankedTeams)
+	{
+		RankedPlayers.SetNum(NumRankedTeams);
+		bChanged = true;
+	}
+
+	for (int32 TeamIndex = 0; TeamIndex < NumRankedTeams; TeamIndex++)
+	{
+		RankingScratch.Reset();
+		for (int32 i = 0; i < PlayerArray.Num(); ++i)
 		{
-			SortedMap.Add(FMath::TruncToInt(CurPlayerState->Score), CurPlayerState);
+			AShooterPlayerState* CurPlayerState = Cast<AShooterPlayerState>(PlayerArray[i]);
+			if (CurPlayerState && (CurPlayerState->GetTeamNum() == TeamIndex))
+			{
+				RankingScratch.Add(CurPlayerState);
+			}
 		}
-	}
 
-	//sort by the keys
-	SortedMap.KeySort(TGreater<int32>());
+		// best score first, PlayerId keeps players with equal score in a stable order
+		RankingScratch.Sort([](const AShooterPlayerState& A, const AShooterPlayerState& B)
+		{
+			const int32 ScoreA = FMath::TruncToInt(A.Score);
+			const int32 ScoreB = FMath::TruncToInt(B.Score);
+			return ScoreA != ScoreB ? ScoreA > ScoreB : A.PlayerId < B.PlayerId;
+		});
 
-	//now, add them back to the ranked map
-	OutRankedMap.Empty();
+		TArray<TWeakObjectPtr<AShooterPlayerState> >& TeamPlayers = RankedPlayers[TeamIndex];
+		bool bTeamChanged = TeamPlayers.Num() != RankingScratch.Num();
+		for (int32 i = 0; !bTeamChanged && i < RankingScratch.Num(); i++)
+		{
+			bTeamChanged = TeamPlayers[i].Get() != RankingScratch[i];
+		}
 
-	int32 Rank = 0;
-	for(TMultiMap<int32, AShooterPlayerState*>::TIterator It(SortedMap); It; ++It)
+		if (bTeamChanged)
+		{
+			TeamPlayers.Reset();
+			for (int32 i = 0; i < RankingScratch.Num(); i++)
+			{
+				TeamPlayers.Add(RankingScratch[i]);
+			}
+			bChanged = true;
+		}
+	}
+
+	if (bChanged)
 	{
-		OutRankedMap.Add(Rank++, It.Value());
+		RankedVersion++;
 	}
-	
 }
 
-
 void AShooterGameState::RequestFinishAndExitToMainMenu()
 {
 	if (AuthorityGameMode)
@@ -0,0 +1,138 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Online/ShooterInfluenceMap.h"
+
+/** smallest cell, the grid gets coarser on big maps instead of bigger */
+static const float MinCellSize = 500.0f;
+
+/** upper bound on cells along one axis */
+static const int32 MaxCellsPerAxis = 32;
+
+FShooterInfluenceMap::FShooterInfluenceMap()
+	: Origin(FVector::ZeroVector)
+	, CellSize(MinCellSize)
+	, SizeX(0)
+	, SizeY(0)
+	, SizeZ(0)
+	, HalfLifeSeconds(5.0f)
+	, UpdateInterval(1.0f / 30.0f)
+	, TimeSinceUpdate(0.0f)
+{
+}
+
+void FShooterInfluenceMap::Init(const FBox& Bounds)
+{
+	const FVector Extent = Bounds.GetSize();
+	CellSize = FMath::Max(MinCellSize, Extent.GetMax() / MaxCellsPerAxis);
+	Origin = Bounds.Min;
+	SizeX = FMath::Clamp(FMath::CeilToInt(Extent.X / CellSize), 1, MaxCellsPerAxis);
+	SizeY = FMath::Clamp(FMath::CeilToInt(Extent.Y / CellSize), 1, MaxCellsPerAxis);
+	SizeZ = FMath::Clamp(FMath::CeilToInt(Extent.Z / CellSize), 1, MaxCellsPerAxis);
+
+	Cells.Reset();
+	Cells.AddZeroed(SizeX * SizeY * SizeZ);
+	TimeSinceUpdate = 0.0f;
+}
+
+bool FShooterInfluenceMap::IsInitialized() const
+{
+	return Cells.Num() > 0;
+}
+
+void FShooterInfluenceMap::SetUpdateRate(float InUpdatesPerSecond)
+{
+	UpdateInterval = 1.0f / FMath::Max(1.0f, InUpdatesPerSecond);
+}
+
+void FShooterInfluenceMap::SetHalfLife(float InHalfLifeSeconds)
+{
+	HalfLifeSeconds = FMath::Max(0.1f, InHalfLifeSeconds);
+}
+
+int32 FShooterInfluenceMap::GetCellIndex(const FVector& Location) const
+{
+	const FVector Local = (Location - Origin) / CellSize;
+	const int32 X = FMath::Clamp(FMath::FloorToInt(Local.X), 0, SizeX - 1);
+	const int32 Y = FMath::Clamp(FMath::FloorToInt(Local.Y), 0, SizeY - 1);
+	const int32 Z = FMath::Clamp(FMath::FloorToInt(Local.Z), 0, SizeZ - 1);
+	return (Z * SizeY + Y) * SizeX + X;
+}
+
+float FShooterInfluenceMap::GetFade(float LastUpdateTime, float WorldTimeSeconds) const
+{
+	const float Elapsed = FMath::Max(0.0f, WorldTimeSeconds - LastUpdateTime);
+	return FMath::Pow(0.5f, Elapsed / HalfLifeSeconds);
+}
+
+void FShooterInfluenceMap::FadeCell(FCell& Cell, float WorldTimeSeconds) const
+{
+	const float Fade = GetFade(Cell.LastUpdateTime, WorldTimeSeconds);
+	Cell.Danger *= Fade;
+	Cell.Presence *= Fade;
+	Cell.LastUpdateTime = WorldTimeSeconds;
+}
+
+void FShooterInfluenceMap::Tick(UWorld* World, float DeltaSeconds)
+{
+	if (World == NULL || !IsInitialized())
+	{
+		return;
+	}
+
+	TimeSinceUpdate += DeltaSeconds;
+	if (TimeSinceUpdate < UpdateInterval)
+	{
+		return;
+	}
+
+	const float StampWeight = TimeSinceUpdate;
+	const float WorldTimeSeconds = World->GetTimeSeconds();
+	TimeSinceUpdate = 0.0f;
+
+	for (FConstPawnIterator It = World->GetPawnIterator(); It; ++It)
+	{
+		AShooterCharacter* Pawn = Cast<AShooterCharacter>(*It);
+		if (Pawn && Pawn->IsAlive())
+		{
+			FCell& Cell = Cells[GetCellIndex(Pawn->GetActorLocation())];
+			FadeCell(Cell, WorldTimeSeconds);
+			Cell.Presence += StampWeight;
+		}
+	}
+}
+
+void FShooterInfluenceMap::AddDanger(const FVector& Location, float Amount, float WorldTimeSeconds)
+{
+	if (!IsInitialized())
+	{
+		return;
+	}
+
+	FCell& Cell = Cells[GetCellIndex(Location)];
+	FadeCell(Cell, WorldTimeSeconds);
+	Cell.Danger += Amount;
+}
+
+float FShooterInfluenceMap::GetDanger(const FVector& Location, float WorldTimeSeconds) const
+{
+	if (!IsInitialized())
+	{
+		return 0.0f;
+	}
+
+	const FCell& Cell = Cells[GetCellIndex(Location)];
+	return Cell.Danger * GetFade(Cell.LastUpdateTime, WorldTimeSeconds);
+}
+
+float FShooterInfluenceMap::GetPawnCount(const FVector& Location, float WorldTimeSeconds) const
+{
+	if (!IsInitialized())
+	{
+		return 0.0f;
+	}
+
+	// a pawn that stays in a cell builds up HalfLifeSeconds / ln 2 pawn-seconds of presence
+	const FCell& Cell = Cells[GetCellIndex(Location)];
+	return Cell.Presence * GetFade(Cell.LastUpdateTime, WorldTimeSeconds) * FMath::Loge(2.0f) / HalfLifeSeconds;
+}
@@ -0,0 +1,82 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+/**
+ * Coarse 3D grid over the map telling where the fighting is.
+ * Danger comes from kills and damage, presence from pawns standing in a cell; both fade out with a fixed half-life.
+ * Fading is applied lazily when a cell is read or written, so an update only costs one stamp per pawn
+ * and is throttled to a fixed rate no matter how fast the server ticks.
+ */
+class FShooterInfluenceMap
+{
+public:
+
+	FShooterInfluenceMap();
+
+	/** size grid to cover Bounds, clears everything */
+	void Init(const FBox& Bounds);
+
+	/** check if grid was sized */
+	bool IsInitialized() const;
+
+	/** stamp presence of all living pawns, at most UpdateRate times per second */
+	void Tick(UWorld* World, float DeltaSeconds);
+
+	/** add danger at location, e.g. damage taken or a kill */
+	void AddDanger(const FVector& Location, float Amount, float WorldTimeSeconds);
+
+	/** get faded danger of the cell containing location */
+	float GetDanger(const FVector& Location, float WorldTimeSeconds) const;
+
+	/** get about how many pawns stood in the cell containing location lately, from its faded presence */
+	float GetPawnCount(const FVector& Location, float WorldTimeSeconds) const;
+
+	/** sets how often presence is stamped */
+	void SetUpdateRate(float InUpdatesPerSecond);
+
+	/** sets time for danger and presence to fade to half */
+	void SetHalfLife(float InHalfLifeSeconds);
+
+private:
+
+	struct FCell
+	{
+		float Danger;
+		float Presence;
+
+		/** world time Danger and Presence were last faded to */
+		float LastUpdateTime;
+	};
+
+	/** get index of cell containing location, clamped to the grid */
+	int32 GetCellIndex(const FVector& Location) const;
+
+	/** scale for values last faded at LastUpdateTime */
+	float GetFade(float LastUpdateTime, float WorldTimeSeconds) const;
+
+	/** fade cell up to WorldTimeSeconds */
+	void FadeCell(FCell& Cell, float WorldTimeSeconds) const;
+
+	TArray<FCell> Cells;
+
+	/** world space corner of cell 0 */
+	FVector Origin;
+
+	/** edge length of a cell */
+	float CellSize;
+
+	/** cells along each axis */
+	int32 SizeX;
+	int32 SizeY;
+	int32 SizeZ;
+
+	/** time for values to fade to half */
+	float HalfLifeSeconds;
+
+	/** time between presence stamps */
+	float UpdateInterval;
+
+	/** time since last presence stamp */
+	float TimeSinceUpdate;
+};
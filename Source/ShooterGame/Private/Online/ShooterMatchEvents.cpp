@@ -0,0 +1,113 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Online/ShooterMatchEvents.h"
+
+FOnShooterMatchEvent& FShooterMatchEventBus::OnEvent(EShooterMatchEvent::Type Type)
+{
+	check(Type >= 0 && Type < EShooterMatchEvent::MAX);
+	return Listeners[Type];
+}
+
+void FShooterMatchEventBus::Broadcast(const FShooterMatchEvent& Event)
+{
+	check(Event.Type >= 0 && Event.Type < EShooterMatchEvent::MAX);
+	Listeners[Event.Type].Broadcast(Event);
+}
+
+FShooterMatchStats::FShooterMatchStats()
+	: MatchEndTime(0.0f)
+{
+}
+
+void FShooterMatchStats::Subscribe(FShooterMatchEventBus& Bus)
+{
+	for (int32 i = 0; i < EShooterMatchEvent::MAX; i++)
+	{
+		Bus.OnEvent((EShooterMatchEvent::Type)i).AddRaw(this, &FShooterMatchStats::HandleEvent);
+	}
+}
+
+void FShooterMatchStats::Reset()
+{
+	PlayerStats.Empty();
+	Totals = FShooterPlayerMatchStats();
+	MatchEndTime = 0.0f;
+}
+
+const FShooterPlayerMatchStats* FShooterMatchStats::Find(const AShooterPlayerState* PlayerState) const
+{
+	return PlayerState ? PlayerStats.Find(PlayerState->PlayerId) : NULL;
+}
+
+const FShooterPlayerMatchStats& FShooterMatchStats::GetTotals() const
+{
+	return Totals;
+}
+
+float FShooterMatchStats::GetMatchEndTime() const
+{
+	return MatchEndTime;
+}
+
+void FShooterMatchStats::HandleEvent(const FShooterMatchEvent& Event)
+{
+	if (Event.Type == EShooterMatchEvent::MatchEnd)
+	{
+		MatchEndTime = Event.TimeSeconds;
+		return;
+	}
+
+	AShooterPlayerState* PlayerState = Event.PlayerState.Get();
+	if (PlayerState == NULL)
+	{
+		return;
+	}
+
+	FShooterPlayerMatchStats& Stats = PlayerStats.FindOrAdd(PlayerState->PlayerId);
+	switch (Event.Type)
+	{
+		case EShooterMatchEvent::Kill:
+			Stats.Kills++;
+			Totals.Kills++;
+			break;
+		case EShooterMatchEvent::Death:
+			Stats.Deaths++;
+			Totals.Deaths++;
+			break;
+		case EShooterMatchEvent::Shot:
+			if (Event.Value == (int32)AShooterWeapon::EAmmoType::ERocket)
+			{
+				Stats.RocketsFired++;
+				Totals.RocketsFired++;
+			}
+			else
+			{
+				Stats.BulletsFired++;
+				Totals.BulletsFired++;
+			}
+			break;
+		case EShooterMatchEvent::Hit:
+			if (Event.Value == (int32)AShooterWeapon::EAmmoType::ERocket)
+			{
+				Stats.RocketsHit++;
+				Totals.RocketsHit++;
+			}
+			else
+			{
+				Stats.BulletsHit++;
+				Totals.BulletsHit++;
+			}
+			break;
+		case EShooterMatchEvent::Pickup:
+			Stats.Pickups++;
+			Totals.Pickups++;
+			break;
+		case EShooterMatchEvent::GravityFlip:
+			Stats.GravityFlips++;
+			Totals.GravityFlips++;
+			break;
+		default:
+			break;
+	}
+}
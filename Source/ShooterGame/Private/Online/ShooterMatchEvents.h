@@ -0,0 +1,130 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+namespace EShooterMatchEvent
+{
+	enum Type
+	{
+		Kill,
+		Death,
+		Shot,
+		Hit,
+		Pickup,
+		GravityFlip,
+		MatchEnd,
+		MAX,
+	};
+}
+
+/** something that happened during the match, reported by the server */
+struct FShooterMatchEvent
+{
+	/** what happened */
+	EShooterMatchEvent::Type Type;
+
+	/** player the event is about: killer, victim, shooter... */
+	TWeakObjectPtr<class AShooterPlayerState> PlayerState;
+
+	/** other player involved: victim of a kill, killer of a death */
+	TWeakObjectPtr<class AShooterPlayerState> OtherPlayerState;
+
+	/** event specific value: EAmmoType for shots and hits, SBGravityMode for flips, 1 for a match end that ran out of time */
+	int32 Value;
+
+	/** world time of event */
+	float TimeSeconds;
+
+	FShooterMatchEvent(EShooterMatchEvent::Type InType, class AShooterPlayerState* InPlayerState = NULL, class AShooterPlayerState* InOtherPlayerState = NULL, int32 InValue = 0)
+		: Type(InType)
+		, PlayerState(InPlayerState)
+		, OtherPlayerState(InOtherPlayerState)
+		, Value(InValue)
+		, TimeSeconds(0.0f)
+	{
+	}
+};
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnShooterMatchEvent, const FShooterMatchEvent&);
+
+/**
+ * Server side dispatcher for match events.
+ * Subscribers register once per event type and get called as events happen, so nobody has to scan controllers at match end.
+ */
+class FShooterMatchEventBus
+{
+public:
+
+	/** get delegate called for every event of given type */
+	FOnShooterMatchEvent& OnEvent(EShooterMatchEvent::Type Type);
+
+	/** send event to all subscribers of its type */
+	void Broadcast(const FShooterMatchEvent& Event);
+
+private:
+
+	/** subscribers, per event type */
+	FOnShooterMatchEvent Listeners[EShooterMatchEvent::MAX];
+};
+
+/** per player numbers aggregated from match events */
+struct FShooterPlayerMatchStats
+{
+	int32 Kills;
+	int32 Deaths;
+	int32 BulletsFired;
+	int32 RocketsFired;
+	int32 BulletsHit;
+	int32 RocketsHit;
+	int32 Pickups;
+	int32 GravityFlips;
+
+	FShooterPlayerMatchStats()
+		: Kills(0)
+		, Deaths(0)
+		, BulletsFired(0)
+		, RocketsFired(0)
+		, BulletsHit(0)
+		, RocketsHit(0)
+		, Pickups(0)
+		, GravityFlips(0)
+	{
+	}
+};
+
+/** keeps match totals up to date as events come in */
+class FShooterMatchStats
+{
+public:
+
+	FShooterMatchStats();
+
+	/** start listening to events */
+	void Subscribe(FShooterMatchEventBus& Bus);
+
+	/** forget everything, called when a new match starts */
+	void Reset();
+
+	/** get numbers for player, NULL if nothing was recorded for them */
+	const FShooterPlayerMatchStats* Find(const class AShooterPlayerState* PlayerState) const;
+
+	/** get numbers summed over all players */
+	const FShooterPlayerMatchStats& GetTotals() const;
+
+	/** get world time of match end, 0 while the match is running */
+	float GetMatchEndTime() const;
+
+private:
+
+	/** update numbers for one event */
+	void HandleEvent(const FShooterMatchEvent& Event);
+
+	/** numbers per player, by PlayerId */
+	TMap<int32, FShooterPlayerMatchStats> PlayerStats;
+
+	/** numbers summed over all players */
+	FShooterPlayerMatchStats Totals;
+
+	/** world time of match end */
+	float MatchEndTime;
+};
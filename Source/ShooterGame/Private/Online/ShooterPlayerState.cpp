@@ -23,6 +23,7 @@ void AShooterPlayerState::Reset()
 	NumBulletsFired = 0;
 	NumRocketsFired = 0;
 	bQuitter = false;
+	MarkRankingDirty();
 }
 
 void AShooterPlayerState::UnregisterPlayerWithSession()
@@ -45,11 +46,28 @@ void AShooterPlayerState::SetTeamNum(int32 NewTeamNumber)
 	TeamNumber = NewTeamNumber;
 
 	UpdateTeamColors();
+	MarkRankingDirty();
 }
 
 void AShooterPlayerState::OnRep_TeamColor()
 {
 	UpdateTeamColors();
+	MarkRankingDirty();
+}
+
+void AShooterPlayerState::OnRep_Score()
+{
+	Super::OnRep_Score();
+	MarkRankingDirty();
+}
+
+void AShooterPlayerState::MarkRankingDirty()
+{
+	AShooterGameState* const MyGameState = GetWorld() ? Cast<AShooterGameState>(GetWorld()->GameState) : NULL;
+	if (MyGameState)
+	{
+		MyGameState->MarkRankingDirty();
+	}
 }
 
 void AShooterPlayerState::AddBulletsFired(int32 NumBullets)
@@ -152,6 +170,7 @@ void AShooterPlayerState::ScorePoints(int32 Points)
 	}
 
 	Score += Points;
+	MarkRankingDirty();
 }
 
 void AShooterPlayerState::InformAboutKill_Implementation(class AShooterPlayerState* KillerPlayerState, const UDamageType* KillerDamageType, class AShooterPlayerState* KilledPlayerState)
@@ -0,0 +1,265 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Online/ShooterReplayIndex.h"
+#include "Online/ShooterMatchEvents.h"
+#include "Engine/DemoNetDriver.h"
+
+/** first bytes of replay index files */
+static const uint32 ReplayIndexMagic = 0x4B524753;
+
+/** bump when the layout changes, old indices are then ignored */
+static const int32 ReplayIndexVersion = 1;
+
+FArchive& operator<<(FArchive& Ar, FShooterReplayPawnState& State)
+{
+	Ar << State.PlayerName;
+	Ar << State.Location;
+	Ar << State.Rotation;
+	Ar << State.Velocity;
+	Ar << State.Health;
+	Ar << State.GravityMode;
+	Ar << State.WeaponName;
+	Ar << State.Ammo;
+	Ar << State.AmmoInClip;
+	return Ar;
+}
+
+FArchive& operator<<(FArchive& Ar, FShooterReplayKeyframe& Keyframe)
+{
+	Ar << Keyframe.Time;
+	Ar << Keyframe.Pawns;
+	return Ar;
+}
+
+FArchive& operator<<(FArchive& Ar, FShooterReplayEvent& Event)
+{
+	Ar << Event.Time;
+	Ar << Event.Type;
+	Ar << Event.PlayerName;
+	Ar << Event.OtherPlayerName;
+	Ar << Event.Value;
+	return Ar;
+}
+
+const FShooterReplayPawnState* FShooterReplayKeyframe::FindPawn(const FString& PlayerName) const
+{
+	for (int32 i = 0; i < Pawns.Num(); i++)
+	{
+		if (Pawns[i].PlayerName == PlayerName)
+		{
+			return &Pawns[i];
+		}
+	}
+	return NULL;
+}
+
+const FShooterReplayKeyframe* FShooterReplayIndex::FindKeyframe(float Time) const
+{
+	// first keyframe after Time
+	int32 Low = 0;
+	int32 High = Keyframes.Num();
+	while (Low < High)
+	{
+		const int32 Mid = (Low + High) / 2;
+		if (Keyframes[Mid].Time <= Time)
+		{
+			Low = Mid + 1;
+		}
+		else
+		{
+			High = Mid;
+		}
+	}
+	return Low > 0 ? &Keyframes[Low - 1] : NULL;
+}
+
+const FShooterReplayEvent* FShooterReplayIndex::FindNextEvent(float Time) const
+{
+	int32 Low = 0;
+	int32 High = Events.Num();
+	while (Low < High)
+	{
+		const int32 Mid = (Low + High) / 2;
+		if (Events[Mid].Time <= Time)
+		{
+			Low = Mid + 1;
+		}
+		else
+		{
+			High = Mid;
+		}
+	}
+	return Low < Events.Num() ? &Events[Low] : NULL;
+}
+
+static FString GetReplayIndexPath(const FString& DemoName)
+{
+	return FPaths::GameSavedDir() + TEXT("Demos/") + FPaths::GetBaseFilename(DemoName) + TEXT(".demokeys");
+}
+
+bool FShooterReplayIndex::Save(const FString& DemoName)
+{
+	TArray<uint8> Bytes;
+	FMemoryWriter Ar(Bytes);
+	uint32 Magic = ReplayIndexMagic;
+	int32 Version = ReplayIndexVersion;
+	Ar << Magic;
+	Ar << Version;
+	Ar << Keyframes;
+	Ar << Events;
+
+	return FFileHelper::SaveArrayToFile(Bytes, *GetReplayIndexPath(DemoName));
+}
+
+bool FShooterReplayIndex::Load(const FString& DemoName)
+{
+	Reset();
+
+	TArray<uint8> Bytes;
+	if (!FFileHelper::LoadFileToArray(Bytes, *GetReplayIndexPath(DemoName), FILEREAD_Silent))
+	{
+		return false;
+	}
+
+	FMemoryReader Ar(Bytes);
+	uint32 Magic = 0;
+	int32 Version = 0;
+	Ar << Magic;
+	Ar << Version;
+	if (Magic != ReplayIndexMagic || Version != ReplayIndexVersion)
+	{
+		return false;
+	}
+
+	Ar << Keyframes;
+	Ar << Events;
+	if (Ar.IsError())
+	{
+		Reset();
+		return false;
+	}
+	return true;
+}
+
+void FShooterReplayIndex::Reset()
+{
+	Keyframes.Empty();
+	Events.Empty();
+}
+
+FShooterReplayRecorder::FShooterReplayRecorder()
+	: StartTime(-1.0f)
+	, LastKeyframeTime(0.0f)
+	, KeyframeInterval(10.0f)
+{
+}
+
+void FShooterReplayRecorder::Subscribe(FShooterMatchEventBus& Bus)
+{
+	Bus.OnEvent(EShooterMatchEvent::Kill).AddRaw(this, &FShooterReplayRecorder::HandleEvent);
+	Bus.OnEvent(EShooterMatchEvent::GravityFlip).AddRaw(this, &FShooterReplayRecorder::HandleEvent);
+}
+
+void FShooterReplayRecorder::SetKeyframeInterval(float InKeyframeInterval)
+{
+	KeyframeInterval = FMath::Max(1.0f, InKeyframeInterval);
+}
+
+FString FShooterReplayRecorder::GetRecordingDemoName(UWorld* World)
+{
+	// a playback driver has a server connection, a recording one doesn't
+	UDemoNetDriver* DemoDriver = World ? World->DemoNetDriver : NULL;
+	if (DemoDriver == NULL || DemoDriver->ServerConnection != NULL)
+	{
+		return FString();
+	}
+	return FPaths::GetBaseFilename(DemoDriver->DemoFilename);
+}
+
+void FShooterReplayRecorder::Tick(UWorld* World)
+{
+	const FString RecordingDemoName = GetRecordingDemoName(World);
+	if (RecordingDemoName.Len() == 0)
+	{
+		StartTime = -1.0f;
+		return;
+	}
+
+	if (StartTime < 0.0f || RecordingDemoName != DemoName)
+	{
+		// new recording, start with a keyframe so the camera always has one to fall back on
+		Index.Reset();
+		DemoName = RecordingDemoName;
+		StartTime = World->GetTimeSeconds();
+		TakeKeyframe(World, 0.0f);
+		return;
+	}
+
+	const float Time = World->GetTimeSeconds() - StartTime;
+	if (Time - LastKeyframeTime >= KeyframeInterval)
+	{
+		TakeKeyframe(World, Time);
+	}
+}
+
+void FShooterReplayRecorder::TakeKeyframe(UWorld* World, float Time)
+{
+	FShooterReplayKeyframe& Keyframe = Index.Keyframes[Index.Keyframes.AddDefaulted()];
+	Keyframe.Time = Time;
+	LastKeyframeTime = Time;
+
+	for (FConstPawnIterator It = World->GetPawnIterator(); It; ++It)
+	{
+		AShooterCharacter* Pawn = Cast<AShooterCharacter>(*It);
+		if (Pawn == NULL || Pawn->PlayerState == NULL)
+		{
+			continue;
+		}
+
+		FShooterReplayPawnState& State = Keyframe.Pawns[Keyframe.Pawns.AddDefaulted()];
+		State.PlayerName = Pawn->PlayerState->PlayerName;
+		State.Location = Pawn->GetActorLocation();
+		State.Rotation = Pawn->GetActorRotation();
+		State.Velocity = Pawn->GetVelocity();
+		State.Health = Pawn->Health;
+		State.GravityMode = Pawn->GravityMode;
+
+		AShooterWeapon* Weapon = Pawn->GetWeapon();
+		if (Weapon)
+		{
+			State.WeaponName = Weapon->GetClass()->GetName();
+			State.Ammo = Weapon->GetCurrentAmmo();
+			State.AmmoInClip = Weapon->GetCurrentAmmoInClip();
+		}
+	}
+}
+
+void FShooterReplayRecorder::HandleEvent(const FShooterMatchEvent& Event)
+{
+	if (StartTime < 0.0f)
+	{
+		return;
+	}
+
+	FShooterReplayEvent& ReplayEvent = Index.Events[Index.Events.AddDefaulted()];
+	ReplayEvent.Time = FMath::Max(0.0f, Event.TimeSeconds - StartTime);
+	ReplayEvent.Type = (uint8)Event.Type;
+	ReplayEvent.Value = Event.Value;
+	if (Event.PlayerState.IsValid())
+	{
+		ReplayEvent.PlayerName = Event.PlayerState->PlayerName;
+	}
+	if (Event.OtherPlayerState.IsValid())
+	{
+		ReplayEvent.OtherPlayerName = Event.OtherPlayerState->PlayerName;
+	}
+}
+
+void FShooterReplayRecorder::Save(UWorld* World)
+{
+	if (StartTime >= 0.0f && GetRecordingDemoName(World) == DemoName)
+	{
+		Index.Save(DemoName);
+	}
+}
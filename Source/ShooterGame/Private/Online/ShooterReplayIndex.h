@@ -0,0 +1,154 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+/** state of one pawn at a keyframe */
+struct FShooterReplayPawnState
+{
+	FString PlayerName;
+	FVector Location;
+	FRotator Rotation;
+	FVector Velocity;
+	float Health;
+
+	/** SBGravityMode */
+	uint8 GravityMode;
+
+	/** class name of equipped weapon, empty if none */
+	FString WeaponName;
+	int32 Ammo;
+	int32 AmmoInClip;
+
+	FShooterReplayPawnState()
+		: Location(ForceInitToZero)
+		, Rotation(ForceInitToZero)
+		, Velocity(ForceInitToZero)
+		, Health(0.0f)
+		, GravityMode(0)
+		, Ammo(0)
+		, AmmoInClip(0)
+	{
+	}
+
+	friend FArchive& operator<<(FArchive& Ar, FShooterReplayPawnState& State);
+};
+
+/** state of all pawns at a point of the recording */
+struct FShooterReplayKeyframe
+{
+	/** seconds since recording started */
+	float Time;
+
+	TArray<FShooterReplayPawnState> Pawns;
+
+	FShooterReplayKeyframe()
+		: Time(0.0f)
+	{
+	}
+
+	/** get state of player's pawn, NULL if player had no pawn */
+	const FShooterReplayPawnState* FindPawn(const FString& PlayerName) const;
+
+	friend FArchive& operator<<(FArchive& Ar, FShooterReplayKeyframe& Keyframe);
+};
+
+/** notable moment of the recording */
+struct FShooterReplayEvent
+{
+	/** seconds since recording started */
+	float Time;
+
+	/** EShooterMatchEvent */
+	uint8 Type;
+
+	/** killer, or player that flipped gravity */
+	FString PlayerName;
+
+	/** victim of a kill */
+	FString OtherPlayerName;
+
+	/** event specific value, see FShooterMatchEvent */
+	int32 Value;
+
+	FShooterReplayEvent()
+		: Time(0.0f)
+		, Type(0)
+		, Value(0)
+	{
+	}
+
+	friend FArchive& operator<<(FArchive& Ar, FShooterReplayEvent& Event);
+};
+
+/** keyframes and events of a demo, saved next to it */
+struct FShooterReplayIndex
+{
+	/** keyframes, by time */
+	TArray<FShooterReplayKeyframe> Keyframes;
+
+	/** events, by time */
+	TArray<FShooterReplayEvent> Events;
+
+	/** get last keyframe at or before Time, NULL if there is none */
+	const FShooterReplayKeyframe* FindKeyframe(float Time) const;
+
+	/** get first event after Time, NULL if there is none */
+	const FShooterReplayEvent* FindNextEvent(float Time) const;
+
+	/** write index of demo */
+	bool Save(const FString& DemoName);
+
+	/** read index of demo, false if it has none */
+	bool Load(const FString& DemoName);
+
+	void Reset();
+};
+
+/**
+ * Builds the replay index while the server records a demo.
+ * Takes a keyframe of every pawn at a fixed interval and keeps kills and gravity flips from the match event bus.
+ */
+class FShooterReplayRecorder
+{
+public:
+
+	FShooterReplayRecorder();
+
+	/** start listening to events */
+	void Subscribe(class FShooterMatchEventBus& Bus);
+
+	/** sets time between keyframes (seconds) */
+	void SetKeyframeInterval(float InKeyframeInterval);
+
+	/** takes keyframe when one is due, does nothing unless a demo is being recorded */
+	void Tick(class UWorld* World);
+
+	/** write index next to the demo being recorded */
+	void Save(class UWorld* World);
+
+private:
+
+	/** keep notable events */
+	void HandleEvent(const struct FShooterMatchEvent& Event);
+
+	/** get name of demo being recorded, empty if not recording */
+	static FString GetRecordingDemoName(class UWorld* World);
+
+	/** take keyframe of all pawns */
+	void TakeKeyframe(class UWorld* World, float Time);
+
+	/** index built so far */
+	FShooterReplayIndex Index;
+
+	/** demo the index belongs to */
+	FString DemoName;
+
+	/** world time recording started at, negative while not recording */
+	float StartTime;
+
+	/** recording time of last keyframe */
+	float LastKeyframeTime;
+
+	/** time between keyframes (seconds) */
+	float KeyframeInterval;
+};
@@ -0,0 +1,94 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Online/ShooterRpcLimiter.h"
+#include "Online/ShooterServerMetrics.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Client RPCs"), STAT_ShooterClientRpcs, STATGROUP_ShooterGame);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Client RPCs dropped"), STAT_ShooterClientRpcsDropped, STATGROUP_ShooterGame);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Clients kicked for RPC flooding"), STAT_ShooterRpcKicks, STATGROUP_ShooterGame);
+
+/** drops are counted over this long for KickAfterDrops (seconds) */
+static const float DropWindowSeconds = 10.0f;
+
+/** player controller of the client owning actor, NULL for server owned actors */
+static AShooterPlayerController* GetOwningController(const AActor* Caller)
+{
+	for (const AActor* Actor = Caller; Actor != NULL; Actor = Actor->GetOwner())
+	{
+		const AShooterPlayerController* PC = Cast<AShooterPlayerController>(Actor);
+		if (PC)
+		{
+			return const_cast<AShooterPlayerController*>(PC);
+		}
+	}
+	return NULL;
+}
+
+bool FShooterRpcLimiter::ValidateRpc(const AActor* Caller, EShooterServerRpc::Type Rpc)
+{
+	INC_DWORD_STAT(STAT_ShooterClientRpcs);
+	FShooterServerMetrics::CountRpc(Rpc);
+
+	UWorld* World = Caller ? Caller->GetWorld() : NULL;
+	AShooterGameMode* GameMode = World ? World->GetAuthGameMode<AShooterGameMode>() : NULL;
+	const FShooterRpcLimit* Limit = GameMode ? GameMode->GetClientRpcLimit(Rpc) : NULL;
+	AShooterPlayerController* PC = GetOwningController(Caller);
+	if (Limit == NULL || PC == NULL)
+	{
+		return true;
+	}
+
+	FShooterRpcLimiter* Limiter = PC->GetRpcLimiter();
+	if (Limiter == NULL || Limiter->Consume(Rpc, *Limit, World->GetRealTimeSeconds()))
+	{
+		return true;
+	}
+
+	INC_DWORD_STAT(STAT_ShooterRpcKicks);
+	UE_LOG(LogShooter, Warning, TEXT("Kicking %s for flooding RPC %d"), PC->PlayerState ? *PC->PlayerState->PlayerName : *PC->GetName(), (int32)Rpc);
+	return false;
+}
+
+bool FShooterRpcLimiter::IsRpcDropped(const AActor* Caller, EShooterServerRpc::Type Rpc)
+{
+	AShooterPlayerController* PC = GetOwningController(Caller);
+	FShooterRpcLimiter* Limiter = PC ? PC->GetRpcLimiter() : NULL;
+	return Limiter && Limiter->Buckets[Rpc].bDropped;
+}
+
+bool FShooterRpcLimiter::Consume(EShooterServerRpc::Type Rpc, const FShooterRpcLimit& Limit, float RealTimeSeconds)
+{
+	FBucket& Bucket = Buckets[Rpc];
+	if (Limit.CallsPerSecond <= 0.0f)
+	{
+		Bucket.bDropped = false;
+		return true;
+	}
+
+	// new buckets start full
+	const float Burst = FMath::Max(1.0f, Limit.Burst);
+	const float Elapsed = Bucket.LastRefillTime < 0.0f ? Burst / Limit.CallsPerSecond : RealTimeSeconds - Bucket.LastRefillTime;
+	Bucket.Tokens = FMath::Min(Burst, Bucket.Tokens + FMath::Max(0.0f, Elapsed) * Limit.CallsPerSecond);
+	Bucket.LastRefillTime = RealTimeSeconds;
+
+	if (Bucket.Tokens >= 1.0f)
+	{
+		Bucket.Tokens -= 1.0f;
+		Bucket.bDropped = false;
+		return true;
+	}
+
+	Bucket.bDropped = true;
+	INC_DWORD_STAT(STAT_ShooterClientRpcsDropped);
+	FShooterServerMetrics::CountDroppedRpc(Rpc);
+
+	if (RealTimeSeconds - Bucket.DropWindowStart > DropWindowSeconds)
+	{
+		Bucket.DropWindowStart = RealTimeSeconds;
+		Bucket.DropsInWindow = 0;
+	}
+	Bucket.DropsInWindow++;
+
+	return Limit.KickAfterDrops <= 0 || Bucket.DropsInWindow < Limit.KickAfterDrops;
+}
@@ -0,0 +1,54 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+/**
+ * Token buckets for the client to server RPCs of one connection, owned by its player controller on the server.
+ * _Validate functions call ValidateRpc, which counts the call and spends a token. A call without a token is dropped:
+ * validation still passes, but the _Implementation returns early after checking IsRpcDropped.
+ * A client that keeps getting dropped fails validation, and the engine closes its connection.
+ * Limits come from the game mode config, see AShooterGameMode::GetClientRpcLimit.
+ */
+class FShooterRpcLimiter
+{
+public:
+
+	/** [server] account for RPC called on actor owned by a client, false if the client should be kicked */
+	static bool ValidateRpc(const AActor* Caller, EShooterServerRpc::Type Rpc);
+
+	/** [server] check if the last call of RPC on actor was over its limit and should be ignored */
+	static bool IsRpcDropped(const AActor* Caller, EShooterServerRpc::Type Rpc);
+
+private:
+
+	/** bucket of one RPC type */
+	struct FBucket
+	{
+		float Tokens;
+
+		/** real time tokens were last added, negative before the first call */
+		float LastRefillTime;
+
+		/** start of the window drops are counted in */
+		float DropWindowStart;
+
+		int32 DropsInWindow;
+
+		/** last call was dropped */
+		bool bDropped;
+
+		FBucket()
+			: Tokens(0.0f)
+			, LastRefillTime(-1.0f)
+			, DropWindowStart(0.0f)
+			, DropsInWindow(0)
+			, bDropped(false)
+		{
+		}
+	};
+
+	/** spend token for call, false if the client should be kicked */
+	bool Consume(EShooterServerRpc::Type Rpc, const struct FShooterRpcLimit& Limit, float RealTimeSeconds);
+
+	FBucket Buckets[EShooterServerRpc::MAX];
+};
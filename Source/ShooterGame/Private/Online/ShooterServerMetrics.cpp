@@ -0,0 +1,337 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Online/ShooterServerMetrics.h"
+#include "Sockets.h"
+#include "SocketSubsystem.h"
+
+FShooterServerMetrics* FShooterServerMetrics::ActiveMetrics = NULL;
+
+/** names in the rpc label */
+static const TCHAR* RpcNames[EShooterServerRpc::MAX] =
+{
+	TEXT("ServerNotifyHit"),
+	TEXT("ServerNotifyMiss"),
+	TEXT("ServerSetGravityMode"),
+	TEXT("ServerSetFullControlRotation"),
+	TEXT("ServerHandleFiring"),
+};
+
+/** how often connection rates are copied, the engine updates them once per second too */
+static const double ConnectionSampleInterval = 1.0;
+
+/** how long a client gets to send its request before the report is sent anyway */
+static const float ClientRequestTimeoutSeconds = 0.1f;
+
+FShooterServerMetrics::FShooterServerMetrics()
+	: GCStartCycles(0)
+	, LastConnectionSampleTime(0.0)
+	, ListenSocket(NULL)
+	, Thread(NULL)
+{
+	FMemory::Memzero(GameThreadTimes, sizeof(GameThreadTimes));
+	FMemory::Memzero(FrameIntervals, sizeof(FrameIntervals));
+}
+
+FShooterServerMetrics::~FShooterServerMetrics()
+{
+	if (Thread != NULL)
+	{
+		Stop();
+		Thread->WaitForCompletion();
+		delete Thread;
+		Thread = NULL;
+	}
+
+	if (ListenSocket != NULL)
+	{
+		ListenSocket->Close();
+		ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(ListenSocket);
+		ListenSocket = NULL;
+	}
+
+	FCoreUObjectDelegates::PreGarbageCollect.RemoveAll(this);
+	FCoreUObjectDelegates::PostGarbageCollect.RemoveAll(this);
+
+	if (ActiveMetrics == this)
+	{
+		ActiveMetrics = NULL;
+	}
+}
+
+bool FShooterServerMetrics::Listen(int32 Port)
+{
+	if (ListenSocket != NULL || !FPlatformProcess::SupportsMultithreading())
+	{
+		return false;
+	}
+
+	ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+	if (SocketSubsystem == NULL)
+	{
+		return false;
+	}
+
+	// loopback only, scrapers run next to the server
+	TSharedRef<FInternetAddr> Address = SocketSubsystem->CreateInternetAddr();
+	Address->SetIp(0x7f000001);
+	Address->SetPort(Port);
+
+	ListenSocket = SocketSubsystem->CreateSocket(NAME_Stream, TEXT("ShooterServerMetrics"), false);
+	if (ListenSocket == NULL)
+	{
+		return false;
+	}
+
+	ListenSocket->SetReuseAddr(true);
+	if (!ListenSocket->Bind(*Address) || !ListenSocket->Listen(8))
+	{
+		UE_LOG(LogShooter, Warning, TEXT("Server metrics: could not listen on 127.0.0.1:%d"), Port);
+		SocketSubsystem->DestroySocket(ListenSocket);
+		ListenSocket = NULL;
+		return false;
+	}
+
+	FCoreUObjectDelegates::PreGarbageCollect.AddRaw(this, &FShooterServerMetrics::HandlePreGarbageCollect);
+	FCoreUObjectDelegates::PostGarbageCollect.AddRaw(this, &FShooterServerMetrics::HandlePostGarbageCollect);
+	ActiveMetrics = this;
+
+	Thread = FRunnableThread::Create(this, TEXT("ShooterServerMetrics"), 0, TPri_BelowNormal);
+
+	UE_LOG(LogShooter, Log, TEXT("Server metrics served on 127.0.0.1:%d"), Port);
+	return true;
+}
+
+void FShooterServerMetrics::Tick(AGameMode* GameMode)
+{
+	if (ListenSocket == NULL || GameMode == NULL)
+	{
+		return;
+	}
+
+	// game thread work of the last finished frame, and undilated time between frames which includes waiting for the next server tick
+	const int32 FrameIndex = NumFrameTimes.GetValue();
+	GameThreadTimes[FrameIndex % MaxFrameTimes] = (float)FPlatformTime::ToSeconds(GGameThreadTime);
+	FrameIntervals[FrameIndex % MaxFrameTimes] = (float)FApp::GetDeltaTime();
+	FPlatformMisc::MemoryBarrier();
+	NumFrameTimes.Increment();
+
+	NumPlayers.Set(GameMode->NumPlayers);
+	NumBots.Set(GameMode->NumBots);
+
+	const double Now = FPlatformTime::Seconds();
+	if (Now - LastConnectionSampleTime >= ConnectionSampleInterval)
+	{
+		LastConnectionSampleTime = Now;
+		SampleConnections(GameMode->GetWorld()->GetNetDriver());
+	}
+}
+
+void FShooterServerMetrics::SampleConnections(UNetDriver* NetDriver)
+{
+	int32 NumSampled = 0;
+	if (NetDriver != NULL)
+	{
+		for (int32 i = 0; i < NetDriver->ClientConnections.Num() && NumSampled < MaxConnections; i++)
+		{
+			UNetConnection* Connection = NetDriver->ClientConnections[i];
+			if (Connection == NULL)
+			{
+				continue;
+			}
+
+			const APlayerState* PlayerState = Connection->PlayerController ? Connection->PlayerController->PlayerState : NULL;
+
+			FConnectionSample& Sample = Connections[NumSampled++];
+			Sample.PlayerId.Set(PlayerState ? PlayerState->PlayerId : -1);
+			Sample.InBytesPerSecond.Set(Connection->InBytesPerSecond);
+			Sample.OutBytesPerSecond.Set(Connection->OutBytesPerSecond);
+		}
+	}
+
+	// publish after the entries, readers never look past the count
+	FPlatformMisc::MemoryBarrier();
+	NumConnections.Set(NumSampled);
+}
+
+void FShooterServerMetrics::CountRpc(EShooterServerRpc::Type Rpc)
+{
+	if (ActiveMetrics != NULL)
+	{
+		ActiveMetrics->RpcCounts[Rpc].Increment();
+	}
+}
+
+void FShooterServerMetrics::CountDroppedRpc(EShooterServerRpc::Type Rpc)
+{
+	if (ActiveMetrics != NULL)
+	{
+		ActiveMetrics->DroppedRpcCounts[Rpc].Increment();
+	}
+}
+
+void FShooterServerMetrics::HandlePreGarbageCollect()
+{
+	GCStartCycles = FPlatformTime::Cycles();
+}
+
+void FShooterServerMetrics::HandlePostGarbageCollect()
+{
+	if (GCStartCycles != 0)
+	{
+		const int32 PauseMicroseconds = FMath::TruncToInt(FPlatformTime::ToMilliseconds(FPlatformTime::Cycles() - GCStartCycles) * 1000.0f);
+		GCStartCycles = 0;
+
+		NumGarbageCollections.Increment();
+		GCPauseMicroseconds.Add(PauseMicroseconds);
+
+		// only the game thread writes the maximum
+		if (PauseMicroseconds > MaxGCPauseMicroseconds.GetValue())
+		{
+			MaxGCPauseMicroseconds.Set(PauseMicroseconds);
+		}
+	}
+}
+
+uint32 FShooterServerMetrics::Run()
+{
+	while (StopRequested.GetValue() == 0)
+	{
+		bool bHasPendingConnection = false;
+		if (ListenSocket->WaitForPendingConnection(bHasPendingConnection, FTimespan::FromMilliseconds(100)) && bHasPendingConnection)
+		{
+			FSocket* Client = ListenSocket->Accept(TEXT("ShooterServerMetricsClient"));
+			if (Client != NULL)
+			{
+				ServeClient(Client);
+			}
+		}
+	}
+	return 0;
+}
+
+void FShooterServerMetrics::Stop()
+{
+	StopRequested.Increment();
+}
+
+void FShooterServerMetrics::ServeClient(FSocket* Client)
+{
+	// any request gets the report, http clients get it with a header
+	bool bHttp = false;
+	if (Client->Wait(ESocketWaitConditions::WaitForRead, FTimespan::FromSeconds(ClientRequestTimeoutSeconds)))
+	{
+		uint8 Request[1024];
+		int32 BytesRead = 0;
+		if (Client->Recv(Request, sizeof(Request), BytesRead) && BytesRead >= 4)
+		{
+			bHttp = FMemory::Memcmp(Request, "GET ", 4) == 0;
+		}
+	}
+
+	FTCHARToUTF8 Report(*BuildReport());
+
+	FString Header;
+	if (bHttp)
+	{
+		Header = FString::Printf(TEXT("HTTP/1.0 200 OK\r\nContent-Type: text/plain; version=0.0.4\r\nContent-Length: %d\r\nConnection: close\r\n\r\n"), Report.Length());
+	}
+	FTCHARToUTF8 HeaderUTF8(*Header);
+
+	TArray<uint8> Response;
+	Response.Append((const uint8*)HeaderUTF8.Get(), HeaderUTF8.Length());
+	Response.Append((const uint8*)Report.Get(), Report.Length());
+
+	int32 Offset = 0;
+	while (Offset < Response.Num())
+	{
+		int32 BytesSent = 0;
+		if (!Client->Send(Response.GetData() + Offset, Response.Num() - Offset, BytesSent) || BytesSent <= 0)
+		{
+			break;
+		}
+		Offset += BytesSent;
+	}
+
+	Client->Close();
+	ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(Client);
+}
+
+void FShooterServerMetrics::AppendFrameSummary(FString& Report, const TCHAR* Name, const TCHAR* Help, const float* Samples, int32 TotalFrames) const
+{
+	// samples may be overwritten while they are copied, which only blurs the percentiles a little
+	const int32 NumSamples = FMath::Min(TotalFrames, (int32)MaxFrameTimes);
+	TArray<float> SortedSamples;
+	SortedSamples.Append(Samples, NumSamples);
+	SortedSamples.Sort();
+
+	Report += FString::Printf(TEXT("# HELP %s %s\n"), Name, Help);
+	Report += FString::Printf(TEXT("# TYPE %s summary\n"), Name);
+	const float Quantiles[] = { 0.5f, 0.95f, 0.99f };
+	for (int32 i = 0; i < (int32)ARRAY_COUNT(Quantiles); i++)
+	{
+		float Value = 0.0f;
+		if (NumSamples > 0)
+		{
+			const int32 Index = FMath::Clamp(FMath::CeilToInt(Quantiles[i] * NumSamples) - 1, 0, NumSamples - 1);
+			Value = SortedSamples[Index];
+		}
+		Report += FString::Printf(TEXT("%s{quantile=\"%g\"} %f\n"), Name, Quantiles[i], Value);
+	}
+	Report += FString::Printf(TEXT("%s_count %d\n"), Name, TotalFrames);
+}
+
+FString FShooterServerMetrics::BuildReport() const
+{
+	FString Report;
+
+	const int32 TotalFrames = NumFrameTimes.GetValue();
+	FPlatformMisc::MemoryBarrier();
+	AppendFrameSummary(Report, TEXT("shooter_game_thread_seconds"), TEXT("Game thread work per server frame, without waiting for the next tick."), GameThreadTimes, TotalFrames);
+	AppendFrameSummary(Report, TEXT("shooter_frame_interval_seconds"), TEXT("Wall time between server frames, including waiting for the next tick."), FrameIntervals, TotalFrames);
+
+	Report += TEXT("# HELP shooter_players Connected human players.\n");
+	Report += TEXT("# TYPE shooter_players gauge\n");
+	Report += FString::Printf(TEXT("shooter_players %d\n"), NumPlayers.GetValue());
+	Report += TEXT("# HELP shooter_bots Bots in the match.\n");
+	Report += TEXT("# TYPE shooter_bots gauge\n");
+	Report += FString::Printf(TEXT("shooter_bots %d\n"), NumBots.GetValue());
+
+	const int32 ConnectionCount = FMath::Min(NumConnections.GetValue(), (int32)MaxConnections);
+	FPlatformMisc::MemoryBarrier();
+	Report += TEXT("# HELP shooter_connection_in_bytes_per_second Bytes received from a client connection.\n");
+	Report += TEXT("# TYPE shooter_connection_in_bytes_per_second gauge\n");
+	for (int32 i = 0; i < ConnectionCount; i++)
+	{
+		Report += FString::Printf(TEXT("shooter_connection_in_bytes_per_second{connection=\"%d\",player_id=\"%d\"} %d\n"), i, Connections[i].PlayerId.GetValue(), Connections[i].InBytesPerSecond.GetValue());
+	}
+	Report += TEXT("# HELP shooter_connection_out_bytes_per_second Bytes replicated to a client connection.\n");
+	Report += TEXT("# TYPE shooter_connection_out_bytes_per_second gauge\n");
+	for (int32 i = 0; i < ConnectionCount; i++)
+	{
+		Report += FString::Printf(TEXT("shooter_connection_out_bytes_per_second{connection=\"%d\",player_id=\"%d\"} %d\n"), i, Connections[i].PlayerId.GetValue(), Connections[i].OutBytesPerSecond.GetValue());
+	}
+
+	Report += TEXT("# HELP shooter_rpcs_total Server RPCs received.\n");
+	Report += TEXT("# TYPE shooter_rpcs_total counter\n");
+	for (int32 Rpc = 0; Rpc < EShooterServerRpc::MAX; Rpc++)
+	{
+		Report += FString::Printf(TEXT("shooter_rpcs_total{rpc=\"%s\"} %lld\n"), RpcNames[Rpc], RpcCounts[Rpc].GetValue());
+	}
+	Report += TEXT("# HELP shooter_rpcs_dropped_total Server RPCs ignored for being over their rate limit.\n");
+	Report += TEXT("# TYPE shooter_rpcs_dropped_total counter\n");
+	for (int32 Rpc = 0; Rpc < EShooterServerRpc::MAX; Rpc++)
+	{
+		Report += FString::Printf(TEXT("shooter_rpcs_dropped_total{rpc=\"%s\"} %lld\n"), RpcNames[Rpc], DroppedRpcCounts[Rpc].GetValue());
+	}
+
+	Report += TEXT("# HELP shooter_gc_pause_seconds Garbage collection pauses of the game thread.\n");
+	Report += TEXT("# TYPE shooter_gc_pause_seconds summary\n");
+	Report += FString::Printf(TEXT("shooter_gc_pause_seconds_sum %f\n"), GCPauseMicroseconds.GetValue() / 1000000.0);
+	Report += FString::Printf(TEXT("shooter_gc_pause_seconds_count %lld\n"), NumGarbageCollections.GetValue());
+	Report += TEXT("# HELP shooter_gc_pause_max_seconds Longest garbage collection pause.\n");
+	Report += TEXT("# TYPE shooter_gc_pause_max_seconds gauge\n");
+	Report += FString::Printf(TEXT("shooter_gc_pause_max_seconds %f\n"), MaxGCPauseMicroseconds.GetValue() / 1000000.0);
+
+	return Report;
+}
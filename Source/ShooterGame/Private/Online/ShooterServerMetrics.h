@@ -0,0 +1,136 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+/**
+ * Serves live metrics of a dedicated server in the Prometheus text format on a loopback TCP port,
+ * enabled with MetricsPort in the game mode config or -MetricsPort=<port> on the command line:
+ *
+ *   curl http://127.0.0.1:9100/metrics
+ *
+ * The game thread only stores samples and bumps atomic counters, it never waits on a client.
+ * Percentiles and text are built on the worker thread when a client connects, from whatever the game thread wrote last.
+ */
+class FShooterServerMetrics : public FRunnable
+{
+public:
+
+	FShooterServerMetrics();
+	virtual ~FShooterServerMetrics();
+
+	/** start listening on loopback port, false if the socket could not be bound */
+	bool Listen(int32 Port);
+
+	/** sample frame times, counts and connections, call every frame */
+	void Tick(class AGameMode* GameMode);
+
+	/** count RPC received by the server, does nothing when no metrics are served */
+	static void CountRpc(EShooterServerRpc::Type Rpc);
+
+	/** count RPC ignored for being over its rate limit, does nothing when no metrics are served */
+	static void CountDroppedRpc(EShooterServerRpc::Type Rpc);
+
+	// Begin FRunnable interface
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+	// End FRunnable interface
+
+private:
+
+	/** frame times kept for percentiles */
+	enum { MaxFrameTimes = 1024 };
+
+	/** connections reported at most */
+	enum { MaxConnections = 64 };
+
+	/** replication rates of one client connection */
+	struct FConnectionSample
+	{
+		FThreadSafeCounter PlayerId;
+		FThreadSafeCounter InBytesPerSecond;
+		FThreadSafeCounter OutBytesPerSecond;
+	};
+
+	/** ever growing total, FThreadSafeCounter would wrap around on a server that runs for weeks */
+	struct FCounter64
+	{
+		volatile int64 Value;
+
+		FCounter64()
+			: Value(0)
+		{
+		}
+
+		void Increment()
+		{
+			FPlatformAtomics::InterlockedIncrement(&Value);
+		}
+
+		void Add(int64 Amount)
+		{
+			FPlatformAtomics::InterlockedAdd(&Value, Amount);
+		}
+
+		/** aligned 64 bit reads don't tear on the 64 bit server platforms */
+		int64 GetValue() const
+		{
+			return Value;
+		}
+	};
+
+	void HandlePreGarbageCollect();
+	void HandlePostGarbageCollect();
+
+	/** copy rates of all client connections, game thread */
+	void SampleConnections(class UNetDriver* NetDriver);
+
+	/** answer one client and close it, worker */
+	void ServeClient(class FSocket* Client);
+
+	/** build exposition text, worker */
+	FString BuildReport() const;
+
+	/** append p50/p95/p99 summary of a frame time ring to report, worker */
+	void AppendFrameSummary(FString& Report, const TCHAR* Name, const TCHAR* Help, const float* Samples, int32 TotalFrames) const;
+
+	/** ring of game thread work per frame in seconds, without waiting for the next server tick, written by the game thread */
+	float GameThreadTimes[MaxFrameTimes];
+
+	/** ring of wall time between frames in seconds, including the wait, written by the game thread */
+	float FrameIntervals[MaxFrameTimes];
+
+	/** frames sampled so far, incremented after both rings are written */
+	FThreadSafeCounter NumFrameTimes;
+
+	FThreadSafeCounter NumPlayers;
+	FThreadSafeCounter NumBots;
+
+	/** rates of client connections, refreshed once per second */
+	FConnectionSample Connections[MaxConnections];
+
+	/** valid entries in Connections, set after they are written */
+	FThreadSafeCounter NumConnections;
+
+	FCounter64 RpcCounts[EShooterServerRpc::MAX];
+	FCounter64 DroppedRpcCounts[EShooterServerRpc::MAX];
+
+	FCounter64 NumGarbageCollections;
+
+	/** total and longest GC pause, in microseconds */
+	FCounter64 GCPauseMicroseconds;
+	FThreadSafeCounter MaxGCPauseMicroseconds;
+
+	/** game thread: start of GC in progress */
+	uint32 GCStartCycles;
+
+	/** game thread: time since connections were sampled */
+	double LastConnectionSampleTime;
+
+	class FSocket* ListenSocket;
+
+	FRunnableThread* Thread;
+	FThreadSafeCounter StopRequested;
+
+	/** metrics being served, for counting RPCs */
+	static FShooterServerMetrics* ActiveMetrics;
+};
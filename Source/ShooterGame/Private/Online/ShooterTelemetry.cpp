@@ -0,0 +1,548 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Online/ShooterTelemetry.h"
+#include "Online/ShooterMatchEvents.h"
+
+DECLARE_CYCLE_STAT(TEXT("Telemetry sampling"), STAT_ShooterTelemetrySample, STATGROUP_ShooterGame);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Telemetry frames dropped"), STAT_ShooterTelemetryDropped, STATGROUP_ShooterGame);
+
+/** first bytes of telemetry files */
+static const uint32 TelemetryMagic = 0x4D544753;
+
+/** bump when the encoding changes */
+static const int32 TelemetryVersion = 1;
+
+/** frames the game thread may queue before new ones are dropped, about 4 seconds at 60Hz */
+static const int32 MaxQueuedFrames = 256;
+
+/** events kept for the next frame at most, more are dropped */
+static const int32 MaxFrameEvents = 1024;
+
+/** uncompressed size at which a block is written */
+static const int32 BlockSize = 64 * 1024;
+
+static void WriteVarUInt(TArray<uint8>& Out, uint32 Value)
+{
+	while (Value >= 0x80)
+	{
+		Out.Add((uint8)(Value | 0x80));
+		Value >>= 7;
+	}
+	Out.Add((uint8)Value);
+}
+
+static void WriteVarInt(TArray<uint8>& Out, int32 Value)
+{
+	// zigzag, so small negative deltas stay small too
+	WriteVarUInt(Out, ((uint32)Value << 1) ^ (uint32)(Value >> 31));
+}
+
+static bool ReadVarUInt(const TArray<uint8>& In, int32& Offset, uint32& OutValue)
+{
+	OutValue = 0;
+	for (int32 Shift = 0; Shift < 35; Shift += 7)
+	{
+		if (Offset >= In.Num())
+		{
+			return false;
+		}
+
+		const uint8 Byte = In[Offset++];
+		OutValue |= (uint32)(Byte & 0x7f) << Shift;
+		if ((Byte & 0x80) == 0)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+static bool ReadVarInt(const TArray<uint8>& In, int32& Offset, int32& OutValue)
+{
+	uint32 Value = 0;
+	if (!ReadVarUInt(In, Offset, Value))
+	{
+		return false;
+	}
+	OutValue = (int32)(Value >> 1) ^ -(int32)(Value & 1);
+	return true;
+}
+
+static bool ReadByte(const TArray<uint8>& In, int32& Offset, uint8& OutValue)
+{
+	if (Offset >= In.Num())
+	{
+		return false;
+	}
+	OutValue = In[Offset++];
+	return true;
+}
+
+void FShooterTelemetryRecorder::FFrameQueue::Reset()
+{
+	Frames.Reset();
+	Pawns.Reset();
+	Events.Reset();
+}
+
+FShooterTelemetryRecorder::FShooterTelemetryRecorder()
+	: bCloseRequested(false)
+	, bRecording(false)
+	, StartTime(-1.0f)
+	, File(NULL)
+	, PreviousTimeMs(0)
+	, WorkEvent(NULL)
+	, Thread(NULL)
+{
+	if (FPlatformProcess::SupportsMultithreading())
+	{
+		WorkEvent = FPlatformProcess::CreateSynchEvent();
+		Thread = FRunnableThread::Create(this, TEXT("ShooterTelemetryRecorder"), 0, TPri_BelowNormal);
+	}
+}
+
+FShooterTelemetryRecorder::~FShooterTelemetryRecorder()
+{
+	if (Thread != NULL)
+	{
+		Stop();
+		Thread->WaitForCompletion();
+		delete Thread;
+		Thread = NULL;
+	}
+
+	if (WorkEvent != NULL)
+	{
+		delete WorkEvent;
+		WorkEvent = NULL;
+	}
+
+	CloseFile();
+}
+
+void FShooterTelemetryRecorder::Subscribe(FShooterMatchEventBus& Bus)
+{
+	Bus.OnEvent(EShooterMatchEvent::Kill).AddRaw(this, &FShooterTelemetryRecorder::HandleEvent);
+	Bus.OnEvent(EShooterMatchEvent::Shot).AddRaw(this, &FShooterTelemetryRecorder::HandleEvent);
+	Bus.OnEvent(EShooterMatchEvent::Hit).AddRaw(this, &FShooterTelemetryRecorder::HandleEvent);
+	Bus.OnEvent(EShooterMatchEvent::GravityFlip).AddRaw(this, &FShooterTelemetryRecorder::HandleEvent);
+}
+
+void FShooterTelemetryRecorder::BeginRecording(const FString& Path)
+{
+	if (Thread == NULL)
+	{
+		return;
+	}
+
+	{
+		FScopeLock ScopeLock(&Lock);
+		PendingPath = Path;
+	}
+
+	// clock starts with the first frame
+	bRecording = true;
+	StartTime = -1.0f;
+	FrameEvents.Reset();
+	WorkEvent->Trigger();
+}
+
+void FShooterTelemetryRecorder::EndRecording()
+{
+	if (Thread == NULL)
+	{
+		return;
+	}
+
+	{
+		FScopeLock ScopeLock(&Lock);
+		bCloseRequested = true;
+	}
+
+	bRecording = false;
+	WorkEvent->Trigger();
+}
+
+int32 FShooterTelemetryRecorder::GetNumDroppedFrames() const
+{
+	return NumDroppedFrames.GetValue();
+}
+
+void FShooterTelemetryRecorder::HandleEvent(const FShooterMatchEvent& Event)
+{
+	if (!bRecording || FrameEvents.Num() >= MaxFrameEvents)
+	{
+		return;
+	}
+
+	FShooterTelemetryEvent& TelemetryEvent = FrameEvents[FrameEvents.AddDefaulted()];
+	TelemetryEvent.Type = (uint8)Event.Type;
+	TelemetryEvent.PlayerId = Event.PlayerState.IsValid() ? Event.PlayerState->PlayerId : -1;
+	TelemetryEvent.OtherPlayerId = Event.OtherPlayerState.IsValid() ? Event.OtherPlayerState->PlayerId : -1;
+	TelemetryEvent.Value = Event.Value;
+}
+
+void FShooterTelemetryRecorder::RecordFrame(UWorld* World)
+{
+	if (!bRecording)
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_ShooterTelemetrySample);
+
+	if (StartTime < 0.0f)
+	{
+		StartTime = World->GetTimeSeconds();
+	}
+
+	const uint32 TimeMs = (uint32)FMath::Max(0, FMath::RoundToInt((World->GetTimeSeconds() - StartTime) * 1000.0f));
+
+	FScopeLock ScopeLock(&Lock);
+	if (GameQueue.Frames.Num() >= MaxQueuedFrames)
+	{
+		// worker is behind, never wait for it; events stay for the next frame
+		NumDroppedFrames.Increment();
+		SET_DWORD_STAT(STAT_ShooterTelemetryDropped, NumDroppedFrames.GetValue());
+		return;
+	}
+
+	FQueuedFrame& Frame = GameQueue.Frames[GameQueue.Frames.AddUninitialized()];
+	Frame.TimeMs = TimeMs;
+	Frame.NumPawns = 0;
+	Frame.NumEvents = FrameEvents.Num();
+
+	for (FConstPawnIterator It = World->GetPawnIterator(); It; ++It)
+	{
+		AShooterCharacter* Pawn = Cast<AShooterCharacter>(*It);
+		if (Pawn == NULL || Pawn->PlayerState == NULL)
+		{
+			continue;
+		}
+
+		const FVector Location = Pawn->GetActorLocation();
+		const FRotator ViewRotation = Pawn->GetViewRotation();
+
+		FShooterTelemetryPawnSample& Sample = GameQueue.Pawns[GameQueue.Pawns.AddUninitialized()];
+		Sample.PlayerId = Pawn->PlayerState->PlayerId;
+		Sample.X = FMath::RoundToInt(Location.X);
+		Sample.Y = FMath::RoundToInt(Location.Y);
+		Sample.Z = FMath::RoundToInt(Location.Z);
+		Sample.Yaw = FRotator::CompressAxisToShort(ViewRotation.Yaw);
+		Sample.Pitch = FRotator::CompressAxisToShort(ViewRotation.Pitch);
+		Sample.GravityMode = Pawn->GravityMode;
+		Sample.Health = (uint8)FMath::Clamp(FMath::RoundToInt(Pawn->Health), 0, 255);
+		Frame.NumPawns++;
+	}
+
+	GameQueue.Events.Append(FrameEvents);
+	FrameEvents.Reset();
+}
+
+void FShooterTelemetryRecorder::OpenFile(const FString& Path)
+{
+	CloseFile();
+
+	File = IFileManager::Get().CreateFileWriter(*Path);
+	if (File == NULL)
+	{
+		UE_LOG(LogShooter, Warning, TEXT("Failed to open telemetry file %s"), *Path);
+		return;
+	}
+
+	uint32 Magic = TelemetryMagic;
+	int32 Version = TelemetryVersion;
+	*File << Magic;
+	*File << Version;
+
+	Block.Reset();
+	PreviousPawns.Reset();
+	PreviousTimeMs = 0;
+}
+
+void FShooterTelemetryRecorder::CloseFile()
+{
+	if (File != NULL)
+	{
+		FlushBlock();
+		File->Close();
+		delete File;
+		File = NULL;
+	}
+}
+
+void FShooterTelemetryRecorder::EncodeFrames(const FFrameQueue& Queue)
+{
+	if (File == NULL)
+	{
+		return;
+	}
+
+	int32 PawnIndex = 0;
+	int32 EventIndex = 0;
+	for (int32 FrameIndex = 0; FrameIndex < Queue.Frames.Num(); FrameIndex++)
+	{
+		const FQueuedFrame& Frame = Queue.Frames[FrameIndex];
+
+		WriteVarUInt(Block, Frame.TimeMs - PreviousTimeMs);
+		PreviousTimeMs = Frame.TimeMs;
+
+		WriteVarUInt(Block, Frame.NumPawns);
+		for (int32 i = 0; i < Frame.NumPawns; i++)
+		{
+			const FShooterTelemetryPawnSample& Sample = Queue.Pawns[PawnIndex++];
+
+			// players seen before in this block are stored as deltas, the reader tracks the same set
+			FShooterTelemetryPawnSample Previous;
+			const FShooterTelemetryPawnSample* Found = PreviousPawns.Find(Sample.PlayerId);
+			if (Found)
+			{
+				Previous = *Found;
+			}
+
+			WriteVarInt(Block, Sample.PlayerId);
+			WriteVarInt(Block, Sample.X - Previous.X);
+			WriteVarInt(Block, Sample.Y - Previous.Y);
+			WriteVarInt(Block, Sample.Z - Previous.Z);
+			WriteVarInt(Block, (int16)(Sample.Yaw - Previous.Yaw));
+			WriteVarInt(Block, (int16)(Sample.Pitch - Previous.Pitch));
+			Block.Add(Sample.GravityMode);
+			Block.Add(Sample.Health);
+
+			PreviousPawns.Add(Sample.PlayerId, Sample);
+		}
+
+		WriteVarUInt(Block, Frame.NumEvents);
+		for (int32 i = 0; i < Frame.NumEvents; i++)
+		{
+			const FShooterTelemetryEvent& Event = Queue.Events[EventIndex++];
+			Block.Add(Event.Type);
+			WriteVarInt(Block, Event.PlayerId);
+			WriteVarInt(Block, Event.OtherPlayerId);
+			WriteVarInt(Block, Event.Value);
+		}
+
+		if (Block.Num() >= BlockSize)
+		{
+			FlushBlock();
+		}
+	}
+}
+
+void FShooterTelemetryRecorder::FlushBlock()
+{
+	if (File == NULL || Block.Num() == 0)
+	{
+		return;
+	}
+
+	int32 CompressedSize = FCompression::CompressMemoryBound(COMPRESS_ZLIB, Block.Num());
+	CompressedBlock.SetNumUninitialized(CompressedSize);
+	if (!FCompression::CompressMemory(COMPRESS_ZLIB, CompressedBlock.GetData(), CompressedSize, Block.GetData(), Block.Num()))
+	{
+		UE_LOG(LogShooter, Warning, TEXT("Failed to compress telemetry block"));
+		CompressedSize = 0;
+	}
+
+	if (CompressedSize > 0)
+	{
+		int32 UncompressedSize = Block.Num();
+		*File << UncompressedSize;
+		*File << CompressedSize;
+		File->Serialize(CompressedBlock.GetData(), CompressedSize);
+	}
+
+	// next block starts over, so it can be decoded on its own
+	Block.Reset();
+	PreviousPawns.Reset();
+	PreviousTimeMs = 0;
+}
+
+uint32 FShooterTelemetryRecorder::Run()
+{
+	for (;;)
+	{
+		const bool bStopping = StopRequested.GetValue() != 0;
+
+		FString PathToOpen;
+		bool bClose = false;
+		{
+			FScopeLock ScopeLock(&Lock);
+			Swap(GameQueue.Frames, WorkerQueue.Frames);
+			Swap(GameQueue.Pawns, WorkerQueue.Pawns);
+			Swap(GameQueue.Events, WorkerQueue.Events);
+			PathToOpen = PendingPath;
+			PendingPath.Empty();
+			bClose = bCloseRequested;
+			bCloseRequested = false;
+		}
+
+		if (bClose)
+		{
+			// frames queued before EndRecording belong to the file being closed
+			EncodeFrames(WorkerQueue);
+			CloseFile();
+			if (PathToOpen.Len() > 0)
+			{
+				OpenFile(PathToOpen);
+			}
+		}
+		else
+		{
+			if (PathToOpen.Len() > 0)
+			{
+				OpenFile(PathToOpen);
+			}
+			EncodeFrames(WorkerQueue);
+		}
+		WorkerQueue.Reset();
+
+		if (bStopping)
+		{
+			break;
+		}
+		WorkEvent->Wait(100);
+	}
+
+	CloseFile();
+	return 0;
+}
+
+void FShooterTelemetryRecorder::Stop()
+{
+	StopRequested.Increment();
+	if (WorkEvent != NULL)
+	{
+		WorkEvent->Trigger();
+	}
+}
+
+FShooterTelemetryReader::FShooterTelemetryReader()
+	: File(NULL)
+	, BlockOffset(0)
+	, PreviousTimeMs(0)
+{
+}
+
+FShooterTelemetryReader::~FShooterTelemetryReader()
+{
+	delete File;
+}
+
+bool FShooterTelemetryReader::Open(const FString& Path)
+{
+	delete File;
+	File = IFileManager::Get().CreateFileReader(*Path);
+	Block.Reset();
+	BlockOffset = 0;
+	if (File == NULL)
+	{
+		return false;
+	}
+
+	uint32 Magic = 0;
+	int32 Version = 0;
+	*File << Magic;
+	*File << Version;
+	return !File->IsError() && Magic == TelemetryMagic && Version == TelemetryVersion;
+}
+
+bool FShooterTelemetryReader::ReadBlock()
+{
+	if (File == NULL || File->AtEnd())
+	{
+		return false;
+	}
+
+	int32 UncompressedSize = 0;
+	int32 CompressedSize = 0;
+	*File << UncompressedSize;
+	*File << CompressedSize;
+	if (File->IsError() || UncompressedSize <= 0 || CompressedSize <= 0 || File->Tell() + CompressedSize > File->TotalSize())
+	{
+		return false;
+	}
+
+	TArray<uint8> CompressedBlock;
+	CompressedBlock.SetNumUninitialized(CompressedSize);
+	File->Serialize(CompressedBlock.GetData(), CompressedSize);
+
+	Block.SetNumUninitialized(UncompressedSize);
+	if (!FCompression::UncompressMemory(COMPRESS_ZLIB, Block.GetData(), UncompressedSize, CompressedBlock.GetData(), CompressedSize))
+	{
+		return false;
+	}
+
+	BlockOffset = 0;
+	PreviousPawns.Reset();
+	PreviousTimeMs = 0;
+	return true;
+}
+
+bool FShooterTelemetryReader::ReadFrame(FShooterTelemetryFrame& OutFrame)
+{
+	if (BlockOffset >= Block.Num() && !ReadBlock())
+	{
+		return false;
+	}
+
+	OutFrame.Pawns.Reset();
+	OutFrame.Events.Reset();
+
+	uint32 TimeDelta = 0;
+	uint32 NumPawns = 0;
+	if (!ReadVarUInt(Block, BlockOffset, TimeDelta) || !ReadVarUInt(Block, BlockOffset, NumPawns))
+	{
+		return false;
+	}
+	PreviousTimeMs += TimeDelta;
+	OutFrame.TimeMs = PreviousTimeMs;
+
+	for (uint32 i = 0; i < NumPawns; i++)
+	{
+		FShooterTelemetryPawnSample& Sample = OutFrame.Pawns[OutFrame.Pawns.AddDefaulted()];
+		int32 DX = 0, DY = 0, DZ = 0, DYaw = 0, DPitch = 0;
+		if (!ReadVarInt(Block, BlockOffset, Sample.PlayerId)
+			|| !ReadVarInt(Block, BlockOffset, DX) || !ReadVarInt(Block, BlockOffset, DY) || !ReadVarInt(Block, BlockOffset, DZ)
+			|| !ReadVarInt(Block, BlockOffset, DYaw) || !ReadVarInt(Block, BlockOffset, DPitch)
+			|| !ReadByte(Block, BlockOffset, Sample.GravityMode) || !ReadByte(Block, BlockOffset, Sample.Health))
+		{
+			return false;
+		}
+
+		FShooterTelemetryPawnSample Previous;
+		const FShooterTelemetryPawnSample* Found = PreviousPawns.Find(Sample.PlayerId);
+		if (Found)
+		{
+			Previous = *Found;
+		}
+
+		Sample.X = Previous.X + DX;
+		Sample.Y = Previous.Y + DY;
+		Sample.Z = Previous.Z + DZ;
+		Sample.Yaw = (uint16)(Previous.Yaw + DYaw);
+		Sample.Pitch = (uint16)(Previous.Pitch + DPitch);
+		PreviousPawns.Add(Sample.PlayerId, Sample);
+	}
+
+	uint32 NumEvents = 0;
+	if (!ReadVarUInt(Block, BlockOffset, NumEvents))
+	{
+		return false;
+	}
+
+	for (uint32 i = 0; i < NumEvents; i++)
+	{
+		FShooterTelemetryEvent& Event = OutFrame.Events[OutFrame.Events.AddDefaulted()];
+		if (!ReadByte(Block, BlockOffset, Event.Type)
+			|| !ReadVarInt(Block, BlockOffset, Event.PlayerId)
+			|| !ReadVarInt(Block, BlockOffset, Event.OtherPlayerId)
+			|| !ReadVarInt(Block, BlockOffset, Event.Value))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
@@ -0,0 +1,223 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+/** one pawn in a telemetry frame */
+struct FShooterTelemetryPawnSample
+{
+	int32 PlayerId;
+
+	/** location, in whole unreal units */
+	int32 X;
+	int32 Y;
+	int32 Z;
+
+	/** view yaw and pitch, FRotator::CompressAxisToShort */
+	uint16 Yaw;
+	uint16 Pitch;
+
+	/** SBGravityMode */
+	uint8 GravityMode;
+
+	uint8 Health;
+
+	FShooterTelemetryPawnSample()
+		: PlayerId(0)
+		, X(0)
+		, Y(0)
+		, Z(0)
+		, Yaw(0)
+		, Pitch(0)
+		, GravityMode(0)
+		, Health(0)
+	{
+	}
+};
+
+/** match event in a telemetry frame */
+struct FShooterTelemetryEvent
+{
+	/** EShooterMatchEvent */
+	uint8 Type;
+	int32 PlayerId;
+
+	/** other player involved, -1 if none */
+	int32 OtherPlayerId;
+	int32 Value;
+
+	FShooterTelemetryEvent()
+		: Type(0)
+		, PlayerId(0)
+		, OtherPlayerId(-1)
+		, Value(0)
+	{
+	}
+};
+
+/** everything recorded at one sample time */
+struct FShooterTelemetryFrame
+{
+	/** milliseconds since recording started */
+	uint32 TimeMs;
+
+	TArray<FShooterTelemetryPawnSample> Pawns;
+
+	/** events since previous frame */
+	TArray<FShooterTelemetryEvent> Events;
+
+	FShooterTelemetryFrame()
+		: TimeMs(0)
+	{
+	}
+};
+
+/**
+ * Records pawns and match events of a dedicated server match to a file.
+ * The game thread only copies samples into a bounded buffer; delta encoding, compression and writing happen on a worker thread.
+ * When the worker falls behind, new frames are dropped instead of blocking the game.
+ *
+ * File layout: header, then independent blocks of [uncompressed size][compressed size][zlib data].
+ * The first frame of each block is stored absolute, the others as deltas to the previous frame of the block.
+ */
+class FShooterTelemetryRecorder : public FRunnable
+{
+public:
+
+	FShooterTelemetryRecorder();
+	virtual ~FShooterTelemetryRecorder();
+
+	/** start listening to events */
+	void Subscribe(class FShooterMatchEventBus& Bus);
+
+	/** start writing new file, closes previous one */
+	void BeginRecording(const FString& Path);
+
+	/** finish writing current file, the worker closes it once everything queued is written */
+	void EndRecording();
+
+	/** sample all pawns, cheap enough to call every tick */
+	void RecordFrame(class UWorld* World);
+
+	/** get number of frames dropped because the worker was behind */
+	int32 GetNumDroppedFrames() const;
+
+	// Begin FRunnable interface
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+	// End FRunnable interface
+
+private:
+
+	/** frame queued for the worker, pawns and events live in flat arrays */
+	struct FQueuedFrame
+	{
+		uint32 TimeMs;
+		int32 NumPawns;
+		int32 NumEvents;
+	};
+
+	/** frames, pawns and events waiting for the worker */
+	struct FFrameQueue
+	{
+		TArray<FQueuedFrame> Frames;
+		TArray<FShooterTelemetryPawnSample> Pawns;
+		TArray<FShooterTelemetryEvent> Events;
+
+		void Reset();
+	};
+
+	/** keep event for next frame */
+	void HandleEvent(const struct FShooterMatchEvent& Event);
+
+	/** encode frames and write full blocks, on the worker */
+	void EncodeFrames(const FFrameQueue& Queue);
+
+	/** compress and write current block, on the worker */
+	void FlushBlock();
+
+	/** open file, on the worker */
+	void OpenFile(const FString& Path);
+
+	/** flush and close file, on the worker */
+	void CloseFile();
+
+	/** filled by the game thread */
+	FFrameQueue GameQueue;
+
+	/** events since last frame, game thread only */
+	TArray<FShooterTelemetryEvent> FrameEvents;
+
+	/** swapped with GameQueue by the worker */
+	FFrameQueue WorkerQueue;
+
+	/** file to open next, set by BeginRecording */
+	FString PendingPath;
+
+	/** set by EndRecording */
+	bool bCloseRequested;
+
+	/** guards GameQueue, PendingPath and bCloseRequested */
+	FCriticalSection Lock;
+
+	/** game thread: between BeginRecording and EndRecording */
+	bool bRecording;
+
+	/** game thread: world time of first frame, negative until then */
+	float StartTime;
+
+	/** frames dropped because GameQueue was full */
+	FThreadSafeCounter NumDroppedFrames;
+
+	/** worker: file being written */
+	FArchive* File;
+
+	/** worker: uncompressed block being built */
+	TArray<uint8> Block;
+
+	/** worker: compression scratch */
+	TArray<uint8> CompressedBlock;
+
+	/** worker: previous sample of each player in the current block */
+	TMap<int32, FShooterTelemetryPawnSample> PreviousPawns;
+
+	/** worker: time of previous frame in the current block */
+	uint32 PreviousTimeMs;
+
+	FEvent* WorkEvent;
+	FRunnableThread* Thread;
+	FThreadSafeCounter StopRequested;
+};
+
+/** reads telemetry files written by FShooterTelemetryRecorder, for offline analysis */
+class FShooterTelemetryReader
+{
+public:
+
+	FShooterTelemetryReader();
+	~FShooterTelemetryReader();
+
+	/** open file, false if it is not a telemetry file */
+	bool Open(const FString& Path);
+
+	/** read next frame, false at end of file */
+	bool ReadFrame(FShooterTelemetryFrame& OutFrame);
+
+private:
+
+	/** read and decompress next block, false at end of file */
+	bool ReadBlock();
+
+	FArchive* File;
+
+	/** decompressed block being read */
+	TArray<uint8> Block;
+
+	/** read position in Block */
+	int32 BlockOffset;
+
+	/** previous sample of each player in the current block */
+	TMap<int32, FShooterTelemetryPawnSample> PreviousPawns;
+
+	/** time of previous frame in the current block */
+	uint32 PreviousTimeMs;
+};
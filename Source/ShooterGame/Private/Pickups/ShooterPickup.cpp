@@ -2,6 +2,7 @@
 
 #include "ShooterGame.h"
 #include "Particles/ParticleSystemComponent.h"
+#include "Online/ShooterMatchEvents.h"
 
 AShooterPickup::AShooterPickup(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
@@ -64,6 +65,14 @@ void AShooterPickup::PickupOnTouch(class AShooterCharacter* Pawn)
 			GivePickupTo(Pawn);
 			PickedUpBy = Pawn;
 
+			AShooterGameMode* GameMode = GetWorld()->GetAuthGameMode<AShooterGameMode>();
+			AShooterPlayerState* PlayerState = Cast<AShooterPlayerState>(Pawn->PlayerState);
+			if (GameMode && PlayerState)
+			{
+				FShooterMatchEvent PickupEvent(EShooterMatchEvent::Pickup, PlayerState);
+				GameMode->BroadcastMatchEvent(PickupEvent);
+			}
+
 			if (!IsPendingKill())
 			{
 				bIsActive = false;
@@ -1,6 +1,7 @@
 // Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
 
 #include "ShooterGame.h"
+#include "Online/ShooterRpcLimiter.h"
 
 AShooterCharacter::AShooterCharacter(const FObjectInitializer& ObjectInitializer) 
 	: Super(ObjectInitializer.SetDefaultSubobjectClass<UShooterCharacterMovement>(ACharacter::CharacterMovementComponentName))
@@ -50,6 +51,7 @@ AShooterCharacter::AShooterCharacter(const FObjectInitializer& ObjectInitializer
 
 	GravityDirection = FVector(0.f, 0.f, -1.0f);
 	GravityMode = GRAVITY_ZNEGATIVE;
+	bGravityFrameCached = false;
 
 	IsBot = false;
 }
@@ -380,6 +382,11 @@ float AShooterCharacter::TakeDamage(float Damage, struct FDamageEvent const& Dam
 	if (ActualDamage > 0.f)
 	{
 		Health -= ActualDamage;
+		if (Game)
+		{
+			Game->NotifyPawnDamaged(this, ActualDamage);
+		}
+
 		if (Health <= 0)
 		{
 			Die(ActualDamage, DamageEvent, EventInstigator, DamageCauser);
@@ -387,6 +394,12 @@ float AShooterCharacter::TakeDamage(float Damage, struct FDamageEvent const& Dam
 		else
 		{
 			PlayHit(ActualDamage, DamageEvent, EventInstigator ? EventInstigator->GetPawn() : NULL, DamageCauser);
+
+			AShooterAIController* AIController = Cast<AShooterAIController>(Controller);
+			if (AIController)
+			{
+				AIController->NotifyTookDamage();
+			}
 		}
 
 		MakeNoise(1.0f, EventInstigator ? EventInstigator->GetPawn() : this);
@@ -1700,6 +1713,74 @@ void AShooterCharacter::OnGravityForward(void)
 
 	}
 }
+FQuat AShooterCharacter::MakeGravityFrame(SBGravityMode Mode)
+{
+	// up is against gravity, forward is any axis perpendicular to it
+	FVector Up(0.f, 0.f, 1.f);
+	FVector Forward(1.f, 0.f, 0.f);
+	switch (Mode)
+	{
+	case GRAVITY_XNEGATIVE:
+		Up = FVector(1.f, 0.f, 0.f);
+		Forward = FVector(0.f, 1.f, 0.f);
+		break;
+	case GRAVITY_XPOSITIVE:
+		Up = FVector(-1.f, 0.f, 0.f);
+		Forward = FVector(0.f, 1.f, 0.f);
+		break;
+	case GRAVITY_YNEGATIVE:
+		Up = FVector(0.f, 1.f, 0.f);
+		break;
+	case GRAVITY_YPOSITIVE:
+		Up = FVector(0.f, -1.f, 0.f);
+		break;
+	case GRAVITY_ZPOSITIVE:
+		Up = FVector(0.f, 0.f, -1.f);
+		break;
+	default:
+		break;
+	}
+
+	return FRotationMatrix::MakeFromZX(Up, Forward).ToQuat();
+}
+
+SBGravityMode AShooterCharacter::GetGravityModeForUp(const FVector& Up)
+{
+	// snap to the axis up is closest to
+	const FVector AbsUp = Up.GetAbs();
+	if (AbsUp.X >= AbsUp.Y && AbsUp.X >= AbsUp.Z)
+	{
+		return Up.X > 0.f ? GRAVITY_XNEGATIVE : GRAVITY_XPOSITIVE;
+	}
+	if (AbsUp.Y >= AbsUp.Z)
+	{
+		return Up.Y > 0.f ? GRAVITY_YNEGATIVE : GRAVITY_YPOSITIVE;
+	}
+	return Up.Z >= 0.f ? GRAVITY_ZNEGATIVE : GRAVITY_ZPOSITIVE;
+}
+
+const FQuat& AShooterCharacter::GetGravityFrame() const
+{
+	if (!bGravityFrameCached || CachedGravityFrameMode != GravityMode)
+	{
+		CachedGravityFrame = MakeGravityFrame(GravityMode);
+		CachedGravityFrameMode = GravityMode;
+		bGravityFrameCached = true;
+	}
+
+	return CachedGravityFrame;
+}
+
+FVector AShooterCharacter::GetGravityUpVector() const
+{
+	return GetGravityFrame().GetAxisZ();
+}
+
+FVector AShooterCharacter::GetPawnViewLocation() const
+{
+	return GetActorLocation() + GetGravityUpVector() * BaseEyeHeight;
+}
+
 void AShooterCharacter::FaceRotation(FRotator NewControlRotation, float DeltaTime)
 {
 	if (Role == ROLE_SimulatedProxy) {
@@ -1769,9 +1850,12 @@ void AShooterCharacter::SetFullControlRotation(const FRotator& NewFullControlRot
 	}
 }
 bool AShooterCharacter::ServerSetFullControlRotation_Validate(const FRotator& NewFullControlRotation) {
-	return true;
+	return FShooterRpcLimiter::ValidateRpc(this, EShooterServerRpc::SetFullControlRotation);
 }
 
 void AShooterCharacter::ServerSetFullControlRotation_Implementation(const FRotator& NewFullControlRotation) {
+	if (FShooterRpcLimiter::IsRpcDropped(this, EShooterServerRpc::SetFullControlRotation)) {
+		return;
+	}
 	SetFullControlRotation(NewFullControlRotation);
 }
\ No newline at end of file
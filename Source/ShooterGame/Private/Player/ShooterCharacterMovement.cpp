@@ -1,6 +1,8 @@
 // Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
 
 #include "ShooterGame.h"
+#include "ShooterSoakTest.h"
+#include "ShooterNetTest.h"
 
 #include "GameFramework/CharacterMovementComponent.h"
 #include "Engine.h"
@@ -358,6 +360,7 @@ void UShooterCharacterMovement::PerformAirControl(FVector Direction, float ZDiff
 
 void UShooterCharacterMovement::TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction *ThisTickFunction)
 {
+	FShooterSoakScope SoakScope(EShooterSoakSubsystem::Movement);
 
 
 
@@ -391,6 +394,7 @@ void UShooterCharacterMovement::TickComponent(float DeltaTime, enum ELevelTick T
 		if (bIsClient)
 		{
 			ClientUpdatePositionAfterServerUpdate();
+			FShooterNetTest::NotifyClientMovementUpdated(CharacterOwner);
 		}
 
 		// Allow root motion to move characters that have no controller.
@@ -877,7 +881,7 @@ void UShooterCharacterMovement::UpdateBasedRotation(FRotator &FinalRotation, con
 }
 void UShooterCharacterMovement::PerformMovement(float DeltaSeconds)
 {
-	//SCOPE_CYCLE_COUNTER(STAT_CharacterMovementAuthority);
+	SCOPE_CYCLE_COUNTER(STAT_ShooterPerformMovement);
 
 	if (!HasValidData())
 	{
@@ -1109,6 +1113,7 @@ void UShooterCharacterMovement::Crouch(bool bClientSimulation)
 			default:break;
 			}
 
+			INC_DWORD_STAT(STAT_ShooterMovementTraces);
 			const bool bEncroached = GetWorld()->OverlapTest(CharacterOwner->GetActorLocation() + offsetVector, FQuat::Identity,
 				UpdatedComponent->GetCollisionObjectType(), GetPawnCapsuleCollisionShape(SHRINK_None), CapsuleParams, ResponseParam);
 
@@ -1135,6 +1140,7 @@ void UShooterCharacterMovement::Crouch(bool bClientSimulation)
 			case GRAVITY_ZPOSITIVE:offsetVector = FVector(0.f, 0.f, ScaledHalfHeightAdjust); break;
 			default:break;
 			}
+			INC_DWORD_STAT(STAT_ShooterMovementTraces);
 			UpdatedComponent->MoveComponent(offsetVector, CharacterOwner->GetActorRotation(), true);
 		}
 
@@ -1199,6 +1205,7 @@ void UShooterCharacterMovement::UnCrouch(bool bClientSimulation)
 		bool bEncroached = true;
 		if (!IsMovingOnGround())
 		{
+			INC_DWORD_STAT(STAT_ShooterMovementTraces);
 			bEncroached = GetWorld()->OverlapTest(PawnLocation, FQuat::Identity, CollisionChannel, StandingCapsuleShape, CapsuleParams, ResponseParam);
 		}
 
@@ -1228,6 +1235,7 @@ void UShooterCharacterMovement::UnCrouch(bool bClientSimulation)
 
 				FHitResult Hit(1.f);
 				const FCollisionShape ShortCapsuleShape = GetPawnCapsuleCollisionShape(SHRINK_HeightCustom, ShrinkHalfHeight);
+				INC_DWORD_STAT(STAT_ShooterMovementTraces);
 				const bool bBlockingHit = GetWorld()->SweepSingle(Hit, PawnLocation, PawnLocation + Down, FQuat::Identity, CollisionChannel, ShortCapsuleShape, CapsuleParams);
 				if (Hit.bStartPenetrating)
 				{
@@ -1249,6 +1257,7 @@ void UShooterCharacterMovement::UnCrouch(bool bClientSimulation)
 					case GRAVITY_ZPOSITIVE:NewLoc = FVector(PawnLocation.X, PawnLocation.Y, PawnLocation.Z + DistanceToBase - PawnHalfHeight - SweepInflation - MIN_FLOOR_DIST / 2.f); break;
 					default:break;
 					}
+					INC_DWORD_STAT(STAT_ShooterMovementTraces);
 					bEncroached = GetWorld()->OverlapTest(NewLoc, FQuat::Identity, CollisionChannel, StandingCapsuleShape, CapsuleParams);
 					if (!bEncroached)
 					{
@@ -2213,6 +2222,7 @@ void UShooterCharacterMovement::PhysFlying(float deltaTime, int32 Iterations)
 	FVector OldLocation = CharacterOwner->GetActorLocation();
 	const FVector Adjusted = Velocity * deltaTime;
 	FHitResult Hit(1.f);
+	INC_DWORD_STAT(STAT_ShooterMovementTraces);
 	SafeMoveUpdatedComponent(Adjusted, CharacterOwner->GetActorRotation(), true, Hit);
 
 	if (Hit.Time < 1.f && CharacterOwner)
@@ -2397,6 +2407,7 @@ void UShooterCharacterMovement::PhysFalling(float deltaTime, int32 Iterations)
 				const FVector PawnLocation = CharacterOwner->GetActorLocation();
 				const ECollisionChannel CollisionChannel = UpdatedComponent->GetCollisionObjectType();
 				FQuat CapsuleRotation = GetCharacterOwner()->GetCapsuleComponent()->GetComponentRotation().Quaternion();
+				INC_DWORD_STAT(STAT_ShooterMovementTraces);
 				const bool bHit = GetWorld()->SweepSingle(Result, PawnLocation, PawnLocation + TestWalk, CapsuleRotation, CollisionChannel, GetPawnCapsuleCollisionShape(SHRINK_None), CapsuleQuery, ResponseParam);
 				if (bHit)
 				{
@@ -2503,6 +2514,7 @@ void UShooterCharacterMovement::PhysFalling(float deltaTime, int32 Iterations)
 		}
 
 		FVector Adjusted = 0.5f*(OldVelocity + Velocity) * timeTick;
+		INC_DWORD_STAT(STAT_ShooterMovementTraces);
 		SafeMoveUpdatedComponent(Adjusted, PawnRotation, true, Hit);
 
 		if (!CharacterOwner || CharacterOwner->IsPendingKill())
@@ -2547,6 +2559,7 @@ void UShooterCharacterMovement::PhysFalling(float deltaTime, int32 Iterations)
 
 				if ((Delta | Adjusted) > 0.f)
 				{
+					INC_DWORD_STAT(STAT_ShooterMovementTraces);
 					SafeMoveUpdatedComponent(Delta, PawnRotation, true, Hit);
 					if (Hit.Time < 1.f) //hit second wall
 					{
@@ -2569,6 +2582,7 @@ void UShooterCharacterMovement::PhysFalling(float deltaTime, int32 Iterations)
 
 						// bDitch=true means that pawn is straddling two slopes, neither of which he can stand on
 						bool bDitch = ((OldHitImpactNormal.Z > 0.f) && (Hit.ImpactNormal.Z > 0.f) && (FMath::Abs(Delta.Z) <= KINDA_SMALL_NUMBER) && ((Hit.ImpactNormal | OldHitImpactNormal) < 0.f));
+						INC_DWORD_STAT(STAT_ShooterMovementTraces);
 						SafeMoveUpdatedComponent(Delta, PawnRotation, true, Hit);
 						if (Hit.Time == 0)
 						{
@@ -2578,6 +2592,7 @@ void UShooterCharacterMovement::PhysFalling(float deltaTime, int32 Iterations)
 							{
 								SideDelta = FVector(OldHitNormal.Y, -OldHitNormal.X, 0).SafeNormal();
 							}
+							INC_DWORD_STAT(STAT_ShooterMovementTraces);
 							SafeMoveUpdatedComponent(SideDelta, PawnRotation, true, Hit);
 						}
 						if (bDitch) {
@@ -2602,6 +2617,7 @@ void UShooterCharacterMovement::PhysFalling(float deltaTime, int32 Iterations)
 								Velocity.Y += 0.25f * GetMaxSpeed() * (FMath::FRand() - 0.5f);
 								Velocity.Z = FMath::Max<float>(JumpZVelocity * 0.25f, 1.f);
 								Delta = Velocity * timeTick;
+								INC_DWORD_STAT(STAT_ShooterMovementTraces);
 								SafeMoveUpdatedComponent(Delta, PawnRotation, true, Hit);
 							}
 						}
@@ -2858,6 +2874,7 @@ void UShooterCharacterMovement::MoveAlongFloor(const FVector& InVelocity, const
 
 	FHitResult Hit(1.f);
 	FVector RampVector = ComputeGroundMovementDelta(Delta, CurrentFloor.HitResult, CurrentFloor.bLineTrace);
+	INC_DWORD_STAT(STAT_ShooterMovementTraces);
 	SafeMoveUpdatedComponent(RampVector, CharacterOwner->GetActorRotation(), true, Hit);
 	if (Hit.bStartPenetrating)
 	{
@@ -2885,6 +2902,7 @@ void UShooterCharacterMovement::MoveAlongFloor(const FVector& InVelocity, const
 		{
 			const float PreSlideTimeRemaining = 1.f - Hit.Time;
 			RampVector = ComputeGroundMovementDelta(Delta * PreSlideTimeRemaining, Hit, false);
+			INC_DWORD_STAT(STAT_ShooterMovementTraces);
 			SafeMoveUpdatedComponent(RampVector, CharacterOwner->GetActorRotation(), true, Hit);
 
 			const float SecondHitPercent = Hit.Time * (1.f - TimeApplied);
@@ -2988,6 +3006,8 @@ void UShooterCharacterMovement::MaintainHorizontalGroundVelocity()
 
 void UShooterCharacterMovement::PhysWalking(float deltaTime, int32 Iterations)
 {
+	SCOPE_CYCLE_COUNTER(STAT_ShooterPhysWalking);
+
 	if (deltaTime < MIN_TICK_TIME)
 	{
 		return;
@@ -3500,6 +3520,7 @@ void UShooterCharacterMovement::AdjustFloorHeight()
 		case GRAVITY_ZNEGATIVE: MoveVector = FVector(0.f, 0.f, MoveDist); break;
 		case GRAVITY_ZPOSITIVE: MoveVector = FVector(0.f, 0.f, -MoveDist); break;
 		}
+		INC_DWORD_STAT(STAT_ShooterMovementTraces);
 		SafeMoveUpdatedComponent(MoveVector, CharacterOwner->GetActorRotation(), true, AdjustHit);
 		UE_LOG(LogCharacterMovement, VeryVerbose, TEXT("Adjust floor height %.3f (Hit = %d)"), MoveDist, AdjustHit.bBlockingHit);
 
@@ -3694,6 +3715,7 @@ bool UShooterCharacterMovement::CheckWaterJump(FVector CheckPoint, FVector& Wall
 	FCollisionShape CapsuleShape = GetPawnCapsuleCollisionShape(SHRINK_None);
 	const ECollisionChannel CollisionChannel = UpdatedComponent->GetCollisionObjectType();
 	FQuat CapsuleRotation = GetCharacterOwner()->GetCapsuleComponent()->GetComponentRotation().Quaternion();
+	INC_DWORD_STAT(STAT_ShooterMovementTraces);
 	bool bHit = GetWorld()->SweepSingle(HitInfo, CharacterOwner->GetActorLocation(), CheckPoint, CapsuleRotation, CollisionChannel, CapsuleShape, CapsuleParams, ResponseParam);
 
 	if (HitInfo.GetActor() && !Cast<APawn>(HitInfo.GetActor()))
@@ -3706,6 +3728,7 @@ bool UShooterCharacterMovement::CheckWaterJump(FVector CheckPoint, FVector& Wall
 		FCollisionQueryParams LineParams(CheckWaterJumpName, true, CharacterOwner);
 		FCollisionResponseParams LineResponseParam;
 		InitCollisionParams(LineParams, LineResponseParam);
+		INC_DWORD_STAT(STAT_ShooterMovementTraces);
 		bHit = GetWorld()->LineTraceSingle(HitInfo, Start, CheckPoint, CollisionChannel, LineParams, LineResponseParam);
 		// if no high obstruction, or it's a valid floor, then pawn can jump out of water
 		return !bHit || IsWalkable(HitInfo);
@@ -3734,6 +3757,7 @@ void UShooterCharacterMovement::MoveSmooth(const FVector& InVelocity, const floa
 	else
 	{
 		FHitResult Hit(1.f);
+		INC_DWORD_STAT(STAT_ShooterMovementTraces);
 		SafeMoveUpdatedComponent(Delta, CharacterOwner->GetActorRotation(), true, Hit);
 
 		if (Hit.IsValidBlockingHit())
@@ -3880,6 +3904,8 @@ bool UShooterCharacterMovement::IsWalkable(const FHitResult& Hit) const
 
 void UShooterCharacterMovement::ComputeFloorDist(const FVector& CapsuleLocation, float LineDistance, float SweepDistance, FFindFloorResult& OutFloorResult, float SweepRadius, const FHitResult* DownwardSweepResult) const
 {
+	SCOPE_CYCLE_COUNTER(STAT_ShooterComputeFloorDist);
+
 	OutFloorResult.Clear();
 
 	// No collision, no floor...
@@ -4010,6 +4036,7 @@ void UShooterCharacterMovement::ComputeFloorDist(const FVector& CapsuleLocation,
 
 		FHitResult Hit(1.f);
 		FQuat CapsuleRotation = GetCharacterOwner()->GetCapsuleComponent()->GetComponentRotation().Quaternion();
+		INC_DWORD_STAT(STAT_ShooterMovementTraces);
 		bBlockingHit = GetWorld()->SweepSingle(Hit, CapsuleLocation, CapsuleLocation + TraceVector, CapsuleRotation, CollisionChannel, CapsuleShape, QueryParams, ResponseParam);
 
 		if (bBlockingHit)
@@ -4024,6 +4051,7 @@ void UShooterCharacterMovement::ComputeFloorDist(const FVector& CapsuleLocation,
 				CapsuleShape.Capsule.Radius = FMath::Max(0.f, CapsuleShape.Capsule.Radius - SWEEP_EDGE_REJECT_DISTANCE - KINDA_SMALL_NUMBER);
 				CapsuleShape.Capsule.HalfHeight = FMath::Max(PawnHalfHeight - ShrinkHeight, 0.1f);
 				FQuat CapsuleRotation = GetCharacterOwner()->GetCapsuleComponent()->GetComponentRotation().Quaternion();
+				INC_DWORD_STAT(STAT_ShooterMovementTraces);
 				bBlockingHit = GetWorld()->SweepSingle(Hit, CapsuleLocation, CapsuleLocation + TraceVector, CapsuleRotation, CollisionChannel, CapsuleShape, QueryParams, ResponseParam);
 			}
 
@@ -4073,6 +4101,7 @@ void UShooterCharacterMovement::ComputeFloorDist(const FVector& CapsuleLocation,
 		QueryParams.TraceTag = FloorLineTraceName;
 
 		FHitResult Hit(1.f);
+		INC_DWORD_STAT(STAT_ShooterMovementTraces);
 		bBlockingHit = GetWorld()->LineTraceSingle(Hit, LineTraceStart, LineTraceStart + Down, CollisionChannel, QueryParams, ResponseParam);
 
 		if (bBlockingHit)
@@ -4379,10 +4408,12 @@ bool UShooterCharacterMovement::StepUp(const FVector& GravDir, const FVector& De
 	// step up - treat as vertical wall
 	FHitResult SweepUpHit(1.f);
 	const FRotator PawnRotation = CharacterOwner->GetActorRotation();
+	INC_DWORD_STAT(STAT_ShooterMovementTraces);
 	SafeMoveUpdatedComponent(-GravDir * StepTravelHeight, PawnRotation, true, SweepUpHit);
 
 	// step fwd
 	FHitResult Hit(1.f);
+	INC_DWORD_STAT(STAT_ShooterMovementTraces);
 	SafeMoveUpdatedComponent(Delta, PawnRotation, true, Hit);
 
 	// If we hit something above us and also something ahead of us, we should notify about the upward hit as well.
@@ -4420,6 +4451,7 @@ bool UShooterCharacterMovement::StepUp(const FVector& GravDir, const FVector& De
 	}
 
 	// Step down
+	INC_DWORD_STAT(STAT_ShooterMovementTraces);
 	SafeMoveUpdatedComponent(GravDir * (MaxStepHeight + MAX_FLOOR_DIST*2.f), CharacterOwner->GetActorRotation(), true, Hit);
 
 	// If step down was initially penetrating abort the step up
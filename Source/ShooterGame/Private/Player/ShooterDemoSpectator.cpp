@@ -2,9 +2,15 @@
 
 #include "ShooterGame.h"
 #include "UI/Menu/ShooterDemoPlaybackMenu.h"
+#include "Online/ShooterReplayIndex.h"
+#include "Engine/DemoNetDriver.h"
 
 AShooterDemoSpectator::AShooterDemoSpectator(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
+	bFollowEvents = true;
+	EventLeadTime = 3.0f;
+	PlaybackStartTime = 0.0f;
+	LastFollowedEventTime = -1.0f;
 }
 
 void AShooterDemoSpectator::SetupInputComponent()
@@ -22,6 +28,83 @@ void AShooterDemoSpectator::SetPlayer( UPlayer* InPlayer )
 	// Build menu only after game is initialized
 	ShooterDemoPlaybackMenu = MakeShareable( new FShooterDemoPlaybackMenu() );
 	ShooterDemoPlaybackMenu->Construct( Cast< ULocalPlayer >( Player ) );
+
+	UDemoNetDriver* const DemoDriver = GetWorld()->DemoNetDriver;
+	DemoName = DemoDriver ? FPaths::GetBaseFilename( DemoDriver->DemoFilename ) : FString();
+	PlaybackStartTime = GetWorld()->GetTimeSeconds();
+
+	ReplayIndex = MakeShareable( new FShooterReplayIndex() );
+	ReplayIndex->Load( DemoName );
+}
+
+void AShooterDemoSpectator::PlayerTick( float DeltaTime )
+{
+	Super::PlayerTick( DeltaTime );
+
+	if ( !bFollowEvents || !ReplayIndex.IsValid() )
+	{
+		return;
+	}
+
+	// several events may come up in one frame, look at the player of the latest
+	const float DemoTime = GetDemoTime();
+	const FShooterReplayEvent* Upcoming = NULL;
+	for ( const FShooterReplayEvent* Event = ReplayIndex->FindNextEvent( LastFollowedEventTime ); Event && Event->Time - EventLeadTime <= DemoTime; Event = ReplayIndex->FindNextEvent( Event->Time ) )
+	{
+		Upcoming = Event;
+	}
+
+	if ( Upcoming )
+	{
+		LastFollowedEventTime = Upcoming->Time;
+		LookAtPlayer( Upcoming->PlayerName, DemoTime );
+	}
+}
+
+float AShooterDemoSpectator::GetDemoTime() const
+{
+	return GetWorld()->GetTimeSeconds() - PlaybackStartTime;
+}
+
+void AShooterDemoSpectator::DemoFollowEvents( bool bEnable )
+{
+	bFollowEvents = bEnable;
+
+	// don't catch up on events that passed while not following
+	LastFollowedEventTime = GetDemoTime();
+}
+
+bool AShooterDemoSpectator::IsFollowingEvents() const
+{
+	return bFollowEvents;
+}
+
+void AShooterDemoSpectator::LookAtPlayer( const FString& PlayerName, float Time )
+{
+	if ( PlayerName.Len() == 0 )
+	{
+		return;
+	}
+
+	for ( FConstPawnIterator It = GetWorld()->GetPawnIterator(); It; ++It )
+	{
+		APawn* Pawn = *It;
+		if ( Pawn && Pawn->PlayerState && Pawn->PlayerState->PlayerName == PlayerName )
+		{
+			SetViewTarget( Pawn );
+			return;
+		}
+	}
+
+	// player has no pawn right now, look from where the last keyframe had them
+	const FShooterReplayKeyframe* Keyframe = ReplayIndex.IsValid() ? ReplayIndex->FindKeyframe( Time ) : NULL;
+	const FShooterReplayPawnState* State = Keyframe ? Keyframe->FindPawn( PlayerName ) : NULL;
+	if ( State && GetSpectatorPawn() )
+	{
+		GetSpectatorPawn()->SetActorLocation( State->Location );
+		SetControlRotation( State->Rotation );
+		SetViewTarget( GetSpectatorPawn() );
+	}
 }
 
 void AShooterDemoSpectator::OnToggleInGameMenu()
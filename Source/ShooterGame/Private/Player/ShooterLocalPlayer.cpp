@@ -68,7 +68,12 @@ void UShooterLocalPlayer::SetControllerId(int32 NewControllerId)
 
 FString UShooterLocalPlayer::GetNickname() const
 {
-	FString UserNickName = Super::GetNickname();
+	return GetNicknameFor(Super::GetNickname(), ControllerId);
+}
+
+FString UShooterLocalPlayer::GetNicknameFor(const FString& OnlineNickname, int32 InControllerId) const
+{
+	FString UserNickName = OnlineNickname;
 
 	if ( UserNickName.Len() > MAX_PLAYER_NAME_LENGTH )
 	{
@@ -107,7 +112,7 @@ FString UShooterLocalPlayer::GetNickname() const
 
 	if ( bReplace )
 	{
-		UserNickName = FString::Printf( TEXT( "Player%i" ), ControllerId + 1 );
+		UserNickName = FString::Printf( TEXT( "Player%i" ), InControllerId + 1 );
 	}	
 
 	return UserNickName;
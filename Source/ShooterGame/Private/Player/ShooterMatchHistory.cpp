@@ -0,0 +1,390 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Player/ShooterMatchHistory.h"
+
+/** first bytes of every history file */
+static const uint32 MatchHistoryMagic = 0x48484753;
+
+/** bump when fields are added, records and header have spare room for that */
+static const int32 MatchHistoryVersion = 1;
+
+/** bytes used by header, at the start of the file */
+static const int32 HeaderSize = 256;
+
+/** bytes used by each record */
+static const int32 RecordSize = 128;
+
+/** bytes reserved for map and game mode names, including terminator */
+static const int32 NameSize = 32;
+
+static void SerializeFixedName(FArchive& Ar, FString& Name)
+{
+	ANSICHAR Buffer[NameSize];
+	FMemory::Memzero(Buffer, sizeof(Buffer));
+	if (Ar.IsSaving())
+	{
+		FCStringAnsi::Strncpy(Buffer, TCHAR_TO_ANSI(*Name), NameSize);
+	}
+
+	Ar.Serialize(Buffer, NameSize);
+
+	if (Ar.IsLoading())
+	{
+		Buffer[NameSize - 1] = 0;
+		Name = ANSI_TO_TCHAR(Buffer);
+	}
+}
+
+static float GetAccuracy(int64 Hits, int64 Shots)
+{
+	return Shots > 0 ? FMath::Min(1.0f, (float)Hits / (float)Shots) : 0.0f;
+}
+
+FShooterMatchRecord::FShooterMatchRecord()
+	: EndTimeTicks(0)
+	, DurationSeconds(0.0f)
+	, Score(0)
+	, Kills(0)
+	, Deaths(0)
+	, BulletsFired(0)
+	, BulletsHit(0)
+	, RocketsFired(0)
+	, RocketsHit(0)
+	, GravityFlips(0)
+	, bWon(false)
+{
+}
+
+float FShooterMatchRecord::GetBulletAccuracy() const
+{
+	return GetAccuracy(BulletsHit, BulletsFired);
+}
+
+float FShooterMatchRecord::GetRocketAccuracy() const
+{
+	return GetAccuracy(RocketsHit, RocketsFired);
+}
+
+void FShooterMatchRecord::Serialize(FArchive& Ar)
+{
+	const int64 Start = Ar.Tell();
+
+	Ar << EndTimeTicks;
+	SerializeFixedName(Ar, MapName);
+	SerializeFixedName(Ar, GameMode);
+	Ar << DurationSeconds;
+	Ar << Score;
+	Ar << Kills;
+	Ar << Deaths;
+	Ar << BulletsFired;
+	Ar << BulletsHit;
+	Ar << RocketsFired;
+	Ar << RocketsHit;
+	Ar << GravityFlips;
+
+	uint8 bWonByte = bWon ? 1 : 0;
+	Ar << bWonByte;
+	bWon = bWonByte != 0;
+
+	// pad to fixed size, so records can be found by index
+	const int32 Used = (int32)(Ar.Tell() - Start);
+	check(Used <= RecordSize);
+	uint8 Padding[RecordSize];
+	FMemory::Memzero(Padding, sizeof(Padding));
+	Ar.Serialize(Padding, RecordSize - Used);
+}
+
+FShooterMatchHistorySummary::FShooterMatchHistorySummary()
+	: NumMatches(0)
+	, Wins(0)
+	, Kills(0)
+	, Deaths(0)
+	, BulletsFired(0)
+	, BulletsHit(0)
+	, RocketsFired(0)
+	, RocketsHit(0)
+	, GravityFlips(0)
+	, TotalDurationSeconds(0.0)
+{
+}
+
+void FShooterMatchHistorySummary::Add(const FShooterMatchRecord& Record)
+{
+	NumMatches++;
+	Wins += Record.bWon ? 1 : 0;
+	Kills += Record.Kills;
+	Deaths += Record.Deaths;
+	BulletsFired += Record.BulletsFired;
+	BulletsHit += Record.BulletsHit;
+	RocketsFired += Record.RocketsFired;
+	RocketsHit += Record.RocketsHit;
+	GravityFlips += Record.GravityFlips;
+	TotalDurationSeconds += Record.DurationSeconds;
+}
+
+float FShooterMatchHistorySummary::GetBulletAccuracy() const
+{
+	return GetAccuracy(BulletsHit, BulletsFired);
+}
+
+float FShooterMatchHistorySummary::GetRocketAccuracy() const
+{
+	return GetAccuracy(RocketsHit, RocketsFired);
+}
+
+void FShooterMatchHistorySummary::Serialize(FArchive& Ar)
+{
+	Ar << NumMatches;
+	Ar << Wins;
+	Ar << Kills;
+	Ar << Deaths;
+	Ar << BulletsFired;
+	Ar << BulletsHit;
+	Ar << RocketsFired;
+	Ar << RocketsHit;
+	Ar << GravityFlips;
+	Ar << TotalDurationSeconds;
+}
+
+FShooterMatchHistory::FHeader::FHeader()
+	: NumLogged(0)
+{
+}
+
+bool FShooterMatchHistory::FHeader::Serialize(FArchive& Ar)
+{
+	uint32 Magic = MatchHistoryMagic;
+	int32 Version = MatchHistoryVersion;
+	int32 StoredRecordSize = RecordSize;
+
+	Ar << Magic;
+	Ar << Version;
+	Ar << StoredRecordSize;
+	if (Ar.IsError() || Magic != MatchHistoryMagic || Version < 1 || Version > MatchHistoryVersion || StoredRecordSize != RecordSize)
+	{
+		return false;
+	}
+
+	Ar << NumLogged;
+	Summary.Serialize(Ar);
+
+	const int32 Used = (int32)Ar.Tell();
+	check(Used <= HeaderSize);
+	uint8 Padding[HeaderSize];
+	FMemory::Memzero(Padding, sizeof(Padding));
+	Ar.Serialize(Padding, HeaderSize - Used);
+
+	return !Ar.IsError();
+}
+
+FString FShooterMatchHistory::GetSummaryPath(const FString& SlotName)
+{
+	return FString::Printf(TEXT("%sSaveGames/%s.history"), *FPaths::GameSavedDir(), *SlotName);
+}
+
+FString FShooterMatchHistory::GetLogPath(const FString& SlotName)
+{
+	return FString::Printf(TEXT("%sSaveGames/%s.matches"), *FPaths::GameSavedDir(), *SlotName);
+}
+
+bool FShooterMatchHistory::LoadHeader(const FString& SlotName, FHeader& OutHeader)
+{
+	TArray<uint8> Bytes;
+	if (!FFileHelper::LoadFileToArray(Bytes, *GetSummaryPath(SlotName), FILEREAD_Silent))
+	{
+		// no summary yet, start from empty totals
+		OutHeader = FHeader();
+		return true;
+	}
+
+	FMemoryReader Ar(Bytes);
+	return Bytes.Num() >= HeaderSize && OutHeader.Serialize(Ar);
+}
+
+bool FShooterMatchHistory::SaveHeader(const FString& SlotName, const FHeader& Header)
+{
+	TArray<uint8> Bytes;
+	FMemoryWriter Ar(Bytes);
+	FHeader HeaderCopy = Header;
+	HeaderCopy.Serialize(Ar);
+
+	return ReplaceFile(Bytes, GetSummaryPath(SlotName));
+}
+
+bool FShooterMatchHistory::ReplaceFile(const TArray<uint8>& Bytes, const FString& Path)
+{
+	const FString TempPath = Path + TEXT(".tmp");
+	if (!FFileHelper::SaveArrayToFile(Bytes, *TempPath))
+	{
+		UE_LOG(LogShooter, Warning, TEXT("Failed to write match history %s"), *TempPath);
+		return false;
+	}
+
+	if (!IFileManager::Get().Move(*Path, *TempPath, true))
+	{
+		UE_LOG(LogShooter, Warning, TEXT("Failed to replace match history %s"), *Path);
+		IFileManager::Get().Delete(*TempPath, false, false, true);
+		return false;
+	}
+
+	return true;
+}
+
+bool FShooterMatchHistory::ReadLog(const FString& SlotName, int32 FirstRecord, int32 NumRecords, TArray<FShooterMatchRecord>& OutRecords)
+{
+	OutRecords.Reset();
+	if (NumRecords <= 0)
+	{
+		return true;
+	}
+
+	IFileHandle* Handle = FPlatformFileManager::Get().GetPlatformFile().OpenRead(*GetLogPath(SlotName));
+	if (Handle == NULL)
+	{
+		return false;
+	}
+
+	TArray<uint8> Bytes;
+	Bytes.SetNumUninitialized(NumRecords * RecordSize);
+	const bool bRead = Handle->Seek((int64)FirstRecord * RecordSize) && Handle->Read(Bytes.GetData(), Bytes.Num());
+	delete Handle;
+
+	if (!bRead)
+	{
+		return false;
+	}
+
+	FMemoryReader Ar(Bytes);
+	OutRecords.Reserve(NumRecords);
+	for (int32 i = 0; i < NumRecords; i++)
+	{
+		FShooterMatchRecord Record;
+		Record.Serialize(Ar);
+		if (Record.EndTimeTicks != 0)
+		{
+			OutRecords.Add(Record);
+		}
+	}
+
+	return true;
+}
+
+bool FShooterMatchHistory::CompactLog(const FString& SlotName, int32 NumRecords)
+{
+	TArray<uint8> Bytes;
+	Bytes.SetNumUninitialized(Capacity * RecordSize);
+
+	IFileHandle* Handle = FPlatformFileManager::Get().GetPlatformFile().OpenRead(*GetLogPath(SlotName));
+	if (Handle == NULL)
+	{
+		return false;
+	}
+
+	const bool bRead = Handle->Seek((int64)(NumRecords - Capacity) * RecordSize) && Handle->Read(Bytes.GetData(), Bytes.Num());
+	delete Handle;
+
+	return bRead && ReplaceFile(Bytes, GetLogPath(SlotName));
+}
+
+bool FShooterMatchHistory::Append(const FString& SlotName, const FShooterMatchRecord& Record)
+{
+	FHeader Header;
+	if (!LoadHeader(SlotName, Header))
+	{
+		// written by a newer build or damaged, leave it alone
+		UE_LOG(LogShooter, Warning, TEXT("Ignoring unreadable match history %s"), *GetSummaryPath(SlotName));
+		return false;
+	}
+
+	TArray<uint8> RecordBytes;
+	FMemoryWriter RecordWriter(RecordBytes);
+	FShooterMatchRecord RecordCopy = Record;
+	RecordCopy.Serialize(RecordWriter);
+
+	IFileHandle* Handle = FPlatformFileManager::Get().GetPlatformFile().OpenWrite(*GetLogPath(SlotName), true);
+	if (Handle == NULL)
+	{
+		UE_LOG(LogShooter, Warning, TEXT("Failed to open match history %s"), *GetLogPath(SlotName));
+		return false;
+	}
+
+	// an interrupted append leaves a partial record at the end, fill it up so the new one starts on a record boundary.
+	// the filled record has no end time and is skipped by readers.
+	const int64 PartialBytes = Handle->Size() % RecordSize;
+	if (PartialBytes > 0)
+	{
+		RecordBytes.InsertZeroed(0, RecordSize - PartialBytes);
+	}
+
+	const bool bWritten = Handle->Write(RecordBytes.GetData(), RecordBytes.Num());
+	const int32 NumRecords = (int32)(Handle->Size() / RecordSize);
+	delete Handle;
+
+	if (!bWritten)
+	{
+		UE_LOG(LogShooter, Warning, TEXT("Failed to append to match history %s"), *GetLogPath(SlotName));
+		return false;
+	}
+
+	// matches logged while a crash kept their summary from being saved are added to the totals now
+	Header.NumLogged = FMath::Min(Header.NumLogged, NumRecords - 1);
+	TArray<FShooterMatchRecord> Missed;
+	ReadLog(SlotName, Header.NumLogged, NumRecords - 1 - Header.NumLogged, Missed);
+	for (int32 i = 0; i < Missed.Num(); i++)
+	{
+		Header.Summary.Add(Missed[i]);
+	}
+
+	Header.Summary.Add(Record);
+	Header.NumLogged = NumRecords;
+
+	if (NumRecords > 2 * Capacity && CompactLog(SlotName, NumRecords))
+	{
+		Header.NumLogged = Capacity;
+	}
+
+	return SaveHeader(SlotName, Header);
+}
+
+bool FShooterMatchHistory::ReadSummary(const FString& SlotName, FShooterMatchHistorySummary& OutSummary)
+{
+	if (!FPaths::FileExists(GetSummaryPath(SlotName)))
+	{
+		return false;
+	}
+
+	FHeader Header;
+	if (!LoadHeader(SlotName, Header))
+	{
+		return false;
+	}
+
+	OutSummary = Header.Summary;
+	return true;
+}
+
+bool FShooterMatchHistory::ReadRecent(const FString& SlotName, int32 NumMatches, TArray<FShooterMatchRecord>& OutRecords)
+{
+	OutRecords.Reset();
+
+	const int64 LogSize = IFileManager::Get().FileSize(*GetLogPath(SlotName));
+	if (LogSize < 0)
+	{
+		return false;
+	}
+
+	const int32 NumRecords = (int32)(LogSize / RecordSize);
+	const int32 NumToRead = FMath::Clamp(NumMatches, 0, NumRecords);
+	if (!ReadLog(SlotName, NumRecords - NumToRead, NumToRead, OutRecords))
+	{
+		return false;
+	}
+
+	// the log is oldest first
+	for (int32 i = 0, j = OutRecords.Num() - 1; i < j; i++, j--)
+	{
+		OutRecords.Swap(i, j);
+	}
+	return true;
+}
@@ -0,0 +1,127 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+/** one finished match, as stored in the history file */
+struct FShooterMatchRecord
+{
+	/** when the match ended, UTC FDateTime ticks */
+	int64 EndTimeTicks;
+
+	/** map the match was played on */
+	FString MapName;
+
+	/** game mode class name */
+	FString GameMode;
+
+	/** time spent in the match (seconds) */
+	float DurationSeconds;
+
+	int32 Score;
+	int32 Kills;
+	int32 Deaths;
+	int32 BulletsFired;
+	int32 BulletsHit;
+	int32 RocketsFired;
+	int32 RocketsHit;
+	int32 GravityFlips;
+	bool bWon;
+
+	FShooterMatchRecord();
+
+	/** fraction of bullets that hit a player */
+	float GetBulletAccuracy() const;
+
+	/** fraction of rockets that damaged something */
+	float GetRocketAccuracy() const;
+
+	/** read or write record, always uses RecordSize bytes */
+	void Serialize(FArchive& Ar);
+};
+
+/** totals over every match ever recorded */
+struct FShooterMatchHistorySummary
+{
+	int32 NumMatches;
+	int32 Wins;
+	int64 Kills;
+	int64 Deaths;
+	int64 BulletsFired;
+	int64 BulletsHit;
+	int64 RocketsFired;
+	int64 RocketsHit;
+	int64 GravityFlips;
+	double TotalDurationSeconds;
+
+	FShooterMatchHistorySummary();
+
+	/** add match to totals */
+	void Add(const FShooterMatchRecord& Record);
+
+	float GetBulletAccuracy() const;
+	float GetRocketAccuracy() const;
+
+	void Serialize(FArchive& Ar);
+};
+
+/**
+ * Per user history of finished matches, two files per slot.
+ * The match log holds fixed size records and only ever grows at the end, so adding a match is one small append.
+ * The summary file is a fixed header holding the lifetime totals and the number of logged records they cover,
+ * it is small enough to be replaced as a whole on each append. Reading totals costs one header read, and the last N
+ * matches are read in one go from the end of the log, however many matches were played.
+ * All functions block on the disk, keep them off the game thread.
+ */
+class FShooterMatchHistory
+{
+public:
+
+	/** number of matches kept in the log, older ones are dropped when it grows past twice that but stay in the totals */
+	static const int32 Capacity = 4096;
+
+	/** add match at the end of history and update totals, called from the storage worker */
+	static bool Append(const FString& SlotName, const FShooterMatchRecord& Record);
+
+	/** read lifetime totals, false if there is no history yet */
+	static bool ReadSummary(const FString& SlotName, FShooterMatchHistorySummary& OutSummary);
+
+	/** read up to NumMatches most recent matches, newest first */
+	static bool ReadRecent(const FString& SlotName, int32 NumMatches, TArray<FShooterMatchRecord>& OutRecords);
+
+private:
+
+	struct FHeader
+	{
+		/** number of records at the start of the match log already added to the totals */
+		int32 NumLogged;
+
+		/** totals over all appended matches */
+		FShooterMatchHistorySummary Summary;
+
+		FHeader();
+
+		/** read or write header, always uses HeaderSize bytes. Returns false if data is not a history header we understand. */
+		bool Serialize(FArchive& Ar);
+	};
+
+	/** get summary file used for slot */
+	static FString GetSummaryPath(const FString& SlotName);
+
+	/** get match log used for slot */
+	static FString GetLogPath(const FString& SlotName);
+
+	/** read header of slot, false if it exists but can't be used */
+	static bool LoadHeader(const FString& SlotName, FHeader& OutHeader);
+
+	/** replace summary file of slot */
+	static bool SaveHeader(const FString& SlotName, const FHeader& Header);
+
+	/** read NumRecords records of the match log starting at record FirstRecord, records left empty by an interrupted write are skipped */
+	static bool ReadLog(const FString& SlotName, int32 FirstRecord, int32 NumRecords, TArray<FShooterMatchRecord>& OutRecords);
+
+	/** rewrite match log keeping only its last Capacity records */
+	static bool CompactLog(const FString& SlotName, int32 NumRecords);
+
+	/** write file next to Path and move it over, so a crash never leaves a half written file */
+	static bool ReplaceFile(const TArray<uint8>& Bytes, const FString& Path);
+};
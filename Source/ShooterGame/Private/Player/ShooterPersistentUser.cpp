@@ -1,6 +1,7 @@
 // Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
 
 #include "ShooterGame.h"
+#include "Player/ShooterPersistentUserStorage.h"
 
 UShooterPersistentUser::UShooterPersistentUser(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
@@ -96,10 +97,45 @@ bool UShooterPersistentUser::IsInvertedYAxisDirty() const
 
 void UShooterPersistentUser::SavePersistentUser()
 {
-	UGameplayStatics::SaveGameToSlot(this, SlotName, UserIndex);
+	FShooterPersistentUserData Data;
+	WriteTo(Data);
+	FShooterPersistentUserStorage::Get().Save(SlotName, Data);
 	bIsDirty = false;
 }
 
+void UShooterPersistentUser::WriteTo(FShooterPersistentUserData& OutData) const
+{
+	OutData.Kills = Kills;
+	OutData.Deaths = Deaths;
+	OutData.Wins = Wins;
+	OutData.Losses = Losses;
+	OutData.BulletsFired = BulletsFired;
+	OutData.RocketsFired = RocketsFired;
+	OutData.BotsCount = BotsCount;
+	OutData.Gamma = Gamma;
+	OutData.AimSensitivity = AimSensitivity;
+	OutData.bInvertedYAxis = bInvertedYAxis;
+}
+
+void UShooterPersistentUser::ReadFrom(const FShooterPersistentUserData& Data)
+{
+	Kills = Data.Kills;
+	Deaths = Data.Deaths;
+	Wins = Data.Wins;
+	Losses = Data.Losses;
+	BulletsFired = Data.BulletsFired;
+	RocketsFired = Data.RocketsFired;
+	BotsCount = Data.BotsCount;
+	Gamma = Data.Gamma;
+	AimSensitivity = Data.AimSensitivity;
+	bInvertedYAxis = Data.bInvertedYAxis;
+}
+
+void UShooterPersistentUser::PrefetchPersistentUser(const FString& SlotName)
+{
+	FShooterPersistentUserStorage::Get().Prefetch(SlotName);
+}
+
 UShooterPersistentUser* UShooterPersistentUser::LoadPersistentUser(FString SlotName, const int32 UserIndex)
 {
 	UShooterPersistentUser* Result = nullptr;
@@ -108,11 +144,27 @@ UShooterPersistentUser* UShooterPersistentUser::LoadPersistentUser(FString SlotN
 	// Persistent users aren't valid in this state.
 	if (SlotName.Len() > 0)
 	{	
-		Result = Cast<UShooterPersistentUser>(UGameplayStatics::LoadGameFromSlot(SlotName, UserIndex));
-		if (Result == NULL)
+		FShooterPersistentUserData Data;
+		if (FShooterPersistentUserStorage::Get().Load(SlotName, Data))
 		{
-			// if failed to load, create a new one
 			Result = Cast<UShooterPersistentUser>( UGameplayStatics::CreateSaveGameObject(UShooterPersistentUser::StaticClass()) );
+			check(Result != NULL);
+			Result->ReadFrom(Data);
+		}
+		else
+		{
+			// no save in the current format, look for one written by SaveGameToSlot and move it over on next save
+			UE_LOG(LogShooter, Log, TEXT("No persistent user %s in the current format, trying legacy save game"), *SlotName);
+			Result = Cast<UShooterPersistentUser>(UGameplayStatics::LoadGameFromSlot(SlotName, UserIndex));
+			if (Result != NULL)
+			{
+				Result->bIsDirty = true;
+			}
+			else
+			{
+				// if failed to load, create a new one
+				Result = Cast<UShooterPersistentUser>( UGameplayStatics::CreateSaveGameObject(UShooterPersistentUser::StaticClass()) );
+			}
 		}
 		check(Result != NULL);
 	
@@ -150,6 +202,14 @@ void UShooterPersistentUser::AddMatchResult(int32 MatchKills, int32 MatchDeaths,
 	bIsDirty = true;
 }
 
+void UShooterPersistentUser::AddMatchRecord(const FShooterMatchRecord& Record)
+{
+	if (SlotName.Len() > 0)
+	{
+		FShooterPersistentUserStorage::Get().AppendMatch(SlotName, Record);
+	}
+}
+
 void UShooterPersistentUser::TellInputAboutKeybindings()
 {
 	TArray<APlayerController*> PlayerList;
@@ -0,0 +1,456 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "Player/ShooterPersistentUserStorage.h"
+
+/** first bytes of every persistent user file */
+static const uint32 PersistentUserMagic = 0x55504753;
+
+/** bump when fields are added, FromBytes must keep reading older versions */
+static const int32 PersistentUserVersion = 1;
+
+/** how long the game thread sleeps while waiting for the worker (seconds) */
+static const float WaitForWorkerInterval = 0.001f;
+
+FShooterPersistentUserStorage* FShooterPersistentUserStorage::Instance = NULL;
+
+static void SerializePacked(FArchive& Ar, int32& Value)
+{
+	// counters never go negative, packing keeps them at one or two bytes for most players
+	uint32 Packed = (uint32)FMath::Max(Value, 0);
+	Ar.SerializeIntPacked(Packed);
+	Value = (int32)Packed;
+}
+
+void FShooterPersistentUserData::ToBytes(TArray<uint8>& OutBytes) const
+{
+	OutBytes.Reset();
+	FMemoryWriter Ar(OutBytes);
+
+	uint32 Magic = PersistentUserMagic;
+	int32 Version = PersistentUserVersion;
+	Ar << Magic;
+	Ar << Version;
+
+	FShooterPersistentUserData Copy = *this;
+	SerializePacked(Ar, Copy.Kills);
+	SerializePacked(Ar, Copy.Deaths);
+	SerializePacked(Ar, Copy.Wins);
+	SerializePacked(Ar, Copy.Losses);
+	SerializePacked(Ar, Copy.BulletsFired);
+	SerializePacked(Ar, Copy.RocketsFired);
+	SerializePacked(Ar, Copy.BotsCount);
+	Ar << Copy.Gamma;
+	Ar << Copy.AimSensitivity;
+
+	uint8 bInverted = bInvertedYAxis ? 1 : 0;
+	Ar << bInverted;
+}
+
+bool FShooterPersistentUserData::FromBytes(const TArray<uint8>& Bytes)
+{
+	FMemoryReader Ar(Bytes);
+
+	uint32 Magic = 0;
+	int32 Version = 0;
+	Ar << Magic;
+	Ar << Version;
+	if (Ar.IsError() || Magic != PersistentUserMagic || Version < 1 || Version > PersistentUserVersion)
+	{
+		return false;
+	}
+
+	FShooterPersistentUserData Loaded;
+	SerializePacked(Ar, Loaded.Kills);
+	SerializePacked(Ar, Loaded.Deaths);
+	SerializePacked(Ar, Loaded.Wins);
+	SerializePacked(Ar, Loaded.Losses);
+	SerializePacked(Ar, Loaded.BulletsFired);
+	SerializePacked(Ar, Loaded.RocketsFired);
+	SerializePacked(Ar, Loaded.BotsCount);
+	Ar << Loaded.Gamma;
+	Ar << Loaded.AimSensitivity;
+
+	uint8 bInverted = 0;
+	Ar << bInverted;
+	Loaded.bInvertedYAxis = bInverted != 0;
+
+	if (Ar.IsError())
+	{
+		return false;
+	}
+
+	*this = Loaded;
+	return true;
+}
+
+FShooterPersistentUserStorage& FShooterPersistentUserStorage::Get()
+{
+	if (Instance == NULL)
+	{
+		Instance = new FShooterPersistentUserStorage();
+	}
+	return *Instance;
+}
+
+FShooterPersistentUserStorage* FShooterPersistentUserStorage::Find()
+{
+	return Instance;
+}
+
+void FShooterPersistentUserStorage::Shutdown()
+{
+	if (Instance != NULL)
+	{
+		Instance->Flush();
+		delete Instance;
+		Instance = NULL;
+	}
+}
+
+FShooterPersistentUserStorage::FShooterPersistentUserStorage()
+	: NumInProgress(0)
+	, WorkEvent(NULL)
+	, Thread(NULL)
+{
+	if (FPlatformProcess::SupportsMultithreading())
+	{
+		WorkEvent = FPlatformProcess::CreateSynchEvent();
+		Thread = FRunnableThread::Create(this, TEXT("ShooterPersistentUserStorage"), 0, TPri_BelowNormal);
+	}
+}
+
+FShooterPersistentUserStorage::~FShooterPersistentUserStorage()
+{
+	if (Thread != NULL)
+	{
+		Stop();
+		Thread->WaitForCompletion();
+		delete Thread;
+		Thread = NULL;
+	}
+
+	if (WorkEvent != NULL)
+	{
+		delete WorkEvent;
+		WorkEvent = NULL;
+	}
+}
+
+FString FShooterPersistentUserStorage::GetSlotPath(const FString& SlotName)
+{
+	return FString::Printf(TEXT("%sSaveGames/%s.user"), *FPaths::GameSavedDir(), *SlotName);
+}
+
+void FShooterPersistentUserStorage::ReadSlot(const FString& SlotName, TArray<uint8>& OutBytes)
+{
+	OutBytes.Reset();
+	if (!FFileHelper::LoadFileToArray(OutBytes, *GetSlotPath(SlotName), FILEREAD_Silent))
+	{
+		OutBytes.Reset();
+	}
+}
+
+bool FShooterPersistentUserStorage::WriteSlot(const FString& SlotName, const TArray<uint8>& Bytes)
+{
+	const FString Path = GetSlotPath(SlotName);
+	const FString TempPath = Path + TEXT(".tmp");
+
+	if (!FFileHelper::SaveArrayToFile(Bytes, *TempPath))
+	{
+		UE_LOG(LogShooter, Warning, TEXT("Failed to write persistent user %s"), *TempPath);
+		return false;
+	}
+
+	if (!IFileManager::Get().Move(*Path, *TempPath, true))
+	{
+		UE_LOG(LogShooter, Warning, TEXT("Failed to replace persistent user %s"), *Path);
+		IFileManager::Get().Delete(*TempPath, false, false, true);
+		return false;
+	}
+
+	return true;
+}
+
+void FShooterPersistentUserStorage::Save(const FString& SlotName, const FShooterPersistentUserData& Data)
+{
+	{
+		FScopeLock ScopeLock(&Lock);
+
+		Data.ToBytes(SlotBytes.FindOrAdd(SlotName));
+		PendingWrites.AddUnique(SlotName);
+
+		// a read that did not happen yet would only bring back older data
+		PendingReads.Remove(SlotName);
+	}
+
+	if (Thread != NULL)
+	{
+		WorkEvent->Trigger();
+	}
+	else
+	{
+		while (ProcessNextRequest());
+	}
+}
+
+void FShooterPersistentUserStorage::AppendMatch(const FString& SlotName, const FShooterMatchRecord& Record)
+{
+	{
+		FScopeLock ScopeLock(&Lock);
+
+		FPendingMatch& Match = PendingMatches[PendingMatches.AddDefaulted()];
+		Match.SlotName = SlotName;
+		Match.Record = Record;
+	}
+
+	if (Thread != NULL)
+	{
+		WorkEvent->Trigger();
+	}
+	else
+	{
+		while (ProcessNextRequest());
+	}
+}
+
+void FShooterPersistentUserStorage::Prefetch(const FString& SlotName)
+{
+	if (SlotName.Len() == 0 || Thread == NULL)
+	{
+		return;
+	}
+
+	{
+		FScopeLock ScopeLock(&Lock);
+		if (SlotBytes.Contains(SlotName) || PendingReads.Contains(SlotName))
+		{
+			return;
+		}
+		PendingReads.Add(SlotName);
+	}
+
+	WorkEvent->Trigger();
+}
+
+bool FShooterPersistentUserStorage::Load(const FString& SlotName, FShooterPersistentUserData& OutData)
+{
+	for (;;)
+	{
+		{
+			FScopeLock ScopeLock(&Lock);
+
+			const TArray<uint8>* Bytes = SlotBytes.Find(SlotName);
+			if (Bytes != NULL)
+			{
+				return Bytes->Num() > 0 && OutData.FromBytes(*Bytes);
+			}
+
+			if (!PendingReads.Contains(SlotName))
+			{
+				break;
+			}
+		}
+
+		// prefetch is queued or running, it will be done sooner than a read of our own
+		FPlatformProcess::Sleep(WaitForWorkerInterval);
+	}
+
+	// not prefetched, read it here
+	UE_LOG(LogShooter, Log, TEXT("Persistent user %s was not prefetched, reading it on the calling thread"), *SlotName);
+	TArray<uint8> Bytes;
+	ReadSlot(SlotName, Bytes);
+
+	FScopeLock ScopeLock(&Lock);
+	TArray<uint8>& CachedBytes = SlotBytes.FindOrAdd(SlotName);
+	if (!PendingWrites.Contains(SlotName))
+	{
+		CachedBytes = Bytes;
+	}
+	return CachedBytes.Num() > 0 && OutData.FromBytes(CachedBytes);
+}
+
+void FShooterPersistentUserStorage::ReadMatchHistory(const FString& SlotName, int32 NumMatches)
+{
+	if (SlotName.Len() == 0)
+	{
+		return;
+	}
+
+	{
+		FScopeLock ScopeLock(&Lock);
+
+		// a new request replaces a result that was not taken yet, it could be missing matches appended since
+		FMatchHistory& History = MatchHistories.FindOrAdd(SlotName);
+		History.NumMatches = NumMatches;
+		History.RequestCount++;
+		History.bRead = false;
+	}
+
+	if (Thread != NULL)
+	{
+		WorkEvent->Trigger();
+	}
+	else
+	{
+		while (ProcessNextRequest());
+	}
+}
+
+bool FShooterPersistentUserStorage::TakeMatchHistory(const FString& SlotName, FShooterMatchHistorySummary& OutSummary, TArray<FShooterMatchRecord>& OutRecords)
+{
+	FScopeLock ScopeLock(&Lock);
+
+	FMatchHistory* History = MatchHistories.Find(SlotName);
+	if (History == NULL || !History->bRead)
+	{
+		return false;
+	}
+
+	OutSummary = History->Summary;
+	Exchange(OutRecords, History->Records);
+	MatchHistories.Remove(SlotName);
+	return true;
+}
+
+void FShooterPersistentUserStorage::Flush()
+{
+	if (Thread == NULL)
+	{
+		while (ProcessNextRequest());
+		return;
+	}
+
+	for (;;)
+	{
+		{
+			FScopeLock ScopeLock(&Lock);
+			if (PendingWrites.Num() == 0 && PendingMatches.Num() == 0 && NumInProgress == 0)
+			{
+				return;
+			}
+		}
+
+		WorkEvent->Trigger();
+		FPlatformProcess::Sleep(WaitForWorkerInterval);
+	}
+}
+
+bool FShooterPersistentUserStorage::ProcessNextRequest()
+{
+	FString SlotName;
+	TArray<uint8> Bytes;
+	bool bIsWrite = false;
+	bool bIsMatch = false;
+	bool bIsHistoryRead = false;
+	int32 NumHistoryMatches = 0;
+	int32 HistoryRequest = 0;
+	FShooterMatchRecord Match;
+	{
+		FScopeLock ScopeLock(&Lock);
+		if (PendingWrites.Num() > 0)
+		{
+			SlotName = PendingWrites[0];
+			PendingWrites.RemoveAt(0);
+			Bytes = SlotBytes.FindRef(SlotName);
+			bIsWrite = true;
+		}
+		else if (PendingMatches.Num() > 0)
+		{
+			SlotName = PendingMatches[0].SlotName;
+			Match = PendingMatches[0].Record;
+			PendingMatches.RemoveAt(0);
+			bIsMatch = true;
+		}
+		else if (PendingReads.Num() > 0)
+		{
+			SlotName = PendingReads[0];
+		}
+		else
+		{
+			// history reads come after appends, so they include every match queued before them
+			for (TMap<FString, FMatchHistory>::TIterator It(MatchHistories); It; ++It)
+			{
+				if (!It.Value().bRead)
+				{
+					SlotName = It.Key();
+					NumHistoryMatches = It.Value().NumMatches;
+					HistoryRequest = It.Value().RequestCount;
+					bIsHistoryRead = true;
+					break;
+				}
+			}
+
+			if (!bIsHistoryRead)
+			{
+				return false;
+			}
+		}
+		NumInProgress++;
+	}
+
+	if (bIsHistoryRead)
+	{
+		FShooterMatchHistorySummary Summary;
+		TArray<FShooterMatchRecord> Records;
+		FShooterMatchHistory::ReadSummary(SlotName, Summary);
+		FShooterMatchHistory::ReadRecent(SlotName, NumHistoryMatches, Records);
+
+		FScopeLock ScopeLock(&Lock);
+		FMatchHistory* History = MatchHistories.Find(SlotName);
+		if (History != NULL && !History->bRead && History->RequestCount == HistoryRequest)
+		{
+			History->Summary = Summary;
+			Exchange(History->Records, Records);
+			History->bRead = true;
+		}
+		NumInProgress--;
+		return true;
+	}
+
+	if (bIsWrite)
+	{
+		WriteSlot(SlotName, Bytes);
+	}
+	else if (bIsMatch)
+	{
+		FShooterMatchHistory::Append(SlotName, Match);
+	}
+	else
+	{
+		ReadSlot(SlotName, Bytes);
+	}
+
+	FScopeLock ScopeLock(&Lock);
+	if (!bIsWrite && !bIsMatch && PendingReads.Remove(SlotName) > 0 && !SlotBytes.Contains(SlotName))
+	{
+		// only publish if nobody saved the slot while we were reading it
+		SlotBytes.Add(SlotName, Bytes);
+	}
+	NumInProgress--;
+	return true;
+}
+
+uint32 FShooterPersistentUserStorage::Run()
+{
+	while (StopRequested.GetValue() == 0)
+	{
+		if (!ProcessNextRequest())
+		{
+			WorkEvent->Wait(100);
+		}
+	}
+
+	// don't lose saves queued right before shutdown
+	while (ProcessNextRequest());
+	return 0;
+}
+
+void FShooterPersistentUserStorage::Stop()
+{
+	StopRequested.Increment();
+	if (WorkEvent != NULL)
+	{
+		WorkEvent->Trigger();
+	}
+}
@@ -0,0 +1,161 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Player/ShooterMatchHistory.h"
+
+/** snapshot of everything UShooterPersistentUser keeps on disk */
+struct FShooterPersistentUserData
+{
+	int32 Kills;
+	int32 Deaths;
+	int32 Wins;
+	int32 Losses;
+	int32 BulletsFired;
+	int32 RocketsFired;
+	int32 BotsCount;
+	float Gamma;
+	float AimSensitivity;
+	bool bInvertedYAxis;
+
+	FShooterPersistentUserData()
+		: Kills(0)
+		, Deaths(0)
+		, Wins(0)
+		, Losses(0)
+		, BulletsFired(0)
+		, RocketsFired(0)
+		, BotsCount(1)
+		, Gamma(2.2f)
+		, AimSensitivity(1.0f)
+		, bInvertedYAxis(false)
+	{
+	}
+
+	/** write to binary blob: magic, version, then packed fields */
+	void ToBytes(TArray<uint8>& OutBytes) const;
+
+	/** read from binary blob, false if blob is not a persistent user or comes from a newer version */
+	bool FromBytes(const TArray<uint8>& Bytes);
+};
+
+/**
+ * Reads and writes persistent users on a worker thread.
+ * Saves are coalesced per slot: only the latest snapshot of a slot is written, to a temp file that then replaces the old one.
+ * Loads can be prefetched so that the game thread finds the data in memory when it needs it.
+ */
+class FShooterPersistentUserStorage : public FRunnable
+{
+public:
+
+	/** gets the singleton, starts worker thread on first use */
+	static FShooterPersistentUserStorage& Get();
+
+	/** gets the singleton if anything used it yet, NULL otherwise */
+	static FShooterPersistentUserStorage* Find();
+
+	/** writes everything that is still pending and stops worker thread */
+	static void Shutdown();
+
+	/** queue save of slot, replaces any snapshot of the same slot that was not written yet */
+	void Save(const FString& SlotName, const FShooterPersistentUserData& Data);
+
+	/** queue append of finished match to history of slot */
+	void AppendMatch(const FString& SlotName, const FShooterMatchRecord& Record);
+
+	/** start reading slot in background */
+	void Prefetch(const FString& SlotName);
+
+	/** get data of slot, false if it was never saved in this format. Only touches the disk if slot was not prefetched. */
+	bool Load(const FString& SlotName, FShooterPersistentUserData& OutData);
+
+	/** start reading lifetime totals and up to NumMatches recent matches of slot in background, after matches queued so far are appended */
+	void ReadMatchHistory(const FString& SlotName, int32 NumMatches);
+
+	/** get history read by ReadMatchHistory, false while it's still being read */
+	bool TakeMatchHistory(const FString& SlotName, FShooterMatchHistorySummary& OutSummary, TArray<FShooterMatchRecord>& OutRecords);
+
+	/** block until all queued saves and matches are on disk */
+	void Flush();
+
+	// Begin FRunnable interface
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+	// End FRunnable interface
+
+private:
+
+	FShooterPersistentUserStorage();
+	virtual ~FShooterPersistentUserStorage();
+
+	/** get file used for slot */
+	static FString GetSlotPath(const FString& SlotName);
+
+	/** read file of slot, empty array if there is none */
+	static void ReadSlot(const FString& SlotName, TArray<uint8>& OutBytes);
+
+	/** write file of slot through temp file, so a crash never leaves a half written save behind */
+	static bool WriteSlot(const FString& SlotName, const TArray<uint8>& Bytes);
+
+	/** do one queued read or write, false if there was nothing to do */
+	bool ProcessNextRequest();
+
+	/** latest known content per slot, written or not. Empty blob means the slot has no file. */
+	TMap<FString, TArray<uint8> > SlotBytes;
+
+	/** slots whose content in SlotBytes was not written yet */
+	TArray<FString> PendingWrites;
+
+	struct FPendingMatch
+	{
+		FString SlotName;
+		FShooterMatchRecord Record;
+	};
+
+	/** matches waiting to be appended to history, oldest first */
+	TArray<FPendingMatch> PendingMatches;
+
+	/** slots queued for reading */
+	TArray<FString> PendingReads;
+
+	struct FMatchHistory
+	{
+		/** number of recent matches to read */
+		int32 NumMatches;
+
+		/** bumped by every request, so a read that was requested again while running is not published */
+		int32 RequestCount;
+
+		bool bRead;
+		FShooterMatchHistorySummary Summary;
+		TArray<FShooterMatchRecord> Records;
+
+		FMatchHistory()
+			: NumMatches(0)
+			, RequestCount(0)
+			, bRead(false)
+		{
+		}
+	};
+
+	/** match history reads per slot, queued or done but not taken yet */
+	TMap<FString, FMatchHistory> MatchHistories;
+
+	/** number of requests the worker took but did not finish yet */
+	int32 NumInProgress;
+
+	/** guards everything above */
+	FCriticalSection Lock;
+
+	/** triggered when new requests are queued */
+	FEvent* WorkEvent;
+
+	/** worker thread, NULL if platform can't run one and requests are done right away */
+	FRunnableThread* Thread;
+
+	/** set when worker should exit */
+	FThreadSafeCounter StopRequested;
+
+	/** the singleton */
+	static FShooterPersistentUserStorage* Instance;
+};
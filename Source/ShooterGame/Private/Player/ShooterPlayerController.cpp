@@ -3,6 +3,9 @@
 #include "ShooterGame.h"
 #include "UI/Menu/ShooterIngameMenu.h"
 #include "UI/Style/ShooterStyle.h"
+#include "Online/ShooterMatchEvents.h"
+#include "Player/ShooterMatchHistory.h"
+#include "Online/ShooterRpcLimiter.h"
 #include "Online.h"
 #include "OnlineAchievementsInterface.h"
 #include "OnlineEventsInterface.h"
@@ -69,7 +72,10 @@ void AShooterPlayerController::SetupInputComponent()
 void AShooterPlayerController::PostInitializeComponents()
 {
 	Super::PostInitializeComponents();
-	FShooterStyle::Initialize();
+	if (!IsRunningDedicatedServer())
+	{
+		FShooterStyle::Initialize();
+	}
 	ShooterFriendUpdateTimer = 0;
 }
 
@@ -128,6 +134,20 @@ void AShooterPlayerController::SetPlayer( UPlayer* InPlayer )
 	ShooterIngameMenu->Construct(Cast<ULocalPlayer>(Player));
 }
 
+FShooterRpcLimiter* AShooterPlayerController::GetRpcLimiter()
+{
+	if (Role < ROLE_Authority)
+	{
+		return NULL;
+	}
+
+	if (!RpcLimiter.IsValid())
+	{
+		RpcLimiter = MakeShareable(new FShooterRpcLimiter());
+	}
+	return RpcLimiter.Get();
+}
+
 void AShooterPlayerController::QueryAchievements()
 {
 	// precache achievements
@@ -203,7 +223,7 @@ void AShooterPlayerController::PawnPendingDestroy(APawn* P)
 	ClientSetSpectatorCamera(CameraLocation, CameraRotation);
 }
 
-void AShooterPlayerController::GameHasEnded(class AActor* EndGameFocus, bool bIsWinner)
+void AShooterPlayerController::ClientMatchEnded_Implementation(const FShooterMatchResult& Result)
 {
 	// write stats
 	ULocalPlayer* LocalPlayer = Cast<ULocalPlayer>(Player);
@@ -216,12 +236,13 @@ void AShooterPlayerController::GameHasEnded(class AActor* EndGameFocus, bool bIs
 			UShooterPersistentUser* const PersistentUser = GetPersistentUser();
 			if (PersistentUser)
 			{
-				PersistentUser->AddMatchResult( ShooterPlayerState->GetKills(), ShooterPlayerState->GetDeaths(), ShooterPlayerState->GetNumBulletsFired(), ShooterPlayerState->GetNumRocketsFired(), bIsWinner);
+				PersistentUser->AddMatchResult(Result.Kills, Result.Deaths, Result.BulletsFired, Result.RocketsFired, Result.bWon);
+				PersistentUser->AddMatchRecord(MakeMatchRecord(Result));
 				PersistentUser->SaveIfDirty();
 			}
 
 			// update achievements
-			UpdateAchievementsOnGameEnd();
+			UpdateAchievementsOnGameEnd(Result);
 			
 			// update leaderboards
 			IOnlineSubsystem* const OnlineSub = IOnlineSubsystem::Get();
@@ -238,9 +259,9 @@ void AShooterPlayerController::GameHasEnded(class AActor* EndGameFocus, bool bIs
 						{
 							FShooterAllTimeMatchResultsWrite WriteObject;
 
-							WriteObject.SetIntStat(LEADERBOARD_STAT_SCORE, ShooterPlayerState->GetKills());
-							WriteObject.SetIntStat(LEADERBOARD_STAT_KILLS, ShooterPlayerState->GetKills());
-							WriteObject.SetIntStat(LEADERBOARD_STAT_DEATHS, ShooterPlayerState->GetDeaths());
+							WriteObject.SetIntStat(LEADERBOARD_STAT_SCORE, Result.Kills);
+							WriteObject.SetIntStat(LEADERBOARD_STAT_KILLS, Result.Kills);
+							WriteObject.SetIntStat(LEADERBOARD_STAT_DEATHS, Result.Deaths);
 							WriteObject.SetIntStat(LEADERBOARD_STAT_MATCHESPLAYED, 1);
 			
 							// the call will copy the user id and write object to its own memory
@@ -252,7 +273,38 @@ void AShooterPlayerController::GameHasEnded(class AActor* EndGameFocus, bool bIs
 		}
 	}
 
-	Super::GameHasEnded(EndGameFocus, bIsWinner);
+	// only a round that ran out of time ends with won/lost events, not one the host aborted
+	if (Result.bRoundCompleted)
+	{
+		ClientSendRoundEndEvent(Result.bWon, Result.DurationSeconds);
+	}
+}
+
+FShooterMatchRecord AShooterPlayerController::MakeMatchRecord(const FShooterMatchResult& Result) const
+{
+	FShooterMatchRecord Record;
+	Record.EndTimeTicks = FDateTime::UtcNow().GetTicks();
+	Record.MapName = GetWorld()->GetMapName();
+	Record.DurationSeconds = Result.DurationSeconds;
+	Record.bWon = Result.bWon;
+
+	AGameState* const GameState = GetWorld()->GameState;
+	if (GameState && GameState->GameModeClass)
+	{
+		Record.GameMode = GameState->GameModeClass->GetName();
+	}
+
+	// hits and flips are only counted on the server, so everything comes from its results
+	Record.Score = Result.Score;
+	Record.Kills = Result.Kills;
+	Record.Deaths = Result.Deaths;
+	Record.BulletsFired = Result.BulletsFired;
+	Record.BulletsHit = Result.BulletsHit;
+	Record.RocketsFired = Result.RocketsFired;
+	Record.RocketsHit = Result.RocketsHit;
+	Record.GravityFlips = Result.GravityFlips;
+
+	return Record;
 }
 
 void AShooterPlayerController::ClientSetSpectatorCamera_Implementation(FVector CameraLocation, FRotator CameraRotation)
@@ -976,11 +1028,24 @@ bool AShooterPlayerController::SetPause(bool bPause, FCanUnpause CanUnpauseDeleg
 	return Result;
 }
 void AShooterPlayerController::SetGravityMode(SBGravityMode NewGravityMode) {
+	const bool bChanged = (GravityMode != NewGravityMode);
 	GravityMode = NewGravityMode;
+	if (bChanged)
+	{
+		INC_DWORD_STAT(STAT_ShooterGravityFlips);
+	}
 	if (Role < ROLE_Authority) {
 		ServerSetGravityMode(NewGravityMode);
 
 	}
+	else if (bChanged) {
+		AShooterGameMode* GameMode = GetWorld()->GetAuthGameMode<AShooterGameMode>();
+		if (GameMode)
+		{
+			FShooterMatchEvent FlipEvent(EShooterMatchEvent::GravityFlip, Cast<AShooterPlayerState>(PlayerState), NULL, NewGravityMode);
+			GameMode->BroadcastMatchEvent(FlipEvent);
+		}
+	}
 }
 void AShooterPlayerController::ShowInGameMenu()
 {
@@ -990,7 +1055,7 @@ void AShooterPlayerController::ShowInGameMenu()
 		ShooterIngameMenu->ToggleGameMenu();
 	}
 }
-void AShooterPlayerController::UpdateAchievementsOnGameEnd()
+void AShooterPlayerController::UpdateAchievementsOnGameEnd(const FShooterMatchResult& Result)
 {
 	ULocalPlayer* LocalPlayer = Cast<ULocalPlayer>(Player);
 	if (LocalPlayer)
@@ -1007,7 +1072,7 @@ void AShooterPlayerController::UpdateAchievementsOnGameEnd()
 				const int32 Matches = Wins + Losses;
 
 				const int32 TotalKills = PersistentUser->GetKills();
-				const int32 MatchScore = (int32)ShooterPlayerState->GetScore();
+				const int32 MatchScore = Result.Score;
 
 				const int32 TotalBulletsFired = PersistentUser->GetBulletsFired();
 				const int32 TotalRocketsFired = PersistentUser->GetRocketsFired();
@@ -1169,10 +1234,13 @@ void AShooterPlayerController::UpdateAchievementsOnGameEnd()
 }
 
 bool AShooterPlayerController::ServerSetGravityMode_Validate(SBGravityMode NewGravityMode) {
-	return true;
+	return FShooterRpcLimiter::ValidateRpc(this, EShooterServerRpc::SetGravityMode);
 }
 
 void AShooterPlayerController::ServerSetGravityMode_Implementation(SBGravityMode NewGravityMode) {
+	if (FShooterRpcLimiter::IsRpcDropped(this, EShooterServerRpc::SetGravityMode)) {
+		return;
+	}
 	SetGravityMode(NewGravityMode);
 	AShooterCharacter* MyPawn = Cast<AShooterCharacter>(GetPawn());
 	if (MyPawn)
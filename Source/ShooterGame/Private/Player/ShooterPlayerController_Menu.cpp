@@ -12,5 +12,8 @@ void AShooterPlayerController_Menu::PostInitializeComponents()
 {
 	Super::PostInitializeComponents();
 
-	FShooterStyle::Initialize();
+	if (!IsRunningDedicatedServer())
+	{
+		FShooterStyle::Initialize();
+	}
 }
@@ -14,6 +14,9 @@
 #include "OnlineKeyValuePair.h"
 #include "ShooterStyle.h"
 #include "ShooterMenuItemWidgetStyle.h"
+#include "Player/ShooterPersistentUserStorage.h"
+#include "ShooterStartupProfiler.h"
+#include "ShooterNetTest.h"
 
 
 void SShooterWaitDialog::Construct(const FArguments& InArgs)
@@ -86,10 +89,37 @@ UShooterGameInstance::UShooterGameInstance(const FObjectInitializer& ObjectIniti
 
 void UShooterGameInstance::Init()
 {
-	Super::Init();
+	{
+		FShooterStartupScope StartupScope(TEXT("Engine game instance init"));
+		Super::Init();
+	}
+
+	FShooterStartupScope StartupScope(TEXT("Shooter game instance init"));
 
 	IgnorePairingChangeForControllerId = -1;
 	CurrentConnectionStatus = EOnlineServerConnectionStatus::Connected;
+	bPendingEnableSplitscreen = false;
+
+	OnEndSessionCompleteDelegate = FOnEndSessionCompleteDelegate::CreateUObject(this, &UShooterGameInstance::OnEndSessionComplete);
+
+	FCoreUObjectDelegates::PreLoadMap.AddUObject(this, &UShooterGameInstance::OnPreLoadMap);
+	FCoreUObjectDelegates::PostLoadMap.AddUObject(this, &UShooterGameInstance::OnPostLoadMap);
+
+	// Register delegate for ticker callback
+	TickDelegate = FTickerDelegate::CreateUObject(this, &UShooterGameInstance::Tick);
+	FTicker::GetCoreTicker().AddTicker(TickDelegate);
+
+	// lives here rather than in the game mode, clients have none
+	if (FShooterNetTest::IsRequested())
+	{
+		NetTest = MakeShareable(new FShooterNetTest());
+	}
+
+	// the rest handles local users, invites and platform events, none of which a dedicated server has
+	if (IsRunningDedicatedServer())
+	{
+		return;
+	}
 
 	// game requires the ability to ID users.
 	const auto OnlineSub = IOnlineSubsystem::Get();
@@ -117,30 +147,28 @@ void UShooterGameInstance::Init()
 	FCoreDelegates::OnControllerConnectionChange.AddUObject(this, &UShooterGameInstance::HandleControllerConnectionChange);
 	FCoreDelegates::ApplicationLicenseChange.AddUObject(this, &UShooterGameInstance::HandleAppLicenseUpdate);
 
-	FCoreUObjectDelegates::PreLoadMap.AddUObject(this, &UShooterGameInstance::OnPreLoadMap);
-	FCoreUObjectDelegates::PostLoadMap.AddUObject(this, &UShooterGameInstance::OnPostLoadMap);
-
 	FCoreUObjectDelegates::PostDemoPlay.AddUObject(this, &UShooterGameInstance::OnPostDemoPlay);
 
-	bPendingEnableSplitscreen = false;
-
 	OnlineSub->AddOnConnectionStatusChangedDelegate( FOnConnectionStatusChangedDelegate::CreateUObject( this, &UShooterGameInstance::HandleNetworkConnectionStatusChanged ) );
 
-	OnEndSessionCompleteDelegate = FOnEndSessionCompleteDelegate::CreateUObject(this, &UShooterGameInstance::OnEndSessionComplete);
-
 	SessionInterface->AddOnSessionUserInviteAcceptedDelegate( FOnSessionUserInviteAcceptedDelegate::CreateUObject( this, &UShooterGameInstance::HandleSessionUserInviteAccepted ) );
-
-	// Register delegate for ticker callback
-	TickDelegate = FTickerDelegate::CreateUObject(this, &UShooterGameInstance::Tick);
-	FTicker::GetCoreTicker().AddTicker(TickDelegate);
 }
 
 void UShooterGameInstance::Shutdown()
 {
 	Super::Shutdown();
 
+	// saves are written in the background, make sure they made it to disk
+	FShooterPersistentUserStorage* const Storage = FShooterPersistentUserStorage::Find();
+	if (Storage != NULL)
+	{
+		Storage->Flush();
+	}
+
 	// Unregister ticker delegate
 	FTicker::GetCoreTicker().RemoveTicker(TickDelegate);
+
+	NetTest.Reset();
 }
 
 void UShooterGameInstance::HandleSessionUserInviteAccepted( 
@@ -229,6 +257,10 @@ void UShooterGameInstance::OnPostLoadMap()
 	{
 		ShooterViewport->HideLoadingScreen();
 	}
+
+	// the world now holds on to the map, and anything preloaded for another map is no longer wanted
+	PreloadMapName = NAME_None;
+	PreloadedMapPackage = NULL;
 }
 
 void UShooterGameInstance::OnUserCanPlayInvite(const FUniqueNetId& UserId, EUserPrivileges::Type Privilege, uint32 PrivilegeResults)
@@ -260,6 +292,8 @@ void UShooterGameInstance::OnPostDemoPlay()
 
 void UShooterGameInstance::StartGameInstance()
 {
+	FShooterStartupScope StartupScope(TEXT("Start game instance and load first map"));
+
 #if PLATFORM_PS4 == 0
 	TCHAR Parm[4096] = TEXT("");
 
@@ -436,6 +470,84 @@ bool UShooterGameInstance::LoadFrontEndMap(const FString& MapName)
 	return bSuccess;
 }
 
+void UShooterGameInstance::PreloadMap(const FString& MapPackageName)
+{
+	const FName PackageName(*MapPackageName);
+	if (PackageName == PreloadMapName || IsRunningDedicatedServer())
+	{
+		return;
+	}
+
+	// drop the previous selection, garbage collection reclaims it
+	PreloadMapName = PackageName;
+	PreloadedMapPackage = FindObject<UPackage>(NULL, *MapPackageName);
+	if (PreloadedMapPackage == NULL)
+	{
+		LoadPackageAsync(MapPackageName, FLoadPackageAsyncDelegate::CreateUObject(this, &UShooterGameInstance::OnMapPreloaded));
+	}
+}
+
+void UShooterGameInstance::CancelMapPreload()
+{
+	// a load still in flight finishes, but OnMapPreloaded won't keep it
+	PreloadMapName = NAME_None;
+	PreloadedMapPackage = NULL;
+}
+
+void UShooterGameInstance::OnMapPreloaded(const FName& PackageName, UPackage* LoadedPackage)
+{
+	// selection may have changed while this one was loading
+	if (PackageName == PreloadMapName)
+	{
+		PreloadedMapPackage = LoadedPackage;
+	}
+}
+
+float UShooterGameInstance::GetMapPreloadPercentage() const
+{
+	if (PreloadMapName == NAME_None)
+	{
+		return -1.0f;
+	}
+	if (PreloadedMapPackage != NULL)
+	{
+		return 100.0f;
+	}
+	return FMath::Max(0.0f, GetAsyncLoadPercentage(PreloadMapName));
+}
+
+void UShooterGameInstance::UpdateLoadingProgress()
+{
+	IShooterGameLoadingScreenModule* const LoadingScreenModule = FModuleManager::GetModulePtr<IShooterGameLoadingScreenModule>("ShooterGameLoadingScreen");
+	if (LoadingScreenModule == NULL)
+	{
+		return;
+	}
+
+	const float PreloadPercentage = GetMapPreloadPercentage();
+	if (PreloadPercentage >= 0.0f)
+	{
+		LoadingScreenModule->SetPackageLoadProgress(PreloadPercentage / 100.0f);
+	}
+
+	UWorld* const World = GetWorld();
+	if (World)
+	{
+		int32 NumLoaded = 0;
+		int32 NumTotal = 0;
+		for (int32 i = 0; i < World->StreamingLevels.Num(); i++)
+		{
+			ULevelStreaming* const StreamingLevel = World->StreamingLevels[i];
+			if (StreamingLevel && StreamingLevel->bShouldBeLoaded)
+			{
+				NumTotal++;
+				NumLoaded += StreamingLevel->GetLoadedLevel() != NULL ? 1 : 0;
+			}
+		}
+		LoadingScreenModule->SetLevelStreamingProgress(NumLoaded, NumTotal);
+	}
+}
+
 AShooterGameSession* UShooterGameInstance::GetGameSession() const
 {
 	UWorld* const World = GetWorld();
@@ -1103,6 +1215,17 @@ void UShooterGameInstance::OnSearchSessionsComplete(bool bWasSuccessful)
 
 bool UShooterGameInstance::Tick(float DeltaSeconds)
 {
+	// the first tick means the first map is up, which is where cold start ends
+	FShooterStartupProfiler::WriteReport();
+
+	if (NetTest.IsValid())
+	{
+		NetTest->Tick(GetWorld(), DeltaSeconds);
+	}
+
+	// the loading screen module ends its streaming phase on these counters, servers log load times too
+	UpdateLoadingProgress();
+
 	// Dedicated server doesn't need to worry about game state
 	if (IsRunningDedicatedServer() == true)
 	{
@@ -1295,6 +1418,14 @@ void UShooterGameInstance::HandleAppSuspend()
 {
 	// Players will lose connection on resume. However it is possible the game will exit before we get a resume, so we must kick off round end events here.
 	UE_LOG( LogOnline, Warning, TEXT( "UShooterGameInstance::HandleAppSuspend" ) );
+
+	// the game may never resume, finish pending saves now
+	FShooterPersistentUserStorage* const Storage = FShooterPersistentUserStorage::Find();
+	if (Storage != NULL)
+	{
+		Storage->Flush();
+	}
+
 	UWorld* const World = GetWorld(); 
 	AShooterGameState* const GameState = World != NULL ? World->GetGameState<AShooterGameState>() : NULL;
 
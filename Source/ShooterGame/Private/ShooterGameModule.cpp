@@ -15,23 +15,32 @@
 
 
 #include "UI/Style/ShooterStyle.h"
+#include "Player/ShooterPersistentUserStorage.h"
+#include "ShooterStartupProfiler.h"
 
 
 class FShooterGameModule : public FDefaultGameModuleImpl
 {
 	virtual void StartupModule() override
 	{
+		FShooterStartupScope StartupScope(TEXT("ShooterGame module startup"));
+
 		InitializeShooterGameDelegates();
 		FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry"));
 
-		//Hot reload hack
-		FSlateStyleRegistry::UnRegisterSlateStyle(FShooterStyle::GetStyleSetName());
-		FShooterStyle::Initialize();
+		// servers draw no UI, the style is created on first use by local player controllers instead
+		if (!IsRunningDedicatedServer())
+		{
+			//Hot reload hack
+			FSlateStyleRegistry::UnRegisterSlateStyle(FShooterStyle::GetStyleSetName());
+			FShooterStyle::Initialize();
+		}
 	}
 
 	virtual void ShutdownModule() override
 	{
 		FShooterStyle::Shutdown();
+		FShooterPersistentUserStorage::Shutdown();
 	}
 };
 
@@ -39,3 +48,17 @@ IMPLEMENT_PRIMARY_GAME_MODULE(FShooterGameModule, ShooterGame, "ShooterGame2");
 
 DEFINE_LOG_CATEGORY(LogShooter)
 DEFINE_LOG_CATEGORY(LogShooterWeapon)
+
+DEFINE_STAT(STAT_ShooterPerformMovement);
+DEFINE_STAT(STAT_ShooterPhysWalking);
+DEFINE_STAT(STAT_ShooterComputeFloorDist);
+DEFINE_STAT(STAT_ShooterHandleFiring);
+DEFINE_STAT(STAT_ShooterServerNotifyHit);
+DEFINE_STAT(STAT_ShooterFindClosestEnemyWithLOS);
+DEFINE_STAT(STAT_ShooterChoosePlayerStart);
+DEFINE_STAT(STAT_ShooterDrawHUD);
+DEFINE_STAT(STAT_ShooterUpdatePlayerStateMaps);
+DEFINE_STAT(STAT_ShooterGravityFlips);
+DEFINE_STAT(STAT_ShooterMovementTraces);
+DEFINE_STAT(STAT_ShooterWeaponTraces);
+DEFINE_STAT(STAT_ShooterAITraces);
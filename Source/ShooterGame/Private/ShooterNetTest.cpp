@@ -0,0 +1,415 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "ShooterNetTest.h"
+
+FShooterNetTest* FShooterNetTest::ActiveTest = NULL;
+
+/** names used in the report */
+static const TCHAR* HitNames[EShooterNetTestHit::MAX] =
+{
+	TEXT("accepted"),
+	TEXT("rejectedBounds"),
+	TEXT("rejectedAngle"),
+	TEXT("rejectedIdle"),
+	TEXT("rejectedRateLimit"),
+	TEXT("rejected"),
+};
+
+/** smaller jumps between moves are float noise, not corrections (unreal units) */
+static const float CorrectionThreshold = 1.0f;
+
+/** corrections this long after a flip count as flip corrections (seconds) */
+static const float FlipWindowSeconds = 1.0f;
+
+/** time between scripted gravity flips (seconds) */
+static const float FlipIntervalSeconds = 4.0f;
+
+/** time between starting and stopping fire (seconds) */
+static const float FireToggleSeconds = 1.5f;
+
+/** how long the server waits for launched clients to boot and log in before it starts without them (seconds) */
+static const float ClientJoinTimeoutSeconds = 120.0f;
+
+/** how long the server waits for clients to write their reports after the test (seconds) */
+static const float ClientExitTimeoutSeconds = 30.0f;
+
+/** get UTC unix time, comparable between the processes of a test */
+static double GetUnixSeconds()
+{
+	return (FDateTime::UtcNow() - FDateTime(1970, 1, 1)).GetTotalSeconds();
+}
+
+static float GetPercentile(const TArray<float>& SortedSamples, float Percentile)
+{
+	if (SortedSamples.Num() == 0)
+	{
+		return 0.0f;
+	}
+
+	const int32 Index = FMath::Clamp(FMath::CeilToInt(Percentile * SortedSamples.Num()) - 1, 0, SortedSamples.Num() - 1);
+	return SortedSamples[Index];
+}
+
+FString FShooterNetTest::FErrorSamples::ToJson() const
+{
+	TArray<float> Sorted = Errors;
+	Sorted.Sort();
+
+	return FString::Printf(TEXT("{ \"count\": %d, \"p50\": %.2f, \"p95\": %.2f, \"p99\": %.2f, \"max\": %.2f }"),
+		Sorted.Num(), GetPercentile(Sorted, 0.5f), GetPercentile(Sorted, 0.95f), GetPercentile(Sorted, 0.99f), Sorted.Num() > 0 ? Sorted.Last() : 0.0f);
+}
+
+FShooterNetTest::FShooterNetTest()
+	: NumClients(2)
+	, ClientIndex(0)
+	, DurationSeconds(60.0f)
+	, LagMs(150)
+	, LossPercent(2)
+	, JitterMs(30)
+	, ReportPath(FPaths::GameSavedDir() + TEXT("Logs/NetTestReport.json"))
+	, bStarted(false)
+	, bServer(false)
+	, bFinished(false)
+	, bWindowOpen(false)
+	, WindowStartTime(0.0)
+	, WindowEndTime(0.0)
+	, ElapsedSeconds(0.0f)
+	, JoinWaitSeconds(0.0f)
+	, WaitSeconds(0.0f)
+	, NextFlipTime(FlipIntervalSeconds)
+	, NextFireToggleTime(FireToggleSeconds)
+	, NumFlips(0)
+	, bFiring(false)
+	, LastFlipTime(-1.0f)
+	, LastPawnLocation(FVector::ZeroVector)
+{
+	FParse::Value(FCommandLine::Get(), TEXT("NetTestClients="), NumClients);
+	FParse::Value(FCommandLine::Get(), TEXT("NetTestClientIndex="), ClientIndex);
+	FParse::Value(FCommandLine::Get(), TEXT("NetTestDuration="), DurationSeconds);
+	FParse::Value(FCommandLine::Get(), TEXT("NetTestLag="), LagMs);
+	FParse::Value(FCommandLine::Get(), TEXT("NetTestLoss="), LossPercent);
+	FParse::Value(FCommandLine::Get(), TEXT("NetTestJitter="), JitterMs);
+	FParse::Value(FCommandLine::Get(), TEXT("NetTestReport="), ReportPath);
+	NumClients = FMath::Max(0, NumClients);
+	DurationSeconds = FMath::Max(1.0f, DurationSeconds);
+
+	FMemory::Memzero(HitCounts, sizeof(HitCounts));
+
+	ActiveTest = this;
+}
+
+FShooterNetTest::~FShooterNetTest()
+{
+	if (ActiveTest == this)
+	{
+		ActiveTest = NULL;
+	}
+}
+
+bool FShooterNetTest::IsRequested()
+{
+	return FParse::Param(FCommandLine::Get(), TEXT("NetTest"));
+}
+
+FShooterNetTest* FShooterNetTest::Get()
+{
+	return ActiveTest;
+}
+
+void FShooterNetTest::NotifyClientMovementUpdated(ACharacter* Character)
+{
+	FShooterNetTest* NetTest = ActiveTest;
+	if (NetTest == NULL || !NetTest->bWindowOpen || NetTest->bServer || Character == NULL || Character != NetTest->LastPawn.Get())
+	{
+		return;
+	}
+
+	// the pawn has not moved on its own since the end of its last move, anything in between came from the server
+	const float Error = (Character->GetActorLocation() - NetTest->LastPawnLocation).Size();
+	if (Error > CorrectionThreshold)
+	{
+		NetTest->Corrections.Errors.Add(Error);
+		if (NetTest->LastFlipTime >= 0.0f && NetTest->ElapsedSeconds - NetTest->LastFlipTime <= FlipWindowSeconds)
+		{
+			NetTest->FlipCorrections.Errors.Add(Error);
+		}
+	}
+}
+
+void FShooterNetTest::CountHit(EShooterNetTestHit::Type Result)
+{
+	if (ActiveTest != NULL && ActiveTest->bWindowOpen)
+	{
+		ActiveTest->HitCounts[Result]++;
+	}
+}
+
+void FShooterNetTest::Tick(UWorld* World, float DeltaSeconds)
+{
+	if (bFinished)
+	{
+		if (bServer && FinishServer())
+		{
+			FPlatformMisc::RequestExit(false);
+		}
+		return;
+	}
+
+	if (World == NULL)
+	{
+		return;
+	}
+
+	if (!bStarted)
+	{
+		// clients start once connected, the first world they get is the one they connect from
+		const ENetMode NetMode = World->GetNetMode();
+		if (NetMode != NM_ListenServer && NetMode != NM_Client)
+		{
+			return;
+		}
+		Start(World);
+	}
+
+	if (!bWindowOpen)
+	{
+		// hits only mean something while every client is playing, so the server waits for all it launched
+		JoinWaitSeconds += DeltaSeconds;
+		const int32 NumJoined = GetNumJoinedClients(World);
+		if (NumJoined < ClientProcesses.Num())
+		{
+			if (JoinWaitSeconds < ClientJoinTimeoutSeconds)
+			{
+				return;
+			}
+			UE_LOG(LogShooter, Warning, TEXT("Net test: only %d of %d clients joined after %.0f s, starting without the others"), NumJoined, ClientProcesses.Num(), JoinWaitSeconds);
+		}
+		OpenWindow();
+	}
+
+	ElapsedSeconds += DeltaSeconds;
+
+	if (!bServer)
+	{
+		TickScript(World, DeltaSeconds);
+	}
+
+	if (ElapsedSeconds >= DurationSeconds)
+	{
+		bFinished = true;
+		bWindowOpen = false;
+		WindowEndTime = GetUnixSeconds();
+		if (!bServer)
+		{
+			FinishClient();
+		}
+	}
+}
+
+void FShooterNetTest::Start(UWorld* World)
+{
+	bStarted = true;
+	bServer = (World->GetNetMode() == NM_ListenServer);
+
+#if DO_ENABLE_NET_TEST
+	UNetDriver* NetDriver = World->GetNetDriver();
+	if (NetDriver)
+	{
+		// each side delays what it sends, so half the round trip goes on each
+		NetDriver->PacketSimulationSettings.PktLag = LagMs / 2;
+		NetDriver->PacketSimulationSettings.PktLagVariance = JitterMs;
+		NetDriver->PacketSimulationSettings.PktLoss = LossPercent;
+	}
+#else
+	UE_LOG(LogShooter, Warning, TEXT("Net test: packet emulation is compiled out of this build, running without lag or loss"));
+#endif
+
+	UE_LOG(LogShooter, Log, TEXT("Net test started as %s: %.0f s, %d ms lag, %d%% loss, %d ms jitter"),
+		bServer ? TEXT("server") : TEXT("client"), DurationSeconds, LagMs, LossPercent, JitterMs);
+
+	if (!bServer)
+	{
+		// the server only lets us in once it is ready for us
+		OpenWindow();
+		return;
+	}
+
+	// same executable, and the same project when not running cooked
+	const FString Executable = FPlatformProcess::BaseDir() + FString(FPlatformProcess::ExecutableName(false));
+	const FString Project = FPaths::IsProjectFilePathSet() ? FString::Printf(TEXT("\"%s\" -game "), *FPaths::ConvertRelativePathToFull(FPaths::GetProjectFilePath())) : FString();
+
+	for (int32 i = 0; i < NumClients; i++)
+	{
+		const FString ClientReportPath = FPaths::ConvertRelativePathToFull(FPaths::GameSavedDir() + FString::Printf(TEXT("Logs/NetTestClient%d.json"), i));
+		IFileManager::Get().Delete(*ClientReportPath, false, false, true);
+
+		const FString Params = FString::Printf(TEXT("%s127.0.0.1:%d -NetTest -NetTestClientIndex=%d -NetTestDuration=%.0f -NetTestLag=%d -NetTestLoss=%d -NetTestJitter=%d -NetTestReport=\"%s\" -nullrhi -nosound -nosteam -unattended -log=NetTestClient%d.log"),
+			*Project, World->URL.Port, i, DurationSeconds, LagMs, LossPercent, JitterMs, *ClientReportPath, i);
+
+		FProcHandle Process = FPlatformProcess::CreateProc(*Executable, *Params, false, true, true, NULL, 0, NULL, NULL);
+		if (Process.IsValid())
+		{
+			ClientProcesses.Add(Process);
+			ClientReportPaths.Add(ClientReportPath);
+		}
+		else
+		{
+			UE_LOG(LogShooter, Error, TEXT("Net test: could not launch client %d"), i);
+		}
+	}
+}
+
+int32 FShooterNetTest::GetNumJoinedClients(UWorld* World) const
+{
+	UNetDriver* NetDriver = World->GetNetDriver();
+	if (NetDriver == NULL)
+	{
+		return 0;
+	}
+
+	int32 NumJoined = 0;
+	for (int32 i = 0; i < NetDriver->ClientConnections.Num(); i++)
+	{
+		// connections get their controller on login
+		UNetConnection* Connection = NetDriver->ClientConnections[i];
+		NumJoined += (Connection && Connection->PlayerController) ? 1 : 0;
+	}
+	return NumJoined;
+}
+
+void FShooterNetTest::OpenWindow()
+{
+	bWindowOpen = true;
+	WindowStartTime = GetUnixSeconds();
+	ElapsedSeconds = 0.0f;
+
+	UE_LOG(LogShooter, Log, TEXT("Net test window opened as %s"), bServer ? TEXT("server") : TEXT("client"));
+}
+
+FString FShooterNetTest::GetWindowJson() const
+{
+	return FString::Printf(TEXT("{ \"start\": %.3f, \"end\": %.3f, \"seconds\": %.1f }"), WindowStartTime, WindowEndTime, ElapsedSeconds);
+}
+
+void FShooterNetTest::TickScript(UWorld* World, float DeltaSeconds)
+{
+	AShooterPlayerController* PC = Cast<AShooterPlayerController>(World->GetFirstPlayerController());
+	AShooterCharacter* Pawn = PC ? Cast<AShooterCharacter>(PC->GetPawn()) : NULL;
+	if (Pawn == NULL || !Pawn->IsAlive())
+	{
+		// weapon is gone with the pawn, the new one starts idle
+		bFiring = false;
+		LastPawn.Reset();
+		return;
+	}
+
+	// run in circles, weaving left and right
+	Pawn->MoveForward(1.0f);
+	Pawn->MoveRight(FMath::Sin(ElapsedSeconds * 2.0f));
+	PC->AddYawInput(20.0f * DeltaSeconds);
+
+	if (ElapsedSeconds >= NextFlipTime)
+	{
+		NextFlipTime = ElapsedSeconds + FlipIntervalSeconds;
+		LastFlipTime = ElapsedSeconds;
+
+		switch (NumFlips++ % 3)
+		{
+		case 0:
+			Pawn->OnGravityLeft();
+			break;
+		case 1:
+			Pawn->OnGravityRight();
+			break;
+		default:
+			Pawn->OnGravityForward();
+			break;
+		}
+	}
+
+	if (ElapsedSeconds >= NextFireToggleTime)
+	{
+		NextFireToggleTime = ElapsedSeconds + FireToggleSeconds;
+		bFiring = !bFiring;
+		if (bFiring)
+		{
+			Pawn->StartWeaponFire();
+		}
+		else
+		{
+			Pawn->StopWeaponFire();
+		}
+	}
+
+	// input is only consumed by the next move, so this is where the last move ended
+	LastPawn = Pawn;
+	LastPawnLocation = Pawn->GetActorLocation();
+}
+
+void FShooterNetTest::FinishClient()
+{
+	FString Report = TEXT("{\n");
+	Report += FString::Printf(TEXT("\t\t\t\"client\": %d,\n"), ClientIndex);
+	Report += FString::Printf(TEXT("\t\t\t\"window\": %s,\n"), *GetWindowJson());
+	Report += FString::Printf(TEXT("\t\t\t\"flips\": %d,\n"), NumFlips);
+	Report += FString::Printf(TEXT("\t\t\t\"correctionsPerMinute\": %.2f,\n"), Corrections.Errors.Num() * 60.0f / ElapsedSeconds);
+	Report += FString::Printf(TEXT("\t\t\t\"corrections\": %s,\n"), *Corrections.ToJson());
+	Report += FString::Printf(TEXT("\t\t\t\"flipCorrections\": %s\n"), *FlipCorrections.ToJson());
+	Report += TEXT("\t\t}");
+
+	FFileHelper::SaveStringToFile(Report, *ReportPath);
+	UE_LOG(LogShooter, Log, TEXT("Net test client done, %d corrections, report written to %s"), Corrections.Errors.Num(), *ReportPath);
+
+	FPlatformMisc::RequestExit(false);
+}
+
+bool FShooterNetTest::FinishServer()
+{
+	WaitSeconds += FApp::GetDeltaTime();
+
+	bool bClientsRunning = false;
+	for (int32 i = 0; i < ClientProcesses.Num(); i++)
+	{
+		bClientsRunning |= FPlatformProcess::IsProcRunning(ClientProcesses[i]);
+	}
+	if (bClientsRunning && WaitSeconds < ClientExitTimeoutSeconds)
+	{
+		return false;
+	}
+
+	FString Report = TEXT("{\n");
+	Report += FString::Printf(TEXT("\t\"lagMs\": %d,\n"), LagMs);
+	Report += FString::Printf(TEXT("\t\"lossPercent\": %d,\n"), LossPercent);
+	Report += FString::Printf(TEXT("\t\"jitterMs\": %d,\n"), JitterMs);
+	Report += FString::Printf(TEXT("\t\"window\": %s,\n"), *GetWindowJson());
+	Report += TEXT("\t\"hits\": {\n");
+	for (int32 Result = 0; Result < EShooterNetTestHit::MAX; Result++)
+	{
+		Report += FString::Printf(TEXT("\t\t\"%s\": %d%s\n"), HitNames[Result], HitCounts[Result], Result + 1 < EShooterNetTestHit::MAX ? TEXT(",") : TEXT(""));
+	}
+	Report += TEXT("\t},\n");
+	Report += TEXT("\t\"clients\": [\n");
+
+	int32 NumReports = 0;
+	for (int32 i = 0; i < ClientReportPaths.Num(); i++)
+	{
+		FString ClientReport;
+		if (FFileHelper::LoadFileToString(ClientReport, *ClientReportPaths[i]))
+		{
+			Report += NumReports++ > 0 ? TEXT(",\n\t\t") : TEXT("\t\t");
+			Report += ClientReport;
+		}
+		else
+		{
+			UE_LOG(LogShooter, Error, TEXT("Net test: client %d did not write a report"), i);
+		}
+	}
+
+	Report += TEXT("\n\t]\n");
+	Report += TEXT("}\n");
+
+	FFileHelper::SaveStringToFile(Report, *ReportPath);
+	UE_LOG(LogShooter, Log, TEXT("Net test done, %d of %d client reports, written to %s"), NumReports, ClientReportPaths.Num(), *ReportPath);
+	return true;
+}
@@ -0,0 +1,144 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+namespace EShooterNetTestHit
+{
+	enum Type
+	{
+		Accepted,
+		/** hit location outside of the leeway around the target */
+		RejectedBounds,
+		/** hit direction too far from where the shooter was looking */
+		RejectedAngle,
+		/** weapon was idle on the server when the hit arrived */
+		RejectedIdle,
+		/** notify was over the RPC rate limit */
+		RejectedRateLimit,
+		Rejected,
+		MAX,
+	};
+}
+
+/**
+ * Local netcode test under emulated lag, loss and jitter, started on a listen server with -NetTest:
+ *
+ *   ShooterGame /Game/Maps/Sanctuary?listen -NetTest -NetTestClients=2 -NetTestLag=150 -NetTestLoss=2 -NetTestJitter=30 -nullrhi -nosteam
+ *
+ * The server launches headless clients of the same executable that connect back to it. Every client
+ * runs, strafes, flips gravity and fires on a fixed script from the moment it connects, while it counts movement
+ * corrections from the server and how far they moved its pawn, separately for the second after each flip.
+ * The server counts accepted and rejected instant hits from the moment the last launched client has logged in.
+ * Each side stops after -NetTestDuration seconds of its own window: clients write their report and quit, then the server
+ * merges them into Saved/Logs/NetTestReport.json (or -NetTestReport=<path>) and quits too. Every window is in the
+ * report as UTC unix time, so overlaps between clients and the server can be checked.
+ * Lag is round trip time in milliseconds, split between both directions; loss and jitter apply to each direction.
+ */
+class FShooterNetTest
+{
+public:
+
+	FShooterNetTest();
+	~FShooterNetTest();
+
+	/** check if net test was requested on the command line */
+	static bool IsRequested();
+
+	/** get running net test, NULL if none */
+	static FShooterNetTest* Get();
+
+	/** [client] pawn may have been moved by a server correction since its last move */
+	static void NotifyClientMovementUpdated(class ACharacter* Character);
+
+	/** [server] count result of client side hit */
+	static void CountHit(EShooterNetTestHit::Type Result);
+
+	/** start once the world is up, script the local player and finish when time is up */
+	void Tick(UWorld* World, float DeltaSeconds);
+
+private:
+
+	/** position errors of corrections, in unreal units */
+	struct FErrorSamples
+	{
+		TArray<float> Errors;
+
+		/** write count and percentiles as JSON object */
+		FString ToJson() const;
+	};
+
+	/** set up packet emulation and, on the server, launch clients */
+	void Start(UWorld* World);
+
+	/** [server] count launched clients that have logged in */
+	int32 GetNumJoinedClients(UWorld* World) const;
+
+	/** start measuring: on connect for clients, once all clients joined for the server */
+	void OpenWindow();
+
+	/** get window as JSON object */
+	FString GetWindowJson() const;
+
+	/** drive local pawn */
+	void TickScript(UWorld* World, float DeltaSeconds);
+
+	/** write client report and quit */
+	void FinishClient();
+
+	/** wait for clients, write merged report and quit, true when done */
+	bool FinishServer();
+
+	/** values from the command line */
+	int32 NumClients;
+	int32 ClientIndex;
+	float DurationSeconds;
+	int32 LagMs;
+	int32 LossPercent;
+	int32 JitterMs;
+	FString ReportPath;
+
+	/** launched clients, server only */
+	TArray<FProcHandle> ClientProcesses;
+
+	/** report files the launched clients write */
+	TArray<FString> ClientReportPaths;
+
+	bool bStarted;
+	bool bServer;
+	bool bFinished;
+
+	/** measuring, hits and corrections only count while it is open */
+	bool bWindowOpen;
+
+	/** UTC unix time the window opened and closed */
+	double WindowStartTime;
+	double WindowEndTime;
+
+	/** time since the window opened, since the server started waiting for clients to join, and for them to quit */
+	float ElapsedSeconds;
+	float JoinWaitSeconds;
+	float WaitSeconds;
+
+	/** script state */
+	float NextFlipTime;
+	float NextFireToggleTime;
+	int32 NumFlips;
+	bool bFiring;
+
+	/** elapsed time of last flip, negative before the first */
+	float LastFlipTime;
+
+	/** where the local pawn ended its last move */
+	TWeakObjectPtr<class ACharacter> LastPawn;
+	FVector LastPawnLocation;
+
+	FErrorSamples Corrections;
+
+	/** corrections within a second after a flip, also in Corrections */
+	FErrorSamples FlipCorrections;
+
+	int32 HitCounts[EShooterNetTestHit::MAX];
+
+	/** running test */
+	static FShooterNetTest* ActiveTest;
+};
@@ -0,0 +1,273 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "ShooterSoakTest.h"
+
+#if PLATFORM_WINDOWS
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+FShooterSoakTest* FShooterSoakTest::ActiveTest = NULL;
+FShooterSoakScope* FShooterSoakScope::CurrentScope = NULL;
+
+/** process exit code of a failed run */
+static const int32 SoakFailedExitCode = 1;
+
+/** names used on the command line and in the report */
+static const TCHAR* SubsystemNames[EShooterSoakSubsystem::MAX] =
+{
+	TEXT("Frame"),
+	TEXT("Movement"),
+	TEXT("AI"),
+	TEXT("Weapons"),
+	TEXT("Replication"),
+	TEXT("GC"),
+};
+
+FShooterSoakTest::FShooterSoakTest()
+	: NumFramesToSample(0)
+	, TickRate(30.0f)
+	, StartTimeoutSeconds(300.0f)
+	, CreateTime(FPlatformTime::Seconds())
+	, ReportPath(FPaths::GameSavedDir() + TEXT("Logs/SoakReport.json"))
+	, LastFrameEndTime(0.0)
+	, EndOfWorldTickTime(0.0)
+	, GCStartCycles(0)
+	, bStarted(false)
+	, bFinished(false)
+{
+	FParse::Value(FCommandLine::Get(), TEXT("SoakTicks="), NumFramesToSample);
+	FParse::Value(FCommandLine::Get(), TEXT("SoakTickRate="), TickRate);
+	FParse::Value(FCommandLine::Get(), TEXT("SoakStartTimeout="), StartTimeoutSeconds);
+	FParse::Value(FCommandLine::Get(), TEXT("SoakReport="), ReportPath);
+	TickRate = FMath::Max(1.0f, TickRate);
+
+	FMemory::Memzero(BudgetsMs, sizeof(BudgetsMs));
+	FMemory::Memzero(FrameCycles, sizeof(FrameCycles));
+
+	// -SoakBudgets=Frame:33,AI:4
+	FString BudgetsString;
+	if (FParse::Value(FCommandLine::Get(), TEXT("SoakBudgets="), BudgetsString, false))
+	{
+		TArray<FString> Budgets;
+		BudgetsString.ParseIntoArray(&Budgets, TEXT(","), true);
+		for (int32 i = 0; i < Budgets.Num(); i++)
+		{
+			FString Name, Value;
+			if (Budgets[i].Split(TEXT(":"), &Name, &Value))
+			{
+				for (int32 Subsystem = 0; Subsystem < EShooterSoakSubsystem::MAX; Subsystem++)
+				{
+					if (Name.Trim().TrimTrailing() == SubsystemNames[Subsystem])
+					{
+						BudgetsMs[Subsystem] = FCString::Atof(*Value);
+					}
+				}
+			}
+		}
+	}
+
+	for (int32 Subsystem = 0; Subsystem < EShooterSoakSubsystem::MAX; Subsystem++)
+	{
+		Samples[Subsystem].Reserve(NumFramesToSample);
+	}
+
+	EndOfWorldTickFunction.Owner = this;
+	EndOfWorldTickFunction.TickGroup = TG_PostUpdateWork;
+	EndOfWorldTickFunction.bCanEverTick = true;
+	EndOfWorldTickFunction.bTickEvenWhenPaused = true;
+
+	// ticks from the start to catch a match that never begins
+	TickDelegate = FTickerDelegate::CreateRaw(this, &FShooterSoakTest::HandleCoreTick);
+	FTicker::GetCoreTicker().AddTicker(TickDelegate);
+}
+
+FShooterSoakTest::~FShooterSoakTest()
+{
+	FTicker::GetCoreTicker().RemoveTicker(TickDelegate);
+
+	if (bStarted)
+	{
+		EndOfWorldTickFunction.UnRegisterTickFunction();
+		FCoreUObjectDelegates::PreGarbageCollect.RemoveAll(this);
+		FCoreUObjectDelegates::PostGarbageCollect.RemoveAll(this);
+	}
+
+	if (ActiveTest == this)
+	{
+		ActiveTest = NULL;
+	}
+}
+
+bool FShooterSoakTest::IsRequested()
+{
+	int32 SoakTicks = 0;
+	return FParse::Value(FCommandLine::Get(), TEXT("SoakTicks="), SoakTicks) && SoakTicks > 0;
+}
+
+FShooterSoakTest* FShooterSoakTest::Get()
+{
+	return ActiveTest;
+}
+
+void FShooterSoakTest::Start(UWorld* World)
+{
+	if (bStarted || bFinished || World == NULL || NumFramesToSample <= 0)
+	{
+		return;
+	}
+	bStarted = true;
+	ActiveTest = this;
+	MapName = World->GetMapName();
+
+	// same simulation every run, independent of how fast the box is
+	FApp::SetBenchmarking(true);
+	FApp::SetFixedDeltaTime(1.0 / TickRate);
+
+	EndOfWorldTickFunction.RegisterTickFunction(World->PersistentLevel);
+
+	FCoreUObjectDelegates::PreGarbageCollect.AddRaw(this, &FShooterSoakTest::HandlePreGarbageCollect);
+	FCoreUObjectDelegates::PostGarbageCollect.AddRaw(this, &FShooterSoakTest::HandlePostGarbageCollect);
+
+	UE_LOG(LogShooter, Log, TEXT("Soak test started: %d frames at %.0f Hz on %s"), NumFramesToSample, TickRate, *World->GetMapName());
+}
+
+void FShooterSoakTest::AddCycles(EShooterSoakSubsystem::Type Subsystem, uint32 Cycles)
+{
+	FrameCycles[Subsystem] += Cycles;
+}
+
+void FShooterSoakTest::FEndOfWorldTickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+{
+	Owner->EndOfWorldTickTime = FPlatformTime::Seconds();
+}
+
+FString FShooterSoakTest::FEndOfWorldTickFunction::DiagnosticMessage()
+{
+	return TEXT("FShooterSoakTest::FEndOfWorldTickFunction");
+}
+
+void FShooterSoakTest::HandlePreGarbageCollect()
+{
+	GCStartCycles = FPlatformTime::Cycles();
+}
+
+void FShooterSoakTest::HandlePostGarbageCollect()
+{
+	if (GCStartCycles != 0)
+	{
+		AddCycles(EShooterSoakSubsystem::GC, FPlatformTime::Cycles() - GCStartCycles);
+		GCStartCycles = 0;
+	}
+}
+
+bool FShooterSoakTest::HandleCoreTick(float DeltaSeconds)
+{
+	const double Now = FPlatformTime::Seconds();
+	if (!bStarted)
+	{
+		if (!bFinished && Now - CreateTime > StartTimeoutSeconds)
+		{
+			UE_LOG(LogShooter, Error, TEXT("Soak test: match did not start within %.0f seconds"), StartTimeoutSeconds);
+			Finish(true);
+		}
+		return true;
+	}
+
+	// the core ticker runs after the world, so this closes the frame that just ran
+	if (!bFinished && LastFrameEndTime > 0.0)
+	{
+		float FrameMs[EShooterSoakSubsystem::MAX];
+		for (int32 Subsystem = 0; Subsystem < EShooterSoakSubsystem::MAX; Subsystem++)
+		{
+			FrameMs[Subsystem] = FPlatformTime::ToMilliseconds(FrameCycles[Subsystem]);
+		}
+		FrameMs[EShooterSoakSubsystem::Frame] = (Now - LastFrameEndTime) * 1000.0;
+		FrameMs[EShooterSoakSubsystem::Replication] = EndOfWorldTickTime > 0.0 ? FMath::Max(0.0f, (float)((Now - EndOfWorldTickTime) * 1000.0) - FrameMs[EShooterSoakSubsystem::GC]) : 0.0f;
+
+		for (int32 Subsystem = 0; Subsystem < EShooterSoakSubsystem::MAX; Subsystem++)
+		{
+			Samples[Subsystem].Add(FrameMs[Subsystem]);
+		}
+	}
+
+	LastFrameEndTime = Now;
+	EndOfWorldTickTime = 0.0;
+	FMemory::Memzero(FrameCycles, sizeof(FrameCycles));
+
+	if (!bFinished && Samples[EShooterSoakSubsystem::Frame].Num() >= NumFramesToSample)
+	{
+		Finish(false);
+	}
+
+	return true;
+}
+
+float FShooterSoakTest::GetPercentile(const TArray<float>& SortedSamples, float Percentile)
+{
+	if (SortedSamples.Num() == 0)
+	{
+		return 0.0f;
+	}
+
+	const int32 Index = FMath::Clamp(FMath::CeilToInt(Percentile * SortedSamples.Num()) - 1, 0, SortedSamples.Num() - 1);
+	return SortedSamples[Index];
+}
+
+void FShooterSoakTest::Finish(bool bTimedOut)
+{
+	bFinished = true;
+
+	bool bWithinBudget = !bTimedOut;
+
+	FString Report = TEXT("{\n");
+	Report += FString::Printf(TEXT("\t\"map\": \"%s\",\n"), *MapName);
+	Report += FString::Printf(TEXT("\t\"frames\": %d,\n"), Samples[EShooterSoakSubsystem::Frame].Num());
+	Report += FString::Printf(TEXT("\t\"tickRate\": %.1f,\n"), TickRate);
+	Report += FString::Printf(TEXT("\t\"timedOut\": %s,\n"), bTimedOut ? TEXT("true") : TEXT("false"));
+	Report += TEXT("\t\"subsystems\": {\n");
+	for (int32 Subsystem = 0; Subsystem < EShooterSoakSubsystem::MAX; Subsystem++)
+	{
+		TArray<float>& SubsystemSamples = Samples[Subsystem];
+
+		double Total = 0.0;
+		for (int32 i = 0; i < SubsystemSamples.Num(); i++)
+		{
+			Total += SubsystemSamples[i];
+		}
+		const float Average = SubsystemSamples.Num() > 0 ? (float)(Total / SubsystemSamples.Num()) : 0.0f;
+
+		SubsystemSamples.Sort();
+		const float P95 = GetPercentile(SubsystemSamples, 0.95f);
+		const float P99 = GetPercentile(SubsystemSamples, 0.99f);
+
+		const bool bOverBudget = BudgetsMs[Subsystem] > 0.0f && P99 > BudgetsMs[Subsystem];
+		if (bOverBudget)
+		{
+			bWithinBudget = false;
+			UE_LOG(LogShooter, Error, TEXT("Soak test: %s p99 %.3f ms is over budget of %.3f ms"), SubsystemNames[Subsystem], P99, BudgetsMs[Subsystem]);
+		}
+
+		Report += FString::Printf(TEXT("\t\t\"%s\": { \"avgMs\": %.3f, \"p95Ms\": %.3f, \"p99Ms\": %.3f, \"budgetMs\": %.3f, \"overBudget\": %s }%s\n"),
+			SubsystemNames[Subsystem], Average, P95, P99, BudgetsMs[Subsystem], bOverBudget ? TEXT("true") : TEXT("false"),
+			Subsystem + 1 < EShooterSoakSubsystem::MAX ? TEXT(",") : TEXT(""));
+	}
+	Report += TEXT("\t},\n");
+	Report += FString::Printf(TEXT("\t\"passed\": %s\n"), bWithinBudget ? TEXT("true") : TEXT("false"));
+	Report += TEXT("}\n");
+
+	FFileHelper::SaveStringToFile(Report, *ReportPath);
+	UE_LOG(LogShooter, Log, TEXT("Soak test %s, report written to %s"), bWithinBudget ? TEXT("passed") : TEXT("failed"), *ReportPath);
+
+	if (bWithinBudget)
+	{
+		FPlatformMisc::RequestExit(false);
+		return;
+	}
+
+	// the report is closed already, get the log out too and skip the engine shutdown, which would exit with 0
+	GLog->Flush();
+	_exit(SoakFailedExitCode);
+}
@@ -0,0 +1,182 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+namespace EShooterSoakSubsystem
+{
+	enum Type
+	{
+		/** whole engine frame */
+		Frame,
+		Movement,
+		AI,
+		Weapons,
+		/** net tick flush and the rest of the frame after the last tick group, without GC */
+		Replication,
+		GC,
+		MAX,
+	};
+}
+
+/**
+ * Headless performance run for dedicated servers, started with -SoakTicks=<frames> on the command line:
+ *
+ *   ShooterGameServer /Game/Maps/Sanctuary?Bots=64?LightweightBots -SoakTicks=9000 -SoakTickRate=30 -nosteam
+ *
+ * Once the match starts, the engine runs at a fixed timestep and time per subsystem is sampled every frame.
+ * After the given number of frames, average, p95 and p99 of each subsystem go to Saved/Logs/SoakReport.json
+ * (or -SoakReport=<path>) and the server quits. Budgets are p99 limits in milliseconds, e.g. -SoakBudgets=Frame:33,AI:4.
+ * If the match has not started after -SoakStartTimeout seconds of real time (300 by default), the report is written
+ * without samples and the server quits as well.
+ *
+ * A passing run shuts the server down normally and exits with code 0. The engine has no way to return another exit code
+ * from a clean shutdown, so a failing run flushes the report and the log and then ends the process with code 1.
+ */
+class FShooterSoakTest
+{
+public:
+
+	FShooterSoakTest();
+	~FShooterSoakTest();
+
+	/** check if soak test was requested on the command line */
+	static bool IsRequested();
+
+	/** get running soak test, NULL if none */
+	static FShooterSoakTest* Get();
+
+	/** switch to fixed timestep and start sampling */
+	void Start(UWorld* World);
+
+	/** add time spent in subsystem during current frame */
+	void AddCycles(EShooterSoakSubsystem::Type Subsystem, uint32 Cycles);
+
+private:
+
+	/** last tick group of the world is done, the rest of the frame is replication and GC */
+	struct FEndOfWorldTickFunction : public FTickFunction
+	{
+		FShooterSoakTest* Owner;
+
+		virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+		virtual FString DiagnosticMessage() override;
+	};
+
+	/** close current frame, once per engine frame */
+	bool HandleCoreTick(float DeltaSeconds);
+
+	void HandlePreGarbageCollect();
+	void HandlePostGarbageCollect();
+
+	/** write report, check budgets and quit */
+	void Finish(bool bTimedOut);
+
+	/** get p95/p99 style value of sorted samples */
+	static float GetPercentile(const TArray<float>& SortedSamples, float Percentile);
+
+	/** frames to sample */
+	int32 NumFramesToSample;
+
+	/** fixed frames per second */
+	float TickRate;
+
+	/** real time to wait for the match to start, in seconds */
+	float StartTimeoutSeconds;
+
+	/** real time the test was created */
+	double CreateTime;
+
+	/** where the report goes */
+	FString ReportPath;
+
+	/** map being tested */
+	FString MapName;
+
+	/** p99 limit per subsystem in milliseconds, 0 for none */
+	float BudgetsMs[EShooterSoakSubsystem::MAX];
+
+	/** time of each sampled frame, per subsystem, in milliseconds */
+	TArray<float> Samples[EShooterSoakSubsystem::MAX];
+
+	/** time added to the current frame so far */
+	uint32 FrameCycles[EShooterSoakSubsystem::MAX];
+
+	/** when last frame was closed, 0 before the first one */
+	double LastFrameEndTime;
+
+	/** when the world finished its last tick group this frame, 0 if it did not tick */
+	double EndOfWorldTickTime;
+
+	/** start of GC in progress */
+	uint32 GCStartCycles;
+
+	FEndOfWorldTickFunction EndOfWorldTickFunction;
+
+	/** bound to HandleCoreTick */
+	FTickerDelegate TickDelegate;
+
+	bool bStarted;
+
+	bool bFinished;
+
+	/** running test */
+	static FShooterSoakTest* ActiveTest;
+};
+
+/**
+ * Adds time spent in its scope to a subsystem of the running soak test, does nothing otherwise.
+ * Scopes nest: time of an inner scope goes to its own subsystem only, e.g. bots firing from the AI tick count as weapons.
+ * Game thread only.
+ */
+class FShooterSoakScope
+{
+public:
+
+	explicit FShooterSoakScope(EShooterSoakSubsystem::Type InSubsystem)
+		: Subsystem(InSubsystem)
+		, StartCycles(0)
+		, ChildCycles(0)
+		, Parent(NULL)
+	{
+		if (FShooterSoakTest::Get())
+		{
+			Parent = CurrentScope;
+			CurrentScope = this;
+			StartCycles = FPlatformTime::Cycles();
+		}
+	}
+
+	~FShooterSoakScope()
+	{
+		if (StartCycles == 0)
+		{
+			return;
+		}
+
+		const uint32 Cycles = FPlatformTime::Cycles() - StartCycles;
+		CurrentScope = Parent;
+		if (Parent)
+		{
+			Parent->ChildCycles += Cycles;
+		}
+
+		FShooterSoakTest* SoakTest = FShooterSoakTest::Get();
+		if (SoakTest)
+		{
+			SoakTest->AddCycles(Subsystem, Cycles - FMath::Min(Cycles, ChildCycles));
+		}
+	}
+
+private:
+
+	EShooterSoakSubsystem::Type Subsystem;
+	uint32 StartCycles;
+
+	/** time spent in nested scopes */
+	uint32 ChildCycles;
+
+	FShooterSoakScope* Parent;
+
+	/** innermost open scope */
+	static FShooterSoakScope* CurrentScope;
+};
@@ -0,0 +1,47 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "ShooterStartupProfiler.h"
+
+bool FShooterStartupProfiler::bReportWritten = false;
+
+TArray<FShooterStartupProfiler::FPhase>& FShooterStartupProfiler::GetPhases()
+{
+	static TArray<FPhase> Phases;
+	return Phases;
+}
+
+void FShooterStartupProfiler::AddPhase(const TCHAR* Name, double Seconds)
+{
+	if (!bReportWritten)
+	{
+		FPhase Phase;
+		Phase.Name = Name;
+		Phase.Seconds = Seconds;
+		GetPhases().Add(Phase);
+	}
+}
+
+void FShooterStartupProfiler::WriteReport()
+{
+	if (bReportWritten)
+	{
+		return;
+	}
+	bReportWritten = true;
+
+	const double SecondsSinceStart = FPlatformTime::Seconds() - GStartTime;
+
+	FString Report = FString::Printf(TEXT("Startup report, %s, %s\r\n"), *FDateTime::Now().ToString(), IsRunningDedicatedServer() ? TEXT("dedicated server") : TEXT("client"));
+	const TArray<FPhase>& Phases = GetPhases();
+	for (int32 i = 0; i < Phases.Num(); i++)
+	{
+		Report += FString::Printf(TEXT("%-40s %9.1f ms\r\n"), Phases[i].Name, Phases[i].Seconds * 1000.0);
+	}
+	Report += FString::Printf(TEXT("%-40s %9.1f ms\r\n"), TEXT("Process start to first tick"), SecondsSinceStart * 1000.0);
+
+	UE_LOG(LogShooter, Log, TEXT("Startup took %.1f ms, see StartupReport.txt"), SecondsSinceStart * 1000.0);
+	FFileHelper::SaveStringToFile(Report, *(FPaths::GameSavedDir() + TEXT("Logs/StartupReport.txt")));
+
+	GetPhases().Empty();
+}
@@ -0,0 +1,54 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+/**
+ * Collects time spent in startup phases and writes it to Saved/Logs/StartupReport.txt once the first map is up,
+ * so cold start of servers can be tracked between builds.
+ */
+class FShooterStartupProfiler
+{
+public:
+
+	/** add time spent in phase */
+	static void AddPhase(const TCHAR* Name, double Seconds);
+
+	/** write report of all phases so far, only the first call writes */
+	static void WriteReport();
+
+private:
+
+	struct FPhase
+	{
+		const TCHAR* Name;
+		double Seconds;
+	};
+
+	/** phases, in the order they finished */
+	static TArray<FPhase>& GetPhases();
+
+	/** set once the report is written, later phases are ignored */
+	static bool bReportWritten;
+};
+
+/** adds time spent in its scope to the startup report */
+class FShooterStartupScope
+{
+public:
+
+	explicit FShooterStartupScope(const TCHAR* InName)
+		: Name(InName)
+		, StartTime(FPlatformTime::Seconds())
+	{
+	}
+
+	~FShooterStartupScope()
+	{
+		FShooterStartupProfiler::AddPhase(Name, FPlatformTime::Seconds() - StartTime);
+	}
+
+private:
+
+	const TCHAR* Name;
+	double StartTime;
+};
@@ -30,6 +30,14 @@ void FShooterDemoPlaybackMenu::Construct( ULocalPlayer* _PlayerOwner )
 		MenuHelper::AddMenuItemSP( MainMenuItem, LOCTEXT( "No", "NO" ), this, &FShooterDemoPlaybackMenu::OnCancelExitToMain );
 		MenuHelper::AddMenuItemSP( MainMenuItem, LOCTEXT( "Yes", "YES" ), this, &FShooterDemoPlaybackMenu::OnConfirmExitToMain );
 
+		TArray<FText> OnOffList;
+		OnOffList.Add( LOCTEXT( "Off", "OFF" ) );
+		OnOffList.Add( LOCTEXT( "On", "ON" ) );
+
+		AShooterDemoSpectator* const Spectator = PlayerOwner ? Cast<AShooterDemoSpectator>( PlayerOwner->PlayerController ) : NULL;
+		TSharedPtr<FShooterMenuItem> FollowEventsItem = MenuHelper::AddMenuOptionSP( RootMenuItem, LOCTEXT( "FollowEvents", "FOLLOW EVENTS" ), OnOffList, this, &FShooterDemoPlaybackMenu::FollowEventsChanged );
+		FollowEventsItem->SelectedMultiChoice = Spectator && !Spectator->IsFollowingEvents() ? 0 : 1;
+
 		MenuHelper::AddExistingMenuItem( RootMenuItem, MainMenuItem.ToSharedRef() );
 				
 #if !SHOOTER_CONSOLE_UI
@@ -98,6 +106,15 @@ void FShooterDemoPlaybackMenu::ToggleGameMenu()
 	}
 }
 
+void FShooterDemoPlaybackMenu::FollowEventsChanged(TSharedPtr<FShooterMenuItem> MenuItem, int32 MultiOptionIndex)
+{
+	AShooterDemoSpectator* const Spectator = PlayerOwner ? Cast<AShooterDemoSpectator>( PlayerOwner->PlayerController ) : NULL;
+	if ( Spectator )
+	{
+		Spectator->DemoFollowEvents( MultiOptionIndex > 0 );
+	}
+}
+
 void FShooterDemoPlaybackMenu::OnCancelExitToMain()
 {
 	CloseSubMenu();
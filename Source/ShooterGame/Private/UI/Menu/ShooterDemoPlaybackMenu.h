@@ -46,6 +46,9 @@ protected:
 	/** removes widget from viewport */
 	void DetachGameMenu();
 	
+	/** Toggles camera following kills and gravity flips */
+	void FollowEventsChanged(TSharedPtr<FShooterMenuItem> MenuItem, int32 MultiOptionIndex);
+
 	/** Delegate called when user cancels confirmation dialog to exit to main menu */
 	void OnCancelExitToMain();
 
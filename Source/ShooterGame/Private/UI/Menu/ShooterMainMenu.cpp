@@ -30,10 +30,14 @@ static const int ChunkMapping[] = { 1, 2 };
 
 #if PLATFORM_PS4
 #	define QUICKMATCH_SUPPORTED 1
+#	define QUICKMATCH_PLATFORM_MATCHMAKING 1
 #elif PLATFORM_XBOXONE
 #	define QUICKMATCH_SUPPORTED 1
+#	define QUICKMATCH_PLATFORM_MATCHMAKING 1
 #else
 #	define QUICKMATCH_SUPPORTED 1
+// no matchmaking service, AShooterGameSession ranks and joins sessions from a regular search
+#	define QUICKMATCH_PLATFORM_MATCHMAKING 0
 #endif
 
 FShooterMainMenu::~FShooterMainMenu()
@@ -289,6 +293,10 @@ void FShooterMainMenu::Construct(TWeakObjectPtr<UShooterGameInstance> _GameInsta
 		MenuHelper::AddMenuItemSP(RootMenuItem, LOCTEXT("Leaderboards", "LEADERBOARDS"), this, &FShooterMainMenu::OnShowLeaderboard);
 		MenuHelper::AddCustomMenuItem(LeaderboardItem,SAssignNew(LeaderboardWidget,SShooterLeaderboard).OwnerWidget(MenuWidget).PlayerOwner(GetPlayerOwner()));
 
+		// Match history
+		MenuHelper::AddMenuItemSP(RootMenuItem, LOCTEXT("MatchHistory", "MATCH HISTORY"), this, &FShooterMainMenu::OnShowMatchHistory);
+		MenuHelper::AddCustomMenuItem(MatchHistoryItem,SAssignNew(MatchHistoryWidget,SShooterMatchHistory).OwnerWidget(MenuWidget).PlayerOwner(GetPlayerOwner()));
+
 		// Demos
 		{
 			MenuHelper::AddMenuItemSP(RootMenuItem, LOCTEXT("Demos", "DEMOS"), this, &FShooterMainMenu::OnShowDemoBrowser);
@@ -404,6 +412,17 @@ void FShooterMainMenu::Tick(float DeltaSeconds)
 			}
 		}
 	}
+
+	// load the selected map while the player is still picking options, so hosting is a quick travel
+	if (GameInstance.IsValid() && IsHostMenuOpen())
+	{
+		const FString MapName = GetMapName();
+		if (MapName != PreloadRequestedMapName && IsMapReady())
+		{
+			PreloadRequestedMapName = MapName;
+			GameInstance->PreloadMap(FString(TEXT("/Game/Maps/")) + MapName);
+		}
+	}
 }
 
 bool FShooterMainMenu::IsTickable() const
@@ -510,6 +529,22 @@ void FShooterMainMenu::BeginQuickMatchSearch()
 		return;
 	}
 
+#if !QUICKMATCH_PLATFORM_MATCHMAKING
+	AShooterGameSession* const GameSession = GameInstance.IsValid() ? GameInstance->GetGameSession() : NULL;
+	if (GameSession == NULL)
+	{
+		UE_LOG(LogOnline, Warning, TEXT("Quick match is not supported: couldn't find game session."));
+		return;
+	}
+
+	DisplayQuickmatchSearchingUI();
+
+	// quick matches are team deathmatch, prefer the map picked in the menu
+	GameSession->SetMatchmakingPreferences(TEXT("TDM"), GetQuickMatchMapName());
+	GameSession->OnMatchmakingComplete().RemoveAll(this);
+	GameSession->OnMatchmakingComplete().AddSP(this, &FShooterMainMenu::OnMatchmakingComplete);
+	GameSession->FindMatch(GetPlayerOwner()->GetPreferredUniqueNetId(), GameSessionName, bIsLanMatch, true);
+#else
 	QuickMatchSearchSettings = MakeShareable(new FShooterOnlineSearchSettings(false, true));
 	QuickMatchSearchSettings->QuerySettings.Set(SEARCH_XBOX_LIVE_HOPPER_NAME, FString("TeamDeathmatch"), EOnlineComparisonOp::Equals);
 	QuickMatchSearchSettings->QuerySettings.Set(SEARCH_XBOX_LIVE_SESSION_TEMPLATE_NAME, FString("MatchSession"), EOnlineComparisonOp::Equals);
@@ -531,6 +566,7 @@ void FShooterMainMenu::BeginQuickMatchSearch()
 	{
 		OnMatchmakingComplete(GameSessionName, false);
 	}
+#endif
 }
 
 
@@ -734,8 +770,17 @@ void FShooterMainMenu::HelperQuickMatchSearchingUICancel(bool bShouldRemoveSessi
 			GVC->AddViewportWidgetContent(QuickMatchStoppingWidgetContainer.ToSharedRef());
 			FSlateApplication::Get().SetKeyboardFocus(QuickMatchStoppingWidgetContainer);
 			
+#if !QUICKMATCH_PLATFORM_MATCHMAKING
+			AShooterGameSession* const GameSession = GameInstance.IsValid() ? GameInstance->GetGameSession() : NULL;
+			if (GameSession)
+			{
+				GameSession->CancelMatchmaking();
+			}
+			OnCancelMatchmakingComplete(GameSessionName, true);
+#else
 			Sessions->AddOnCancelMatchmakingCompleteDelegate(OnCancelMatchmakingCompleteDelegate);
 			Sessions->CancelMatchmaking(*PlayerOwner->GetPreferredUniqueNetId(), GameSessionName);
+#endif
 		}
 	}
 	else
@@ -793,6 +838,11 @@ void FShooterMainMenu::OnMatchmakingComplete(FName SessionName, bool bWasSuccess
 	}
 
 	SessionInterface->OnMatchmakingCompleteDelegates.RemoveSP(this, &FShooterMainMenu::OnMatchmakingComplete);
+	AShooterGameSession* const GameSession = GameInstance.IsValid() ? GameInstance->GetGameSession() : NULL;
+	if (GameSession)
+	{
+		GameSession->OnMatchmakingComplete().RemoveAll(this);
+	}
 
 	if (bQuickmatchSearchRequestCanceled && bUsedInputToCancelQuickmatchSearch)
 	{
@@ -906,6 +956,13 @@ void FShooterMainMenu::OnMenuGoBack(MenuPtr Menu)
 		ShooterOptions->RevertChanges();
 	}
 
+	// left the host menu without hosting, the preloaded map is no longer wanted
+	if ((HostOnlineMapOption.IsValid() && Menu.Contains(HostOnlineMapOption)) || (HostOfflineMapOption.IsValid() && Menu.Contains(HostOfflineMapOption)))
+	{
+		PreloadRequestedMapName.Empty();
+		GameInstance->CancelMapPreload();
+	}
+
 	// if we've backed all the way out we need to make sure online is false.
 	if (MenuWidget->GetMenuLevel() == 1)
 	{
@@ -1119,6 +1176,13 @@ void FShooterMainMenu::OnShowLeaderboard()
 	MenuWidget->EnterSubMenu();
 }
 
+void FShooterMainMenu::OnShowMatchHistory()
+{
+	MenuWidget->NextMenu = MatchHistoryItem->SubMenu;
+	MatchHistoryWidget->ReadHistory();
+	MenuWidget->EnterSubMenu();
+}
+
 void FShooterMainMenu::OnShowDemoBrowser()
 {
 	MenuWidget->NextMenu = DemoBrowserItem->SubMenu;
@@ -1184,6 +1248,18 @@ bool FShooterMainMenu::IsMapReady() const
 	return bReady;
 }
 
+bool FShooterMainMenu::IsHostMenuOpen() const
+{
+	if (!MenuWidget.IsValid())
+	{
+		return false;
+	}
+
+	const MenuPtr& CurrentMenu = MenuWidget->CurrentMenu;
+	return (HostOnlineMapOption.IsValid() && CurrentMenu.Contains(HostOnlineMapOption))
+		|| (HostOfflineMapOption.IsValid() && CurrentMenu.Contains(HostOfflineMapOption));
+}
+
 UShooterPersistentUser* FShooterMainMenu::GetPersistentUser() const
 {
 	UShooterLocalPlayer* const SLP = Cast<UShooterLocalPlayer>(GetPlayerOwner());
@@ -1205,6 +1281,16 @@ FString FShooterMainMenu::GetMapName() const
 	 return MapNames[(int)GetSelectedMap()];
 }
 
+FString FShooterMainMenu::GetQuickMatchMapName() const
+{
+	// the join menu has an "Any" choice, hosting menus always name a map
+	if (JoinMapOption.IsValid())
+	{
+		return JoinMapOption->SelectedMultiChoice > 0 ? JoinMapNames[JoinMapOption->SelectedMultiChoice] : FString();
+	}
+	return GetMapName();
+}
+
 void FShooterMainMenu::OnCancelMatchmakingComplete(FName SessionName, bool bWasSuccessful)
 {
 	auto Sessions = Online::GetSessionInterface();
@@ -7,6 +7,7 @@
 #include "Widgets/SShooterServerList.h"
 #include "Widgets/SShooterDemoList.h"
 #include "Widgets/SShooterLeaderboard.h"
+#include "Widgets/SShooterMatchHistory.h"
 #include "Widgets/SShooterSplitScreenLobbyWidget.h"
 #include "ShooterOptions.h"
 
@@ -41,6 +42,9 @@ public:
 	/** Returns the string name of the currently selected map */
 	FString GetMapName() const;
 
+	/** Returns the map quick match should prefer, empty for any */
+	FString GetQuickMatchMapName() const;
+
 protected:
 
 	enum class EMap
@@ -86,12 +90,18 @@ protected:
 	/** leaderboard widget */
 	TSharedPtr<class SShooterLeaderboard> LeaderboardWidget;
 
+	/** match history widget */
+	TSharedPtr<class SShooterMatchHistory> MatchHistoryWidget;
+
 	/** custom menu */
 	TSharedPtr<class FShooterMenuItem> JoinServerItem;
 
 	/** yet another custom menu */
 	TSharedPtr<class FShooterMenuItem> LeaderboardItem;
 
+	/** Custom match history menu */
+	TSharedPtr<class FShooterMenuItem> MatchHistoryItem;
+
 	/** Custom demo browser menu */
 	TSharedPtr<class FShooterMenuItem> DemoBrowserItem;
 
@@ -110,6 +120,9 @@ protected:
 	/** Track if we are showing a map download pct or not. */
 	bool bShowingDownloadPct;
 
+	/** Map last handed to PreloadMap, empty when nothing is preloaded for the host menu */
+	FString PreloadRequestedMapName;
+
 	/** Custom match or quick match */
 	EMatchType MatchType;
 
@@ -178,6 +191,9 @@ protected:
 	/** Show leaderboard */
 	void OnShowLeaderboard();
 
+	/** Show match history */
+	void OnShowMatchHistory();
+
 	/** Show demo browser */
 	void OnShowDemoBrowser();
 
@@ -199,6 +215,9 @@ protected:
 	/** Checks the ChunkInstaller to see if the selected map is ready for play */
 	bool IsMapReady() const;
 
+	/** Checks if the menu holding the map option is shown */
+	bool IsHostMenuOpen() const;
+
 	/** Callback for when game is created */
 	void OnGameCreated(bool bWasSuccessful);
 
@@ -217,6 +217,13 @@ void FShooterWelcomeMenu::HandleLoginUIClosed(TSharedPtr<FUniqueNetId> UniqueId,
 			const auto IdentityInterface = OnlineSub->GetIdentityInterface();
 			if (IdentityInterface.IsValid())
 			{
+				// read saved settings while the privilege check is running, under the name the first player will load them with
+				UShooterLocalPlayer* const FirstPlayer = Cast<UShooterLocalPlayer>(GameInstance->GetFirstGamePlayer());
+				if (FirstPlayer != NULL)
+				{
+					UShooterPersistentUser::PrefetchPersistentUser(FirstPlayer->GetNicknameFor(IdentityInterface->GetPlayerNickname(*UniqueId), ControllerIndex));
+				}
+
 				IdentityInterface->GetUserPrivilege(*UniqueId, EUserPrivileges::CanPlay, IOnlineIdentity::FOnGetUserPrivilegeCompleteDelegate::CreateSP(this, &FShooterWelcomeMenu::OnUserCanPlay));
 			}
 		}
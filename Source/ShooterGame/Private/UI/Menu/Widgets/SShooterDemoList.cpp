@@ -6,6 +6,7 @@
 #include "ShooterStyle.h"
 #include "ShooterGameLoadingScreen.h"
 #include "ShooterGameInstance.h"
+#include "Online/ShooterDemoIndex.h"
 
 #define LOCTEXT_NAMESPACE "ShooterGame.HUD.Menu"
 
@@ -39,8 +40,11 @@ void SShooterDemoList::Construct(const FArguments& InArgs)
 				.OnMouseButtonDoubleClick(this,&SShooterDemoList::OnListItemDoubleClicked)
 				.HeaderRow(
 					SNew(SHeaderRow)
-					+ SHeaderRow::Column("DemoName").FixedWidth(BoxWidth*2).DefaultLabel(NSLOCTEXT("DemoList", "DemoNameColumn", "Demo Name"))
-					+ SHeaderRow::Column("Date").FixedWidth(BoxWidth*2).DefaultLabel(NSLOCTEXT("DemoList", "DateColumn", "Date"))
+					+ SHeaderRow::Column("DemoName").FixedWidth(BoxWidth*1.5f).DefaultLabel(NSLOCTEXT("DemoList", "DemoNameColumn", "Demo Name"))
+					+ SHeaderRow::Column("MapName").FixedWidth(BoxWidth*0.75f).DefaultLabel(NSLOCTEXT("DemoList", "MapNameColumn", "Map"))
+					+ SHeaderRow::Column("Date").FixedWidth(BoxWidth*1.25f).DefaultLabel(NSLOCTEXT("DemoList", "DateColumn", "Date"))
+					+ SHeaderRow::Column("Duration").FixedWidth(BoxWidth*0.4f).DefaultLabel(NSLOCTEXT("DemoList", "DurationColumn", "Length"))
+					+ SHeaderRow::Column("Players").FixedWidth(BoxWidth*0.4f).DefaultLabel(NSLOCTEXT("DemoList", "PlayersColumn", "Players"))
 					+ SHeaderRow::Column("Size").HAlignHeader(HAlign_Left).HAlignCell(HAlign_Right).DefaultLabel(NSLOCTEXT("DemoList", "SizeColumn", "Size")))
 			]
 		]
@@ -62,54 +66,63 @@ void SShooterDemoList::Construct(const FArguments& InArgs)
 	BuildDemoList();
 }
 
-/** Updates the list until it's completely populated 
-  * While this function is currently a blocking call, it's designed to eventually allow 
-  * the demos to come from the cloud and download asynchronously
+/** Adds demos found by the indexer since last frame, until it's completely populated 
+  * Scanning and reading demo info happen on the indexer thread, only new entries are formatted here
   */
 void SShooterDemoList::UpdateBuildDemoListStatus()
 {
 	check(bBuildingDemoList); // should not be called otherwise
+	check(DemoIndexer.IsValid());
 
-	bool bFinished = true;
+	const bool bFinished = DemoIndexer->IsFinished();
 
-	const FString DemoPath = FPaths::GameSavedDir() + TEXT( "Demos/" );
-	const FString WildCardPath = DemoPath + TEXT( "*.demo" );
+	TArray<FShooterDemoInfo> NewDemos;
+	DemoIndexer->ConsumeResults(NewDemos);
 
-	TArray<FString> FileNames;
-	IFileManager::Get().FindFiles( FileNames, *WildCardPath, true, false );
-
-	for ( int32 i = 0; i < FileNames.Num(); i++ )
+	for ( int32 i = 0; i < NewDemos.Num(); i++ )
 	{
+		const FShooterDemoInfo& Info = NewDemos[i];
 		TSharedPtr<FDemoEntry> NewDemoEntry = MakeShareable( new FDemoEntry() );
 
-		float Size = (float)IFileManager::Get().FileSize( *( DemoPath + FileNames[i] ) ) / 1024;
+		float Size = (float)Info.SizeBytes / 1024;
 
-		NewDemoEntry->DemoName		= FileNames[i];
-		NewDemoEntry->DateTime		= IFileManager::Get().GetTimeStamp( *( DemoPath + FileNames[i] ) );
+		NewDemoEntry->DemoName		= Info.FileName;
+		NewDemoEntry->DateTime		= Info.TimeStamp;
 		NewDemoEntry->Date			= NewDemoEntry->DateTime.ToString( TEXT( "%m/%d/%Y %h:%m %A" ) );	// UTC time
 		NewDemoEntry->Size			= Size >= 1024.0f ? FString::Printf( TEXT("%2.2f MB" ), Size / 1024.0f ) : FString::Printf( TEXT("%i KB" ), (int)Size );
-		NewDemoEntry->ResultsIndex	= i;
+		NewDemoEntry->MapName		= Info.MapName;
+		NewDemoEntry->Duration		= Info.DurationSeconds > 0.0f ? FString::Printf( TEXT("%i:%02i"), FMath::TruncToInt(Info.DurationSeconds) / 60, FMath::TruncToInt(Info.DurationSeconds) % 60 ) : FString();
+		NewDemoEntry->Players		= Info.PlayerNames.Num() > 0 ? FString::FromInt( Info.PlayerNames.Num() ) : FString();
+		NewDemoEntry->ResultsIndex	= DemoList.Num();
 
 		DemoList.Add( NewDemoEntry );
 	}
 
-	// Sort demo names by date
-	struct FCompareDateTime
+	if ( NewDemos.Num() > 0 )
 	{
-		FORCEINLINE bool operator()( const TSharedPtr<FDemoEntry> & A, const TSharedPtr<FDemoEntry> & B ) const
+		// Sort demo names by date
+		struct FCompareDateTime
 		{
-			return A->DateTime.GetTicks() > B->DateTime.GetTicks();
-		}
-	};
+			FORCEINLINE bool operator()( const TSharedPtr<FDemoEntry> & A, const TSharedPtr<FDemoEntry> & B ) const
+			{
+				return A->DateTime.GetTicks() > B->DateTime.GetTicks();
+			}
+		};
 
-	Sort( DemoList.GetData(), DemoList.Num(), FCompareDateTime() );
+		Sort( DemoList.GetData(), DemoList.Num(), FCompareDateTime() );
 
-	StatusText = "";
+		DemoListWidget->RequestListRefresh();
+	}
 
 	if ( bFinished )
 	{		
+		StatusText = FString();
 		OnBuildDemoListFinished();
 	}
+	else if ( NewDemos.Num() > 0 )
+	{
+		StatusText = FString::Printf( TEXT("%s (%i)"), *LOCTEXT("SearchingDemos", "SEARCHING...").ToString(), DemoList.Num() );
+	}
 }
 
 FString SShooterDemoList::GetBottomText() const
@@ -139,6 +152,12 @@ void SShooterDemoList::BuildDemoList()
 {
 	bBuildingDemoList = true;
 	DemoList.Empty();
+	DemoListWidget->RequestListRefresh();
+	StatusText = LOCTEXT("SearchingDemos", "SEARCHING...").ToString();
+
+	// replacing the indexer stops a scan that is still running
+	DemoIndexer = MakeShareable( new FShooterDemoIndexer() );
+	DemoIndexer->Start();
 }
 
 /** Called when demo list building is finished */
@@ -279,6 +298,18 @@ TSharedRef<ITableRow> SShooterDemoList::MakeListViewWidget(TSharedPtr<FDemoEntry
 			{
 				ItemText = Item->Size;
 			}
+			else if (ColumnName == "MapName")
+			{
+				ItemText = Item->MapName;
+			}
+			else if (ColumnName == "Duration")
+			{
+				ItemText = Item->Duration;
+			}
+			else if (ColumnName == "Players")
+			{
+				ItemText = Item->Players;
+			}
 
 			return SNew(STextBlock)
 				.Text(ItemText)
@@ -13,6 +13,9 @@ struct FDemoEntry
 	FDateTime	DateTime;
 	FString		Date;
 	FString		Size;
+	FString		MapName;
+	FString		Duration;
+	FString		Players;
 	int32		ResultsIndex;
 };
 
@@ -52,7 +55,7 @@ public:
 	/** selection changed handler */
 	void EntrySelectionChanged(TSharedPtr<FDemoEntry> InItem, ESelectInfo::Type SelectInfo);
 
-	/** Updates the list until it's completely populated */
+	/** Adds demos found by the indexer since last frame, until it's completely populated */
 	void UpdateBuildDemoListStatus();
 
 	/** Populates the demo list */
@@ -84,6 +87,9 @@ protected:
 	/** action bindings array */
 	TArray< TSharedPtr<FDemoEntry> > DemoList;
 
+	/** scans demo directory in background while the list is being built */
+	TSharedPtr<class FShooterDemoIndexer> DemoIndexer;
+
 	/** action bindings list slate widget */
 	TSharedPtr< SListView< TSharedPtr<FDemoEntry> > > DemoListWidget; 
 
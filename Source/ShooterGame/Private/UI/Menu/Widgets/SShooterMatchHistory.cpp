@@ -0,0 +1,246 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+#include "ShooterGame.h"
+#include "SShooterMatchHistory.h"
+#include "SHeaderRow.h"
+#include "ShooterStyle.h"
+#include "Player/ShooterPersistentUserStorage.h"
+
+#define LOCTEXT_NAMESPACE "ShooterGame.HUD.Menu"
+
+/** number of recent matches listed */
+static const int32 MatchHistoryListSize = 50;
+
+FMatchHistoryRow::FMatchHistoryRow(const FShooterMatchRecord& Record)
+	: Date(FDateTime(Record.EndTimeTicks).ToString(TEXT("%m/%d/%Y %h:%m %A")))	// UTC time
+	, MapName(Record.MapName)
+	, GameMode(Record.GameMode)
+	, Result(Record.bWon ? LOCTEXT("MatchWon", "WON").ToString() : LOCTEXT("MatchLost", "LOST").ToString())
+	, Score(FString::FromInt(Record.Score))
+	, Kills(FString::FromInt(Record.Kills))
+	, Deaths(FString::FromInt(Record.Deaths))
+	, Accuracy(FString::Printf(TEXT("%i%%"), FMath::RoundToInt(Record.GetBulletAccuracy() * 100.0f)))
+{
+	GameMode.RemoveFromStart(TEXT("ShooterGame_"));
+}
+
+void SShooterMatchHistory::Construct(const FArguments& InArgs)
+{
+	PlayerOwner = InArgs._PlayerOwner;
+	OwnerWidget = InArgs._OwnerWidget;
+	const int32 BoxWidth = 125;
+
+	ChildSlot
+	.VAlign(VAlign_Fill)
+	.HAlign(HAlign_Fill)
+	[
+		SNew(SVerticalBox)
+		+ SVerticalBox::Slot()
+		.AutoHeight()
+		[
+			SNew(SBox)
+			.WidthOverride(700)
+			.HeightOverride(500)
+			[
+				SAssignNew(RowListWidget, SListView< TSharedPtr<FMatchHistoryRow> >)
+				.ItemHeight(20)
+				.ListItemsSource(&HistoryRows)
+				.SelectionMode(ESelectionMode::Single)
+				.OnGenerateRow(this, &SShooterMatchHistory::MakeListViewWidget)
+				.OnSelectionChanged(this, &SShooterMatchHistory::EntrySelectionChanged)
+				.HeaderRow(
+				SNew(SHeaderRow)
+				+ SHeaderRow::Column("Date").FixedWidth(BoxWidth*1.25f) .DefaultLabel(NSLOCTEXT("MatchHistory", "DateColumn", "Date"))
+				+ SHeaderRow::Column("MapName").FixedWidth(BoxWidth*0.75f) .DefaultLabel(NSLOCTEXT("MatchHistory", "MapNameColumn", "Map"))
+				+ SHeaderRow::Column("GameMode").FixedWidth(BoxWidth) .DefaultLabel(NSLOCTEXT("MatchHistory", "GameModeColumn", "Mode"))
+				+ SHeaderRow::Column("Result").FixedWidth(BoxWidth*0.5f) .DefaultLabel(NSLOCTEXT("MatchHistory", "ResultColumn", "Result"))
+				+ SHeaderRow::Column("Score").FixedWidth(BoxWidth*0.5f) .DefaultLabel(NSLOCTEXT("MatchHistory", "ScoreColumn", "Score"))
+				+ SHeaderRow::Column("Kills").FixedWidth(BoxWidth*0.5f) .DefaultLabel(NSLOCTEXT("MatchHistory", "KillsColumn", "Kills"))
+				+ SHeaderRow::Column("Deaths").FixedWidth(BoxWidth*0.5f) .DefaultLabel(NSLOCTEXT("MatchHistory", "DeathsColumn", "Deaths"))
+				+ SHeaderRow::Column("Accuracy") .DefaultLabel(NSLOCTEXT("MatchHistory", "AccuracyColumn", "Accuracy")))
+			]
+		]
+		+ SVerticalBox::Slot()
+		.AutoHeight()
+		.HAlign(HAlign_Center)
+		[
+			SNew(STextBlock)
+			.Text(this, &SShooterMatchHistory::GetBottomText)
+			.TextStyle(FShooterStyle::Get(), "ShooterGame.MenuServerListTextStyle")
+		]
+	];
+}
+
+FString SShooterMatchHistory::GetSlotName() const
+{
+	UShooterLocalPlayer* const LocalPlayer = Cast<UShooterLocalPlayer>(PlayerOwner.Get());
+	UShooterPersistentUser* const PersistentUser = LocalPlayer ? LocalPlayer->GetPersistentUser() : NULL;
+	return PersistentUser ? PersistentUser->GetName() : FString();
+}
+
+void SShooterMatchHistory::ReadHistory()
+{
+	HistoryRows.Reset();
+	SelectedItem.Reset();
+	RowListWidget->RequestListRefresh();
+
+	ReadingSlotName = GetSlotName();
+	if (ReadingSlotName.Len() == 0)
+	{
+		StatusText = LOCTEXT("NoMatchHistory", "NO MATCHES PLAYED YET").ToString();
+		return;
+	}
+
+	// file access stays on the storage worker, Tick picks up the result
+	StatusText = LOCTEXT("ReadingMatchHistory", "LOADING...").ToString();
+	FShooterPersistentUserStorage::Get().ReadMatchHistory(ReadingSlotName, MatchHistoryListSize);
+}
+
+void SShooterMatchHistory::Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime)
+{
+	SCompoundWidget::Tick(AllottedGeometry, InCurrentTime, InDeltaTime);
+
+	FShooterMatchHistorySummary Summary;
+	TArray<FShooterMatchRecord> Records;
+	if (ReadingSlotName.Len() == 0 || !FShooterPersistentUserStorage::Get().TakeMatchHistory(ReadingSlotName, Summary, Records))
+	{
+		return;
+	}
+
+	ReadingSlotName.Empty();
+
+	for (int32 i = 0; i < Records.Num(); i++)
+	{
+		HistoryRows.Add(MakeShareable(new FMatchHistoryRow(Records[i])));
+	}
+
+	if (Summary.NumMatches > 0)
+	{
+		const float KillDeathRatio = (float)Summary.Kills / (float)FMath::Max<int64>(Summary.Deaths, 1);
+		StatusText = FString::Printf(TEXT("%s %i   %s %i   %s %.2f   %s %i%%"),
+			*LOCTEXT("MatchHistoryMatches", "MATCHES").ToString(), Summary.NumMatches,
+			*LOCTEXT("MatchHistoryWins", "WINS").ToString(), Summary.Wins,
+			*LOCTEXT("MatchHistoryKillDeath", "K/D").ToString(), KillDeathRatio,
+			*LOCTEXT("MatchHistoryAccuracy", "ACCURACY").ToString(), FMath::RoundToInt(Summary.GetBulletAccuracy() * 100.0f));
+	}
+	else
+	{
+		StatusText = LOCTEXT("NoMatchHistory", "NO MATCHES PLAYED YET").ToString();
+	}
+
+	RowListWidget->RequestListRefresh();
+	if (HistoryRows.Num() > 0)
+	{
+		RowListWidget->SetSelection(HistoryRows[0], ESelectInfo::OnNavigation);
+	}
+}
+
+FString SShooterMatchHistory::GetBottomText() const
+{
+	return StatusText;
+}
+
+void SShooterMatchHistory::OnFocusLost(const FFocusEvent& InFocusEvent)
+{
+	if (InFocusEvent.GetCause() != EFocusCause::SetDirectly)
+	{
+		FSlateApplication::Get().SetKeyboardFocus(SharedThis(this));
+	}
+}
+
+FReply SShooterMatchHistory::OnFocusReceived(const FGeometry& MyGeometry, const FFocusEvent& InFocusEvent)
+{
+	return FReply::Handled().SetUserFocus(RowListWidget.ToSharedRef(), EFocusCause::SetDirectly);
+}
+
+void SShooterMatchHistory::EntrySelectionChanged(TSharedPtr<FMatchHistoryRow> InItem, ESelectInfo::Type SelectInfo)
+{
+	SelectedItem = InItem;
+}
+
+void SShooterMatchHistory::MoveSelection(int32 MoveBy)
+{
+	const int32 SelectedItemIndex = HistoryRows.IndexOfByKey(SelectedItem);
+
+	if (SelectedItemIndex+MoveBy > -1 && SelectedItemIndex+MoveBy < HistoryRows.Num())
+	{
+		RowListWidget->SetSelection(HistoryRows[SelectedItemIndex+MoveBy]);
+	}
+}
+
+FReply SShooterMatchHistory::OnKeyDown(const FGeometry& MyGeometry, const FKeyEvent& InKeyEvent)
+{
+	FReply Result = FReply::Unhandled();
+	const FKey Key = InKeyEvent.GetKey();
+	if (Key == EKeys::Up || Key == EKeys::Gamepad_DPad_Up || Key == EKeys::Gamepad_LeftStick_Up)
+	{
+		MoveSelection(-1);
+		Result = FReply::Handled();
+	}
+	else if (Key == EKeys::Down || Key == EKeys::Gamepad_DPad_Down || Key == EKeys::Gamepad_LeftStick_Down)
+	{
+		MoveSelection(1);
+		Result = FReply::Handled();
+	}
+	return Result;
+}
+
+TSharedRef<ITableRow> SShooterMatchHistory::MakeListViewWidget(TSharedPtr<FMatchHistoryRow> Item, const TSharedRef<STableViewBase>& OwnerTable)
+{
+	class SMatchHistoryRowWidget : public SMultiColumnTableRow< TSharedPtr<FMatchHistoryRow> >
+	{
+	public:
+		SLATE_BEGIN_ARGS(SMatchHistoryRowWidget){}
+		SLATE_END_ARGS()
+
+		void Construct(const FArguments& InArgs, const TSharedRef<STableViewBase>& InOwnerTable, TSharedPtr<FMatchHistoryRow> InItem)
+		{
+			Item = InItem;
+			SMultiColumnTableRow< TSharedPtr<FMatchHistoryRow> >::Construct(FSuperRowType::FArguments(), InOwnerTable);
+		}
+
+		TSharedRef<SWidget> GenerateWidgetForColumn(const FName& ColumnName)
+		{
+			FString ItemText;
+			if (ColumnName == "Date")
+			{
+				ItemText = Item->Date;
+			}
+			else if (ColumnName == "MapName")
+			{
+				ItemText = Item->MapName;
+			}
+			else if (ColumnName == "GameMode")
+			{
+				ItemText = Item->GameMode;
+			}
+			else if (ColumnName == "Result")
+			{
+				ItemText = Item->Result;
+			}
+			else if (ColumnName == "Score")
+			{
+				ItemText = Item->Score;
+			}
+			else if (ColumnName == "Kills")
+			{
+				ItemText = Item->Kills;
+			}
+			else if (ColumnName == "Deaths")
+			{
+				ItemText = Item->Deaths;
+			}
+			else if (ColumnName == "Accuracy")
+			{
+				ItemText = Item->Accuracy;
+			}
+			return SNew(STextBlock)
+				.Text(ItemText)
+				.TextStyle(FShooterStyle::Get(), "ShooterGame.ScoreboardListTextStyle");
+		}
+		TSharedPtr<FMatchHistoryRow> Item;
+	};
+	return SNew(SMatchHistoryRowWidget, OwnerTable, Item);
+}
+
+#undef LOCTEXT_NAMESPACE
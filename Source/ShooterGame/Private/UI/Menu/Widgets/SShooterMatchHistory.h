@@ -0,0 +1,105 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "SlateBasics.h"
+#include "SlateExtras.h"
+#include "ShooterGame.h"
+
+/** match history row display information */
+struct FMatchHistoryRow
+{
+	/** when the match ended */
+	FString Date;
+
+	/** map the match was played on */
+	FString MapName;
+
+	/** game mode without class prefix */
+	FString GameMode;
+
+	/** won or lost */
+	FString Result;
+
+	FString Score;
+	FString Kills;
+	FString Deaths;
+
+	/** bullet accuracy in percent */
+	FString Accuracy;
+
+	/** Default Constructor */
+	FMatchHistoryRow(const struct FShooterMatchRecord& Record);
+};
+
+//class declare
+class SShooterMatchHistory : public SCompoundWidget
+{
+public:
+	SLATE_BEGIN_ARGS(SShooterMatchHistory)
+	{}
+
+	SLATE_ARGUMENT(TWeakObjectPtr<ULocalPlayer>, PlayerOwner)
+	SLATE_ARGUMENT(TSharedPtr<SWidget>, OwnerWidget)
+
+	SLATE_END_ARGS()
+
+	/** needed for every widget */
+	void Construct(const FArguments& InArgs);
+
+	/** if we want to receive focus */
+	virtual bool SupportsKeyboardFocus() const override { return true; }
+
+	/** focus received handler - keep the list focused */
+	virtual FReply OnFocusReceived(const FGeometry& MyGeometry, const FFocusEvent& InFocusEvent) override;
+
+	/** focus lost handler - keep the list focused */
+	virtual void OnFocusLost(const FFocusEvent& InFocusEvent) override;
+
+	/** key down handler */
+	virtual FReply OnKeyDown(const FGeometry& MyGeometry, const FKeyEvent& InKeyEvent) override;
+
+	/** picks up the history once the storage worker read it */
+	virtual void Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime) override;
+
+	/** creates single item widget, called for every list item */
+	TSharedRef<ITableRow> MakeListViewWidget(TSharedPtr<FMatchHistoryRow> Item, const TSharedRef<STableViewBase>& OwnerTable);
+
+	/** selection changed handler */
+	void EntrySelectionChanged(TSharedPtr<FMatchHistoryRow> InItem, ESelectInfo::Type SelectInfo);
+
+	/** starts reading history of the owning player in background */
+	void ReadHistory();
+
+	/** selects item at current + MoveBy index */
+	void MoveSelection(int32 MoveBy);
+
+protected:
+
+	/** get slot of owning player, empty if there is no persistent user */
+	FString GetSlotName() const;
+
+	/** get lifetime totals or current status */
+	FString GetBottomText() const;
+
+	/** recent matches, newest first */
+	TArray< TSharedPtr<FMatchHistoryRow> > HistoryRows;
+
+	/** slot being read, empty when no read is running */
+	FString ReadingSlotName;
+
+	/** lifetime totals or current status */
+	FString StatusText;
+
+	/** history list slate widget */
+	TSharedPtr< SListView< TSharedPtr<FMatchHistoryRow> > > RowListWidget;
+
+	/** currently selected list item */
+	TSharedPtr<FMatchHistoryRow> SelectedItem;
+
+	/** pointer to our owner PC */
+	TWeakObjectPtr<class ULocalPlayer> PlayerOwner;
+
+	/** pointer to our parent widget */
+	TSharedPtr<class SWidget> OwnerWidget;
+};
@@ -9,6 +9,15 @@
 
 #define LOCTEXT_NAMESPACE "ShooterGame.HUD.Menu"
 
+/** search results added to the list per tick, keeps the menu responsive when hundreds of LAN servers answer at once */
+static const int32 MaxResultsPerTick = 64;
+
+/** seconds between ping refreshes of visible rows */
+static const float PingRefreshInterval = 1.0f;
+
+/** sortable columns, in the order gamepads cycle through them */
+static const FName SortColumns[] = { FName(TEXT("Ping")), FName(TEXT("Players")), FName(TEXT("Map")), FName(TEXT("GameType")), FName(TEXT("ServerName")) };
+
 void SShooterServerList::Construct(const FArguments& InArgs)
 {
 	PlayerOwner = InArgs._PlayerOwner;
@@ -18,6 +27,10 @@ void SShooterServerList::Construct(const FArguments& InArgs)
 	bLANMatchSearch = false;
 	StatusText = FString();
 	BoxWidth = 125;
+	NumIngestedResults = 0;
+	SortColumn = SortColumns[0];
+	SortMode = EColumnSortMode::Ascending;
+	PingRefreshTimeLeft = PingRefreshInterval;
 
 	ChildSlot
 	.VAlign(VAlign_Fill)
@@ -41,10 +54,15 @@ void SShooterServerList::Construct(const FArguments& InArgs)
 				.HeaderRow(
 					SNew(SHeaderRow)
 					+ SHeaderRow::Column("ServerName").FixedWidth(BoxWidth*2) .DefaultLabel(NSLOCTEXT("ServerList", "ServerNameColumn", "Server Name"))
+						.SortMode(this, &SShooterServerList::GetColumnSortMode, FName(TEXT("ServerName"))).OnSort(this, &SShooterServerList::OnColumnSortModeChanged)
 					+ SHeaderRow::Column("GameType") .DefaultLabel(NSLOCTEXT("ServerList", "GameTypeColumn", "Game Type"))
+						.SortMode(this, &SShooterServerList::GetColumnSortMode, FName(TEXT("GameType"))).OnSort(this, &SShooterServerList::OnColumnSortModeChanged)
 					+ SHeaderRow::Column("Map").DefaultLabel(NSLOCTEXT("ServerList", "MapNameColumn", "Map"))
+						.SortMode(this, &SShooterServerList::GetColumnSortMode, FName(TEXT("Map"))).OnSort(this, &SShooterServerList::OnColumnSortModeChanged)
 					+ SHeaderRow::Column("Players") .DefaultLabel(NSLOCTEXT("ServerList", "PlayersColumn", "Players"))
-					+ SHeaderRow::Column("Ping") .DefaultLabel(NSLOCTEXT("ServerList", "NetworkPingColumn", "Ping")))
+						.SortMode(this, &SShooterServerList::GetColumnSortMode, FName(TEXT("Players"))).OnSort(this, &SShooterServerList::OnColumnSortModeChanged)
+					+ SHeaderRow::Column("Ping") .DefaultLabel(NSLOCTEXT("ServerList", "NetworkPingColumn", "Ping"))
+						.SortMode(this, &SShooterServerList::GetColumnSortMode, FName(TEXT("Ping"))).OnSort(this, &SShooterServerList::OnColumnSortModeChanged))
 			]
 		]
 		+SVerticalBox::Slot()
@@ -90,17 +108,23 @@ void SShooterServerList::UpdateSearchStatus()
 		switch(SearchState)
 		{
 			case EOnlineAsyncTaskState::InProgress:
+				// show servers as they answer instead of waiting for the whole search
 				StatusText = LOCTEXT("Searching","SEARCHING...").ToString();
+				IngestSearchResults(ShooterSession->GetSearchResults());
 				bFinishSearch = false;
 				break;
 
 			case EOnlineAsyncTaskState::Done:
-				// copy the results
 				{
-					ServerList.Empty();
 					const TArray<FOnlineSessionSearchResult> & SearchResults = ShooterSession->GetSearchResults();
 					check(SearchResults.Num() == NumSearchResults);
-					if (NumSearchResults == 0)
+					IngestSearchResults(SearchResults);
+					if (NumIngestedResults < NumSearchResults)
+					{
+						// rest goes in over the next ticks
+						bFinishSearch = false;
+					}
+					else if (NumSearchResults == 0)
 					{
 #if PLATFORM_PS4
 						StatusText = LOCTEXT("NoServersFound","NO SERVERS FOUND, PRESS SQUARE TO TRY AGAIN").ToString();
@@ -120,28 +144,6 @@ void SShooterServerList::UpdateSearchStatus()
 						StatusText = LOCTEXT("ServersRefresh","PRESS SPACE TO REFRESH SERVER LIST").ToString();
 #endif
 					}
-
-					for (int32 IdxResult = 0; IdxResult < NumSearchResults; ++IdxResult)
-					{
-						TSharedPtr<FServerEntry> NewServerEntry = MakeShareable(new FServerEntry());
-
-						const FOnlineSessionSearchResult& Result = SearchResults[IdxResult];
-
-						NewServerEntry->ServerName = Result.Session.OwningUserName;
-						NewServerEntry->Ping = FString::FromInt(Result.PingInMs);
-						NewServerEntry->CurrentPlayers = FString::FromInt(Result.Session.SessionSettings.NumPublicConnections 
-							+ Result.Session.SessionSettings.NumPrivateConnections 
-							- Result.Session.NumOpenPublicConnections 
-							- Result.Session.NumOpenPrivateConnections);
-						NewServerEntry->MaxPlayers = FString::FromInt(Result.Session.SessionSettings.NumPublicConnections
-							+ Result.Session.SessionSettings.NumPrivateConnections);
-						NewServerEntry->SearchResultsIndex = IdxResult;
-					
-						Result.Session.SessionSettings.Get(SETTING_GAMEMODE, NewServerEntry->GameType);
-						Result.Session.SessionSettings.Get(SETTING_MAPNAME, NewServerEntry->MapName);
-
-						ServerList.Add(NewServerEntry);
-					}
 				}
 				break;
 
@@ -162,6 +164,155 @@ void SShooterServerList::UpdateSearchStatus()
 }
 
 
+void SShooterServerList::IngestSearchResults(const TArray<FOnlineSessionSearchResult>& SearchResults)
+{
+	const int32 NumToIngest = FMath::Min(SearchResults.Num(), NumIngestedResults + MaxResultsPerTick);
+	bool bListChanged = false;
+	for (; NumIngestedResults < NumToIngest; ++NumIngestedResults)
+	{
+		const FOnlineSessionSearchResult& Result = SearchResults[NumIngestedResults];
+		const int32 MaxPlayers = Result.Session.SessionSettings.NumPublicConnections + Result.Session.SessionSettings.NumPrivateConnections;
+
+		TSharedPtr<FServerEntry> NewServerEntry = MakeShareable(new FServerEntry());
+		NewServerEntry->ServerName = Result.Session.OwningUserName;
+		NewServerEntry->Ping = Result.PingInMs;
+		NewServerEntry->CurrentPlayers = MaxPlayers - Result.Session.NumOpenPublicConnections - Result.Session.NumOpenPrivateConnections;
+		NewServerEntry->MaxPlayers = MaxPlayers;
+		NewServerEntry->SearchResultsIndex = NumIngestedResults;
+		Result.Session.SessionSettings.Get(SETTING_GAMEMODE, NewServerEntry->GameType);
+		Result.Session.SessionSettings.Get(SETTING_MAPNAME, NewServerEntry->MapName);
+
+		AllServers.Add(NewServerEntry);
+		if (PassesFilter(*NewServerEntry))
+		{
+			ServerList.Insert(NewServerEntry, FindSortedIndex(*NewServerEntry));
+			bListChanged = true;
+		}
+	}
+
+	if (bListChanged)
+	{
+		RefreshListWidget();
+	}
+}
+
+bool SShooterServerList::PassesFilter(const FServerEntry& Entry) const
+{
+	/** Only filter maps if a specific map is specified */
+	return MapFilterName == "Any" || Entry.MapName == MapFilterName;
+}
+
+bool SShooterServerList::IsSortedBefore(const FServerEntry& A, const FServerEntry& B) const
+{
+	int32 Result = 0;
+	if (SortColumn == SortColumns[0])
+	{
+		Result = A.Ping - B.Ping;
+	}
+	else if (SortColumn == SortColumns[1])
+	{
+		// fullest first when ascending, that's where the game is
+		Result = B.CurrentPlayers - A.CurrentPlayers;
+	}
+	else if (SortColumn == SortColumns[2])
+	{
+		Result = A.MapName.Compare(B.MapName, ESearchCase::IgnoreCase);
+	}
+	else if (SortColumn == SortColumns[3])
+	{
+		Result = A.GameType.Compare(B.GameType, ESearchCase::IgnoreCase);
+	}
+	else
+	{
+		Result = A.ServerName.Compare(B.ServerName, ESearchCase::IgnoreCase);
+	}
+	return SortMode == EColumnSortMode::Descending ? Result > 0 : Result < 0;
+}
+
+int32 SShooterServerList::FindSortedIndex(const FServerEntry& Entry) const
+{
+	// first entry that Entry goes before
+	int32 Low = 0;
+	int32 High = ServerList.Num();
+	while (Low < High)
+	{
+		const int32 Mid = (Low + High) / 2;
+		if (IsSortedBefore(Entry, *ServerList[Mid]))
+		{
+			High = Mid;
+		}
+		else
+		{
+			Low = Mid + 1;
+		}
+	}
+	return Low;
+}
+
+void SShooterServerList::SortServerList()
+{
+	ServerList.StableSort([this](const TSharedPtr<FServerEntry>& A, const TSharedPtr<FServerEntry>& B)
+	{
+		return IsSortedBefore(*A, *B);
+	});
+}
+
+EColumnSortMode::Type SShooterServerList::GetColumnSortMode(FName ColumnId) const
+{
+	return ColumnId == SortColumn ? SortMode : EColumnSortMode::None;
+}
+
+void SShooterServerList::OnColumnSortModeChanged(const FName& ColumnId, EColumnSortMode::Type NewSortMode)
+{
+	SortColumn = ColumnId;
+	SortMode = NewSortMode == EColumnSortMode::Descending ? EColumnSortMode::Descending : EColumnSortMode::Ascending;
+	SortServerList();
+	RefreshListWidget();
+}
+
+void SShooterServerList::CycleSortColumn()
+{
+	int32 ColumnIndex = 0;
+	while (ColumnIndex < ARRAY_COUNT(SortColumns) && SortColumns[ColumnIndex] != SortColumn)
+	{
+		ColumnIndex++;
+	}
+	OnColumnSortModeChanged(SortColumns[(ColumnIndex + 1) % ARRAY_COUNT(SortColumns)], EColumnSortMode::Ascending);
+}
+
+void SShooterServerList::RefreshVisiblePings()
+{
+	AShooterGameSession* ShooterSession = GetGameSession();
+	int32 CurrentSearchIdx, NumSearchResults;
+	if (ShooterSession == NULL || ShooterSession->GetSearchResultStatus(CurrentSearchIdx, NumSearchResults) != EOnlineAsyncTaskState::Done)
+	{
+		return;
+	}
+
+	// rows off screen have no widget, they show the latest ping once generated
+	const TArray<FOnlineSessionSearchResult>& SearchResults = ShooterSession->GetSearchResults();
+	for (int32 i = 0; i < ServerList.Num(); ++i)
+	{
+		FServerEntry& Entry = *ServerList[i];
+		if (Entry.SearchResultsIndex < SearchResults.Num() && ServerListWidget->WidgetFromItem(ServerList[i]).IsValid())
+		{
+			Entry.Ping = SearchResults[Entry.SearchResultsIndex].PingInMs;
+		}
+	}
+}
+
+void SShooterServerList::RefreshListWidget()
+{
+	int32 SelectedItemIndex = ServerList.IndexOfByKey(SelectedItem);
+
+	ServerListWidget->RequestListRefresh();
+	if (ServerList.Num() > 0)
+	{
+		ServerListWidget->UpdateSelectionSet();
+		ServerListWidget->SetSelection(ServerList[SelectedItemIndex > -1 ? SelectedItemIndex : 0],ESelectInfo::OnNavigation);
+	}
+}
+
 FString SShooterServerList::GetBottomText() const
 {
 	 return StatusText;
@@ -182,6 +333,15 @@ void SShooterServerList::Tick( const FGeometry& AllottedGeometry, const double I
 	{
 		UpdateSearchStatus();
 	}
+	else
+	{
+		PingRefreshTimeLeft -= InDeltaTime;
+		if (PingRefreshTimeLeft <= 0.0f)
+		{
+			PingRefreshTimeLeft = PingRefreshInterval;
+			RefreshVisiblePings();
+		}
+	}
 }
 
 /** Starts searching for servers */
@@ -191,6 +351,9 @@ void SShooterServerList::BeginServerSearch(bool bLANMatch, const FString& InMapF
 	MapFilterName = InMapFilterName;
 	bSearchingForServers = true;
 	ServerList.Empty();
+	AllServers.Empty();
+	SelectedItem.Reset();
+	NumIngestedResults = 0;
 
 	UShooterGameInstance* const GI = Cast<UShooterGameInstance>(PlayerOwner->GetGameInstance());
 	if (GI)
@@ -204,33 +367,23 @@ void SShooterServerList::OnServerSearchFinished()
 {
 	bSearchingForServers = false;
 
-	UpdateServerList();
+	// results are already in, sorted and filtered
+	RefreshListWidget();
 }
 
 void SShooterServerList::UpdateServerList()
 {
-	/** Only filter maps if a specific map is specified */
-	if (MapFilterName != "Any")
+	ServerList.Reset();
+	for (int32 i = 0; i < AllServers.Num(); ++i)
 	{
-		for (int32 i = 0; i < ServerList.Num(); ++i)
+		if (PassesFilter(*AllServers[i]))
 		{
-			/** Only filter maps if a specific map is specified */
-			if (ServerList[i]->MapName != MapFilterName)
-			{
-				ServerList.RemoveAt(i);
-			}
+			ServerList.Add(AllServers[i]);
 		}
 	}
+	SortServerList();
 
-	int32 SelectedItemIndex = ServerList.IndexOfByKey(SelectedItem);
-
-	ServerListWidget->RequestListRefresh();
-	if (ServerList.Num() > 0)
-	{
-		ServerListWidget->UpdateSelectionSet();
-		ServerListWidget->SetSelection(ServerList[SelectedItemIndex > -1 ? SelectedItemIndex : 0],ESelectInfo::OnNavigation);
-	}
-
+	RefreshListWidget();
 }
 
 void SShooterServerList::ConnectToServer()
@@ -329,6 +482,11 @@ FReply SShooterServerList::OnKeyDown(const FGeometry& MyGeometry, const FKeyEven
 	{
 		BeginServerSearch(bLANMatchSearch, "Any");
 	}
+	else if (Key == EKeys::Tab || Key == EKeys::Gamepad_FaceButton_Top)
+	{
+		CycleSortColumn();
+		Result = FReply::Handled();
+	}
 	return Result;
 }
 
@@ -363,17 +521,25 @@ TSharedRef<ITableRow> SShooterServerList::MakeListViewWidget(TSharedPtr<FServerE
 			}
 			else if (ColumnName == "Players")
 			{
-				const FText PlayersOnServer = FText::Format( FText::FromString("{0}/{1}"), FText::FromString(Item->CurrentPlayers), FText::FromString(Item->MaxPlayers) );
-				ItemText = PlayersOnServer.ToString();
+				ItemText = FString::Printf(TEXT("%d/%d"), Item->CurrentPlayers, Item->MaxPlayers);
 			}
 			else if (ColumnName == "Ping")
 			{
-				ItemText = Item->Ping;
+				// bound, so refreshed pings show without regenerating the row
+				return SNew(STextBlock)
+					.Text(this, &SServerEntryWidget::GetPingText)
+					.TextStyle(FShooterStyle::Get(), "ShooterGame.MenuServerListTextStyle");
 			} 
 			return SNew(STextBlock)
 				.Text(ItemText)
 				.TextStyle(FShooterStyle::Get(), "ShooterGame.MenuServerListTextStyle");
 		}
+
+		FString GetPingText() const
+		{
+			return FString::FromInt(Item->Ping);
+		}
+
 		TSharedPtr<FServerEntry> Item;
 	};
 	return SNew(SServerEntryWidget, OwnerTable, Item);
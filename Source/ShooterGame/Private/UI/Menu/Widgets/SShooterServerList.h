@@ -10,11 +10,11 @@
 struct FServerEntry
 {
 	FString ServerName;
-	FString CurrentPlayers;
-	FString MaxPlayers;
+	int32 CurrentPlayers;
+	int32 MaxPlayers;
 	FString GameType;
 	FString MapName;
-	FString Ping;
+	int32 Ping;
 	int32 SearchResultsIndex;
 };
 
@@ -73,6 +73,24 @@ public:
 	/** fill/update server list, should be called before showing this control */
 	void UpdateServerList();
 
+	/** add results that arrived since last call, a limited number per call */
+	void IngestSearchResults(const TArray<FOnlineSessionSearchResult>& SearchResults);
+
+	/** copy current pings from search results to rows on screen */
+	void RefreshVisiblePings();
+
+	/** sort shown servers by SortColumn */
+	void SortServerList();
+
+	/** header sort mode for given column */
+	EColumnSortMode::Type GetColumnSortMode(FName ColumnId) const;
+
+	/** header sort handler */
+	void OnColumnSortModeChanged(const FName& ColumnId, EColumnSortMode::Type NewSortMode);
+
+	/** sort by next column, for gamepads */
+	void CycleSortColumn();
+
 	/** connect to chosen server */
 	void ConnectToServer();
 
@@ -96,9 +114,36 @@ protected:
 	/** Whether we're searching for servers */
 	bool bSearchingForServers;
 
-	/** action bindings array */
+	/** servers shown: AllServers that pass the map filter, sorted by SortColumn */
 	TArray< TSharedPtr<FServerEntry> > ServerList;
 
+	/** all servers of the current search, in the order they arrived */
+	TArray< TSharedPtr<FServerEntry> > AllServers;
+
+	/** number of search results added to AllServers */
+	int32 NumIngestedResults;
+
+	/** column servers are sorted by */
+	FName SortColumn;
+
+	/** sort direction */
+	EColumnSortMode::Type SortMode;
+
+	/** time until visible pings are refreshed again */
+	float PingRefreshTimeLeft;
+
+	/** checks if server passes the map filter */
+	bool PassesFilter(const FServerEntry& Entry) const;
+
+	/** checks if A is listed before B with current sorting */
+	bool IsSortedBefore(const FServerEntry& A, const FServerEntry& B) const;
+
+	/** index to insert entry at to keep ServerList sorted, after equal entries */
+	int32 FindSortedIndex(const FServerEntry& Entry) const;
+
+	/** refresh list widget and keep or restore selection */
+	void RefreshListWidget();
+
 	/** action bindings list slate widget */
 	TSharedPtr< SListView< TSharedPtr<FServerEntry> > > ServerListWidget; 
 
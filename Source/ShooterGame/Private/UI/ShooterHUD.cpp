@@ -4,11 +4,21 @@
 #include "SShooterScoreboardWidget.h"
 #include "SChatWidget.h"
 #include "Engine/ViewportSplitScreen.h"
+#include "CanvasTypes.h"
 
 #define LOCTEXT_NAMESPACE "ShooterGame.HUD.Menu"
 
 const float AShooterHUD::MinHudScale = 0.5f;
 
+/** Sets cached text to number, formatting only if the number changed. */
+static void SetCachedNumber(FHUDCachedText& Text, int32 Value)
+{
+	if (!Text.Matches(Value))
+	{
+		Text.Set(FText::FromString(FString::FromInt(Value)), Value);
+	}
+}
+
 AShooterHUD::AShooterHUD(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
 	NoAmmoFadeOutTime =  1.0f;
@@ -81,6 +91,14 @@ AShooterHUD::AShooterHUD(const FObjectInitializer& ObjectInitializer) : Super(Ob
 	HUDLight = FColor(175,202,213,255);
 	HUDDark = FColor(110,124,131,255);
 	ShadowedFont.bEnableShadow = true;
+
+	KillsLabelText.Set(LOCTEXT("Kills", "KILLS:"));
+	KilledText.Set(LOCTEXT("killed"," killed "));
+	RespawnText.Set(LOCTEXT("WaitingForRespawn", "WAITING FOR RESPAWN"));
+	NoAmmoText.Set(LOCTEXT("NoAmmo", "NO AMMO"));
+	PlaceRankedVersion = INDEX_NONE;
+	PlacePosition = 0;
+	PlaceCount = 0;
 }
 
 void AShooterHUD::EndPlay(const EEndPlayReason::Type EndPlayReason)
@@ -161,33 +179,37 @@ void AShooterHUD::DrawWeaponHUD()
 		const float TextOffset = 12;
 		float SizeX, SizeY;
 		float TopTextHeight;
-		FString Text = FString::FromInt(MyWeapon->GetCurrentAmmoInClip());
+		SetCachedNumber(PrimaryClipText, MyWeapon->GetCurrentAmmoInClip());
 
 		FCanvasTextItem TextItem( FVector2D::ZeroVector, FText::GetEmpty(), BigFont, HUDDark );
 		TextItem.EnableShadow( FLinearColor::Black );
-		Canvas->StrLen(BigFont, Text, SizeX, SizeY);
+		const FVector2D& PrimaryClipTextSize = GetTextSize(PrimaryClipText, BigFont);
+		SizeX = PrimaryClipTextSize.X;
+		SizeY = PrimaryClipTextSize.Y;
 
 		const float TopTextScale = 0.73f; // of 51pt font
 		const float TopTextPosX = Canvas->ClipX - Canvas->OrgX - (PriWeaponBoxWidth + Offset * 2 + (BoxWidth + SizeX * TopTextScale) / 2.0f)  * ScaleUI;
 		const float TopTextPosY = Canvas->ClipY - Canvas->OrgY - (PriWeapOffsetY + PrimaryWeapBg.VL + Offset - TextOffset / 2.0f) * ScaleUI; 
-		TextItem.Text = FText::FromString( Text );
+		TextItem.Text = PrimaryClipText.Text;
 		TextItem.Scale = FVector2D( TopTextScale * ScaleUI, TopTextScale * ScaleUI );
 		TextItem.FontRenderInfo = ShadowedFont;
 		Canvas->DrawItem( TextItem, TopTextPosX, TopTextPosY );
 		TopTextHeight = SizeY * TopTextScale;
-		Text = FString::FromInt(MyWeapon->GetCurrentAmmo() - MyWeapon->GetCurrentAmmoInClip());
-		Canvas->StrLen(BigFont, Text, SizeX, SizeY);
+		SetCachedNumber(PrimaryAmmoText, MyWeapon->GetCurrentAmmo() - MyWeapon->GetCurrentAmmoInClip());
+		const FVector2D& PrimaryAmmoTextSize = GetTextSize(PrimaryAmmoText, BigFont);
+		SizeX = PrimaryAmmoTextSize.X;
+		SizeY = PrimaryAmmoTextSize.Y;
 
 		const float BottomTextScale = 0.49f; // of 51pt font
 		const float BottomTextPosX = Canvas->ClipX - Canvas->OrgX - (PriWeaponBoxWidth + Offset * 2 + (BoxWidth + SizeX * BottomTextScale) / 2.0f) * ScaleUI; 
 		const float BottomTextPosY = TopTextPosY + (TopTextHeight - 0.8f * TextOffset) * ScaleUI;
-		TextItem.Text = FText::FromString( Text );
+		TextItem.Text = PrimaryAmmoText.Text;
 		TextItem.Scale = FVector2D( BottomTextScale*ScaleUI, BottomTextScale * ScaleUI );
 		TextItem.FontRenderInfo = ShadowedFont;
 		Canvas->DrawItem( TextItem, BottomTextPosX, BottomTextPosY );
 
 		// Drawing clip icons
-		Canvas->SetDrawColor(FColor::White);
+		FColor ClipIconColor = FColor::White;
 
 		const float AmmoPerIcon = MyWeapon->GetAmmoPerClip() / MyWeapon->AmmoIconsCount;
 		for (int32 i = 0; i < MyWeapon->AmmoIconsCount; i++)
@@ -200,13 +222,14 @@ void AShooterHUD::DrawWeaponHUD()
 				{
 					PercentLeftInIcon = (AmmoPerIcon - UsedPerIcon) / AmmoPerIcon;
 				}
-				const int32 Color = 128 + 128 * PercentLeftInIcon;
-				Canvas->SetDrawColor(Color, Color, Color, Color);
+				const uint8 Color = FMath::Min(255, FMath::TruncToInt(128 + 128 * PercentLeftInIcon));
+				ClipIconColor = FColor(Color, Color, Color, Color);
 			}
 
 			const float ClipOffset = MyWeapon->PrimaryClipIconOffset * ScaleUI * i;
-			Canvas->DrawIcon(MyWeapon->PrimaryClipIcon, PriClipPosX + ClipOffset, PriClipPosY, ScaleUI);
+			BatchIcon(MyWeapon->PrimaryClipIcon, PriClipPosX + ClipOffset, PriClipPosY, ScaleUI, ClipIconColor);
 		}
+		FlushIcons();
 		Canvas->SetDrawColor(HUDDark);
 		//
 
@@ -256,6 +279,7 @@ void AShooterHUD::DrawWeaponHUD()
 			Canvas->DrawItem(TileItem);
 
 			/** Drawing secondary clip **/
+			FColor SecClipIconColor = FColor::White;
 			const float AmmoPerIcon = SecondaryWeapon->GetAmmoPerClip() / SecondaryWeapon->AmmoIconsCount;
 			for (int32 i = 0; i < SecondaryWeapon->AmmoIconsCount; i++)
 			{
@@ -267,13 +291,14 @@ void AShooterHUD::DrawWeaponHUD()
 					{
 						PercentLeftInIcon = (AmmoPerIcon - UsedPerIcon) / AmmoPerIcon;
 					}
-					const int32 Color = 128 + 128 * PercentLeftInIcon;
-					Canvas->SetDrawColor(Color, Color, Color, Color);
+					const uint8 Color = FMath::Min(255, FMath::TruncToInt(128 + 128 * PercentLeftInIcon));
+					SecClipIconColor = FColor(Color, Color, Color, Color);
 				}
 
 				const float ClipOffset = SecondaryWeapon->SecondaryClipIconOffset * ScaleUI * i;
-				Canvas->DrawIcon(SecondaryWeapon->SecondaryClipIcon, SecClipPosX + ClipOffset, SecClipPosY, ScaleUI);
+				BatchIcon(SecondaryWeapon->SecondaryClipIcon, SecClipPosX + ClipOffset, SecClipPosY, ScaleUI, SecClipIconColor);
 			}
+			FlushIcons();
 
 			//Drawing secondary weapon icon, ammo in the clip and total ammo numbers
 			Canvas->SetDrawColor(FColor::White);
@@ -282,16 +307,18 @@ void AShooterHUD::DrawWeaponHUD()
 			const float TextOffset = 10;
 			float SizeX, SizeY;
 			float TopTextHeight;
-			FString Text = FString::FromInt(SecondaryWeapon->GetCurrentAmmo());
+			SetCachedNumber(SecondaryAmmoText, SecondaryWeapon->GetCurrentAmmo());
 
-			Canvas->StrLen(BigFont,Text, SizeX, SizeY);
+			const FVector2D& SecondaryAmmoTextSize = GetTextSize(SecondaryAmmoText, BigFont);
+			SizeX = SecondaryAmmoTextSize.X;
+			SizeY = SecondaryAmmoTextSize.Y;
 			const float TopTextScale = 0.53f; // of 51pt font
 			TopTextHeight = SizeY * TopTextScale;
 
 			const float TopTextPosX = Canvas->ClipX - Canvas->OrgX - (SecWeaponBoxWidth + Offset * 2 + (BoxWidth + SizeX * TopTextScale) / 2.0f)  * ScaleUI;
 			const float TopTextPosY = SecWeapBgPosY + (SecondaryWeapBg.VL - TopTextHeight) / 2.0f * ScaleUI; 
 
-			TextItem.Text = FText::FromString( Text );
+			TextItem.Text = SecondaryAmmoText.Text;
 			TextItem.Scale = FVector2D( TopTextScale * ScaleUI, TopTextScale * ScaleUI );
 			Canvas->DrawItem( TextItem, TopTextPosX, TopTextPosY );
 		}
@@ -335,37 +362,70 @@ void AShooterHUD::DrawMatchTimerAndPosition()
 		TextItem.EnableShadow( FLinearColor::Black );
 		float SizeX, SizeY;
 		float TextScale = 0.57f;
-		FString Text;
 		TextItem.FontRenderInfo = ShadowedFont;
 		TextItem.Scale = FVector2D( TextScale*ScaleUI, TextScale*ScaleUI );
 		if (MyGameState->GetMatchState() == MatchState::WaitingToStart)
 		{
+			if (!WarmupText.Matches(MyGameState->RemainingTime))
+			{
+				WarmupText.Set(FText::FromString(LOCTEXT("WarmupString","MATCH STARTS IN: ").ToString() + FString::FromInt(MyGameState->RemainingTime)), MyGameState->RemainingTime);
+			}
 			TextItem.Scale = FVector2D( ScaleUI, ScaleUI );
-			Text = LOCTEXT("WarmupString","MATCH STARTS IN: ").ToString() + FString::FromInt(MyGameState->RemainingTime);
 			TextItem.SetColor( HUDLight );
-			TextItem.Text = FText::FromString( Text );			
-			AddMatchInfoString(TextItem);
+			TextItem.Text = WarmupText.Text;
+			AddMatchInfoString(TextItem, GetTextSize(WarmupText, BigFont));
 		}
 		else if (MyGameState->GetMatchState() == MatchState::InProgress)
 		{
-			Text = GetTimeString(MyGameState->RemainingTime);
-			Canvas->StrLen(BigFont, Text, SizeX, SizeY);
+			if (!MatchTimeText.Matches(MyGameState->RemainingTime))
+			{
+				MatchTimeText.Set(FText::FromString(GetTimeString(MyGameState->RemainingTime)), MyGameState->RemainingTime);
+			}
+			SizeY = GetTextSize(MatchTimeText, BigFont).Y;
 
 			TextItem.SetColor( HUDDark );
-			TextItem.Text = FText::FromString( Text );
+			TextItem.Text = MatchTimeText.Text;
 			TextItem.Position = FVector2D( TimerPosX + Offset * 1.5f * ScaleUI + TimerIcon.UL * ScaleUI,
 				TimerPosY + (TimePlaceBg.VL * ScaleUI - SizeY * TextScale * ScaleUI) / 2 );
 			Canvas->DrawItem(TextItem);
 		}
 
 		float BoxWidth = 45.0f * ScaleUI;
-		Text = FString();
 		AShooterPlayerController* MyPC = Cast<AShooterPlayerController>(PlayerOwner);
 		if (MyPC && MyGameState && MatchState == EShooterMatchState::Playing)
 		{
 			AShooterPlayerState* MyPlayerState = Cast<AShooterPlayerState>(MyPC->PlayerState);
 			if (MyPlayerState)
 			{
+				// ranked lists are only read when the ranking changed
+				const int32 RankedVersion = MyGameState->GetRankedVersion();
+				if (RankedVersion != PlaceRankedVersion || PlacePlayerState.Get() != MyPlayerState)
+				{
+					PlaceRankedVersion = RankedVersion;
+					PlacePlayerState = MyPlayerState;
+
+					RankedPlayerMap PlayerStateMap;
+					if (MyGameState->NumTeams > 1)
+					{
+						PlaceCount = 0;
+						for (int32 i=0; i < MyGameState->NumTeams; i++)
+						{
+							MyGameState->GetRankedMap(i,PlayerStateMap);
+							if(PlayerStateMap.Num() > 0)
+							{
+								PlaceCount++;
+							}
+						}
+					}
+					else
+					{
+						MyGameState->GetRankedMap(0,PlayerStateMap);
+						const int32* MyRank = PlayerStateMap.FindKey(MyPlayerState);
+						PlacePosition = MyRank ? *MyRank + 1 : 0;
+						PlaceCount = PlayerStateMap.Num();
+					}
+				}
+
 				if (MyGameState->NumTeams > 1) // team based game
 				{
 					int32 MyTeam = MyPlayerState->GetTeamNum();
@@ -378,32 +438,21 @@ void AShooterHUD::DrawMatchTimerAndPosition()
 							MyPos--;
 						}
 					}
-					int32 NumTeams = 0;
-					for (int32 i=0; i < MyGameState->NumTeams; i++)
-					{
-						RankedPlayerMap PlayerStateMap;
-						MyGameState->GetRankedMap(i,PlayerStateMap);
-						if(PlayerStateMap.Num() > 0)
-						{
-							NumTeams++;
-						}
-					}
-					Text = FString::Printf(TEXT("%d/%d"), MyPos, NumTeams);
+					PlacePosition = MyPos;
 				}
-				else // free for all
+
+				if (!PlaceText.Matches(PlacePosition, PlaceCount))
 				{
-					RankedPlayerMap PlayerStateMap;
-					MyGameState->GetRankedMap(0,PlayerStateMap);
-					const int32* MyRank = PlayerStateMap.FindKey(MyPlayerState);
-					int32 MyPos = MyRank ? *MyRank + 1 : 0;
-					Text = FString::Printf(TEXT("%d/%d"), MyPos, PlayerStateMap.Num());
+					PlaceText.Set(FText::FromString(FString::Printf(TEXT("%d/%d"), PlacePosition, PlaceCount)), PlacePosition, PlaceCount);
 				}
-				Canvas->StrLen(BigFont, Text, SizeX, SizeY);
+				const FVector2D& PlaceTextSize = GetTextSize(PlaceText, BigFont);
+				SizeX = PlaceTextSize.X;
+				SizeY = PlaceTextSize.Y;
 				Canvas->DrawIcon(PlaceIcon,
 					Canvas->ClipX - Canvas->OrgX - BoxWidth  - (SizeX * TextScale + PlaceIcon.UL + Offset/4) * ScaleUI,
 					TimerPosY + (TimePlaceBg.VL - PlaceIcon.VL) / 2.0f * ScaleUI, ScaleUI);
 
-				TextItem.Text = FText::FromString( Text);
+				TextItem.Text = PlaceText.Text;
 				TextItem.Scale = FVector2D(TextScale*ScaleUI, TextScale*ScaleUI);
 				TextItem.FontRenderInfo = ShadowedFont;
 				Canvas->DrawItem( TextItem, Canvas->ClipX - Canvas->OrgX - (BoxWidth  + SizeX * TextScale * ScaleUI),
@@ -432,28 +481,24 @@ void AShooterHUD::DrawKills()
 	TextItem.EnableShadow( FLinearColor::Black );
 
 	float SizeX, SizeY;
-	FString Text = LOCTEXT("Kills", "KILLS:").ToString();
-	Canvas->StrLen(BigFont, Text, SizeX, SizeY);
+	const FVector2D& KillsLabelTextSize = GetTextSize(KillsLabelText, BigFont);
+	SizeX = KillsLabelTextSize.X;
+	SizeY = KillsLabelTextSize.Y;
 
-	TextItem.Text = FText::FromString( Text );
+	TextItem.Text = KillsLabelText.Text;
 	TextItem.Scale = FVector2D( TextScale * ScaleUI, TextScale * ScaleUI );
 	TextItem.FontRenderInfo = ShadowedFont;
 	TextItem.SetColor(HUDDark);
 	Canvas->DrawItem( TextItem, KillsPosX + Offset * ScaleUI + KillsIcon.UL * 1.5f * ScaleUI,
 		KillsPosY + (KillsBg.VL * ScaleUI - SizeY * TextScale * ScaleUI) / 2 );
 
-	if (MyPlayerState)
-	{
-		Text = FString::FromInt(MyPlayerState->GetKills());
-	}
-	else 
-	{
-		Text = FString("0");
-	}
+	SetCachedNumber(KillsText, MyPlayerState->GetKills());
 	TextScale = 0.88f;
 	float BoxWidth = 135.0f * ScaleUI;
-	Canvas->StrLen(BigFont, Text, SizeX, SizeY);
-	TextItem.Text = FText::FromString( Text );
+	const FVector2D& KillsTextSize = GetTextSize(KillsText, BigFont);
+	SizeX = KillsTextSize.X;
+	SizeY = KillsTextSize.Y;
+	TextItem.Text = KillsText.Text;
 	TextItem.Scale = FVector2D( TextScale * ScaleUI, TextScale * ScaleUI );
 	Canvas->DrawItem( TextItem, KillsPosX + KillsBg.UL * ScaleUI - (BoxWidth + SizeX * TextScale * ScaleUI) /2,
 		KillsPosY + (KillsBg.VL* ScaleUI - SizeY * TextScale * ScaleUI) / 2 );
@@ -472,6 +517,8 @@ void AShooterHUD::NotifyEnemyHit()
 
 void AShooterHUD::DrawHUD()
 {
+	SCOPE_CYCLE_COUNTER(STAT_ShooterDrawHUD);
+
 	Super::DrawHUD();
 	if (Canvas == nullptr)
 	{
@@ -499,8 +546,8 @@ void AShooterHUD::DrawHUD()
 	}
 
 
-	// Empty the info item array
-	InfoItems.Empty();
+	// Empty the info item array, keeping its memory for the next frame
+	InfoItems.Reset();
 	float TextScale = 1.0f;
 	// enforce min
 	ScaleUI = FMath::Max(ScaleUI, MinHudScale);
@@ -526,26 +573,34 @@ void AShooterHUD::DrawHUD()
 	// net mode
 	if (GetNetMode() != NM_Standalone)
 	{
-		FString NetModeDesc = (GetNetMode() == NM_Client) ? TEXT("Client") : TEXT("Server");
+		FNamedOnlineSession * Session = NULL;
 		IOnlineSubsystem * OnlineSubsystem = IOnlineSubsystem::Get();
 		if(OnlineSubsystem)
 		{
 			IOnlineSessionPtr SessionSubsystem = OnlineSubsystem->GetSessionInterface();
 			if(SessionSubsystem.IsValid())
 			{
-				FNamedOnlineSession * Session = SessionSubsystem->GetNamedSession(GameSessionName);
-				if(Session)
-				{
-					NetModeDesc += TEXT("\nSession: ");
-					NetModeDesc += Session->SessionInfo->GetSessionId().ToString();
-				}
+				Session = SessionSubsystem->GetNamedSession(GameSessionName);
 			}
 
 		}
 
-		NetModeDesc += FString::Printf( TEXT( "\nVersion: %i, %s, %s" ), GEngineNetVersion, UTF8_TO_TCHAR(__DATE__), UTF8_TO_TCHAR(__TIME__) );
+		// description only changes with net mode and session
+		const bool bHasSession = Session && Session->SessionInfo.IsValid();
+		if (!NetModeText.Matches(GetNetMode(), bHasSession))
+		{
+			FString NetModeDesc = (GetNetMode() == NM_Client) ? TEXT("Client") : TEXT("Server");
+			if (bHasSession)
+			{
+				NetModeDesc += TEXT("\nSession: ");
+				NetModeDesc += Session->SessionInfo->GetSessionId().ToString();
+			}
+
+			NetModeDesc += FString::Printf( TEXT( "\nVersion: %i, %s, %s" ), GEngineNetVersion, UTF8_TO_TCHAR(__DATE__), UTF8_TO_TCHAR(__TIME__) );
+			NetModeText.Set(FText::FromString(NetModeDesc), GetNetMode(), bHasSession);
+		}
 
-		DrawDebugInfoString(NetModeDesc, Canvas->OrgX + Offset*ScaleUI, Canvas->OrgY + 5*Offset*ScaleUI, true, true, HUDLight);
+		DrawDebugInfoString(NetModeText, Canvas->OrgX + Offset*ScaleUI, Canvas->OrgY + 5*Offset*ScaleUI, true, true, HUDLight);
 	}
 
 	DrawMatchTimerAndPosition();
@@ -567,14 +622,13 @@ void AShooterHUD::DrawHUD()
 		else
 		{
 			// respawn
-			FString Text = LOCTEXT("WaitingForRespawn", "WAITING FOR RESPAWN").ToString();
 			FCanvasTextItem TextItem( FVector2D::ZeroVector, FText::GetEmpty(), BigFont, HUDDark );
 			TextItem.EnableShadow( FLinearColor::Black );
-			TextItem.Text = FText::FromString( Text );
+			TextItem.Text = RespawnText.Text;
 			TextItem.Scale = FVector2D( TextScale * ScaleUI, TextScale * ScaleUI );
 			TextItem.FontRenderInfo = ShadowedFont;
 			TextItem.SetColor(HUDLight);
-			AddMatchInfoString(TextItem);
+			AddMatchInfoString(TextItem, GetTextSize(RespawnText, BigFont));
 		}
 
 		DrawDeathMessages();
@@ -588,18 +642,15 @@ void AShooterHUD::DrawHUD()
 		const float CurrentTime = GetWorld()->GetTimeSeconds();
 		if (CurrentTime - NoAmmoNotifyTime >= 0 && CurrentTime - NoAmmoNotifyTime <= NoAmmoFadeOutTime)
 		{
-			FString Text = FString();
-
 			const float Alpha = FMath::Min(1.0f, 1 - (CurrentTime - NoAmmoNotifyTime) / NoAmmoFadeOutTime);
-			Text = LOCTEXT("NoAmmo", "NO AMMO").ToString();
 			
 			FCanvasTextItem TextItem( FVector2D::ZeroVector, FText::GetEmpty(), BigFont, HUDDark );
 			TextItem.EnableShadow( FLinearColor::Black );
-			TextItem.Text = FText::FromString( Text );
+			TextItem.Text = NoAmmoText.Text;
 			TextItem.Scale = FVector2D( TextScale * ScaleUI, TextScale * ScaleUI );
 			TextItem.FontRenderInfo = ShadowedFont;
 			TextItem.SetColor(FLinearColor(0.75f, 0.125f, 0.125f, Alpha ));
-			AddMatchInfoString(TextItem);			
+			AddMatchInfoString(TextItem, GetTextSize(NoAmmoText, BigFont));
 		}
 	}
 
@@ -608,11 +659,12 @@ void AShooterHUD::DrawHUD()
 	
 }
 
-void AShooterHUD::DrawDebugInfoString(const FString& Text, float PosX, float PosY, bool bAlignLeft, bool bAlignTop, const FColor& TextColor)
+void AShooterHUD::DrawDebugInfoString(FHUDCachedText& Text, float PosX, float PosY, bool bAlignLeft, bool bAlignTop, const FColor& TextColor)
 {
 #if !UE_BUILD_SHIPPING
-	float SizeX, SizeY;
-	Canvas->StrLen(NormalFont, Text, SizeX, SizeY);
+	const FVector2D& TextSize = GetTextSize(Text, NormalFont);
+	const float SizeX = TextSize.X;
+	const float SizeY = TextSize.Y;
 
 	const float UsePosX = bAlignLeft ? PosX : PosX - SizeX;
 	const float UsePosY = bAlignTop ? PosY : PosY - SizeY;
@@ -629,7 +681,7 @@ void AShooterHUD::DrawDebugInfoString(const FString& Text, float PosX, float Pos
 	TileItem.BlendMode = SE_BLEND_Translucent;
 	Canvas->DrawItem( TileItem );
 
-	FCanvasTextItem TextItem( FVector2D( UsePosX, UsePosY), FText::FromString( Text ), NormalFont, TextColor );
+	FCanvasTextItem TextItem( FVector2D( UsePosX, UsePosY), Text.Text, NormalFont, TextColor );
 	TextItem.EnableShadow( FLinearColor::Black );
 	TextItem.FontRenderInfo = ShadowedFont;
 	TextItem.Scale = FVector2D( ScaleUI, ScaleUI );
@@ -665,7 +717,7 @@ void AShooterHUD::DrawCrosshair()
 			}
 			float CenterX = Canvas->ClipX / 2;
 			float CenterY = Canvas->ClipY / 2;
-			Canvas->SetDrawColor(255,255,255,192);
+			const FColor CrosshairColor(255,255,255,192);
 
 			FCanvasIcon* CurrentCrosshair[5];
  			for (int32 i=0; i< 5; i++)
@@ -686,41 +738,40 @@ void AShooterHUD::DrawCrosshair()
 
 			if (Pawn->IsTargeting() && MyWeapon->UseLaserDot)
 			{
-				Canvas->SetDrawColor(255,0,0,192);
-				Canvas->DrawIcon(*CurrentCrosshair[EShooterCrosshairDirection::Center],
+				BatchIcon(*CurrentCrosshair[EShooterCrosshairDirection::Center],
 					CenterX - (*CurrentCrosshair[EShooterCrosshairDirection::Center]).UL*ScaleUI / 2.0f,
-					CenterY - (*CurrentCrosshair[EShooterCrosshairDirection::Center]).VL*ScaleUI / 2.0f, ScaleUI);
+					CenterY - (*CurrentCrosshair[EShooterCrosshairDirection::Center]).VL*ScaleUI / 2.0f, ScaleUI, FColor(255,0,0,192));
 			}
 			else
 			{
-				Canvas->DrawIcon(*CurrentCrosshair[EShooterCrosshairDirection::Center], 
+				BatchIcon(*CurrentCrosshair[EShooterCrosshairDirection::Center], 
 					CenterX - (*CurrentCrosshair[EShooterCrosshairDirection::Center]).UL*ScaleUI / 2.0f, 
-					CenterY - (*CurrentCrosshair[EShooterCrosshairDirection::Center]).VL*ScaleUI / 2.0f, ScaleUI);
+					CenterY - (*CurrentCrosshair[EShooterCrosshairDirection::Center]).VL*ScaleUI / 2.0f, ScaleUI, CrosshairColor);
 
-				Canvas->DrawIcon(*CurrentCrosshair[EShooterCrosshairDirection::Left],
+				BatchIcon(*CurrentCrosshair[EShooterCrosshairDirection::Left],
 					CenterX - 1 - (*CurrentCrosshair[EShooterCrosshairDirection::Left]).UL * ScaleUI - CrossSpread * ScaleUI, 
-					CenterY - (*CurrentCrosshair[EShooterCrosshairDirection::Left]).VL*ScaleUI / 2.0f, ScaleUI);
-				Canvas->DrawIcon(*CurrentCrosshair[EShooterCrosshairDirection::Right], 
+					CenterY - (*CurrentCrosshair[EShooterCrosshairDirection::Left]).VL*ScaleUI / 2.0f, ScaleUI, CrosshairColor);
+				BatchIcon(*CurrentCrosshair[EShooterCrosshairDirection::Right], 
 					CenterX + CrossSpread * ScaleUI, 
-					CenterY - (*CurrentCrosshair[EShooterCrosshairDirection::Right]).VL * ScaleUI / 2.0f, ScaleUI);
+					CenterY - (*CurrentCrosshair[EShooterCrosshairDirection::Right]).VL * ScaleUI / 2.0f, ScaleUI, CrosshairColor);
 
-				Canvas->DrawIcon(*CurrentCrosshair[EShooterCrosshairDirection::Top], 
+				BatchIcon(*CurrentCrosshair[EShooterCrosshairDirection::Top], 
 					CenterX - (*CurrentCrosshair[EShooterCrosshairDirection::Top]).UL * ScaleUI / 2.0f,
-					CenterY - 1 - (*CurrentCrosshair[EShooterCrosshairDirection::Top]).VL * ScaleUI - CrossSpread * ScaleUI, ScaleUI);
-				Canvas->DrawIcon(*CurrentCrosshair[EShooterCrosshairDirection::Bottom],
+					CenterY - 1 - (*CurrentCrosshair[EShooterCrosshairDirection::Top]).VL * ScaleUI - CrossSpread * ScaleUI, ScaleUI, CrosshairColor);
+				BatchIcon(*CurrentCrosshair[EShooterCrosshairDirection::Bottom],
 					CenterX - (*CurrentCrosshair[EShooterCrosshairDirection::Bottom]).UL * ScaleUI / 2.0f,
-					CenterY + CrossSpread * ScaleUI, ScaleUI);
+					CenterY + CrossSpread * ScaleUI, ScaleUI, CrosshairColor);
 			}
 
 			if (CurrentTime - LastEnemyHitTime >= 0 && CurrentTime - LastEnemyHitTime <= LastEnemyHitDisplayTime)
 			{
 				const float Alpha = FMath::Min(1.0f, 1 - (CurrentTime - LastEnemyHitTime) / LastEnemyHitDisplayTime);
-				Canvas->SetDrawColor(255,255,255,255*Alpha);
 
-				Canvas->DrawIcon(HitNotifyCrosshair, 
+				BatchIcon(HitNotifyCrosshair, 
 					CenterX - HitNotifyCrosshair.UL*ScaleUI / 2.0f, 
-					CenterY - HitNotifyCrosshair.VL*ScaleUI / 2.0f, ScaleUI);
+					CenterY - HitNotifyCrosshair.VL*ScaleUI / 2.0f, ScaleUI, FColor(255,255,255,255*Alpha));
 			}
+			FlushIcons();
 		}
 	}
 }
@@ -747,8 +798,7 @@ void AShooterHUD::DrawDeathMessages()
 	const FColor RedTeamColor = FColor(152, 70, 70, 255);
 	const FColor OwnerColor = HUDLight;
 
-	const FString KilledText = LOCTEXT("killed"," killed ").ToString();
-	FVector2D KilledTextSize(0.0f, 0.0f);
+	const FVector2D KilledTextSize = GetTextSize(KilledText, NormalFont);
 
 	const float GameTime = GetWorld()->GetTimeSeconds();
 	const float LinePadding = 6.0f;
@@ -760,23 +810,19 @@ void AShooterHUD::DrawDeathMessages()
 	// draw messages
 	float CurrentY = InitialY;
 
-	Canvas->StrLen(NormalFont, KilledText, KilledTextSize.X, KilledTextSize.Y);
-
 	FCanvasTextItem TextItem( FVector2D::ZeroVector, FText::GetEmpty(), NormalFont, HUDDark );
 	TextItem.EnableShadow( FLinearColor::Black );
 	for (int32 i = DeathMessages.Num() - 1; i >= 0; i--)
 	{
-		const FDeathMessage& Message = DeathMessages[i];
+		FDeathMessage& Message = DeathMessages[i];
 		float CurrentX = InitialX;
-		FVector2D KillerSize(0.0f, 0.0f);
-		FVector2D VictimNameSize(0.0f, 0.0f);
 		float TextScale = 1.00f;
-		Canvas->StrLen(NormalFont, Message.KillerDesc, KillerSize.X, KillerSize.Y);
+		const FVector2D KillerSize = GetTextSize(Message.KillerDesc, NormalFont);
 		TextItem.Scale = FVector2D( TextScale * ScaleUI, TextScale * ScaleUI );
 		TextItem.FontRenderInfo = ShadowedFont;
 		TextItem.SetColor(Message.bKillerIsOwner == true ? HUDLight : ( Message.KillerTeamNum == 0 ? RedTeamColor : BlueTeamColor));
 
-		TextItem.Text = FText::FromString( Message.KillerDesc );
+		TextItem.Text = Message.KillerDesc.Text;
 		Canvas->DrawItem(TextItem, CurrentX, CurrentY);
 		CurrentX += KillerSize.X * TextScale * ScaleUI;
 		
@@ -791,7 +837,7 @@ void AShooterHUD::DrawDeathMessages()
 		}
 		else
 		{
-			TextItem.Text = FText::FromString( KilledText );
+			TextItem.Text = KilledText.Text;
 			TextItem.Scale = FVector2D( TextScale * ScaleUI, TextScale * ScaleUI );
 			TextItem.FontRenderInfo = ShadowedFont;
 			TextItem.SetColor(HUDDark);
@@ -802,8 +848,7 @@ void AShooterHUD::DrawDeathMessages()
 			
 		TextItem.SetColor(Message.bVictimIsOwner == true ? HUDLight : (Message.VictimTeamNum == 0 ? RedTeamColor : BlueTeamColor));		
 
-		Canvas->StrLen(NormalFont, Message.VictimDesc, VictimNameSize.X, VictimNameSize.Y);
-		TextItem.Text = FText::FromString( Message.VictimDesc );
+		TextItem.Text = Message.VictimDesc.Text;
 		Canvas->DrawItem( TextItem, CurrentX, CurrentY );
 		CurrentY -= (KilledTextSize.Y + LinePadding) * TextScale * ScaleUI;
 	}
@@ -827,8 +872,8 @@ void AShooterHUD::ShowDeathMessage(class AShooterPlayerState* KillerPlayerState,
 			}
 
 			FDeathMessage NewMessage;
-			NewMessage.KillerDesc = KillerPlayerState->GetShortPlayerName();
-			NewMessage.VictimDesc = VictimPlayerState->GetShortPlayerName();
+			NewMessage.KillerDesc.Set(FText::FromString(KillerPlayerState->GetShortPlayerName()));
+			NewMessage.VictimDesc.Set(FText::FromString(VictimPlayerState->GetShortPlayerName()));
 			NewMessage.KillerTeamNum = KillerPlayerState->GetTeamNum();
 			NewMessage.VictimTeamNum = VictimPlayerState->GetTeamNum();
 			NewMessage.bKillerIsOwner = MyPlayerState == KillerPlayerState;
@@ -841,7 +886,7 @@ void AShooterHUD::ShowDeathMessage(class AShooterPlayerState* KillerPlayerState,
 			if (KillerPlayerState == MyPlayerState && VictimPlayerState != MyPlayerState)
 			{
 				LastKillTime = GetWorld()->GetTimeSeconds();
-				CenteredKillMessage = FText::FromString(NewMessage.VictimDesc);
+				CenteredKillMessage = NewMessage.VictimDesc;
 			}
 		}
 	}
@@ -918,12 +963,12 @@ void AShooterHUD::DrawHitIndicator()
 		{
 			const float TimeModifier = FMath::Max(0.0f, 1 - (CurrentTime - HitNotifyData[i].HitTime) / HitNotifyDisplayTime);
 			const float Alpha = TimeModifier * HitNotifyData[i].HitPercentage;
-			Canvas->SetDrawColor(255, 255, 255, FMath::Clamp(FMath::TruncToInt(Alpha * 255 * 1.5f), 0, 255));
-			Canvas->DrawIcon(HitNotifyIcon[i], 
+			BatchIcon(HitNotifyIcon[i], 
 				StartX + (HitNotifyIcon[i].U - HitNotifyTexture->GetSizeX() / 2 + Offsets[i].X) * ScaleUI,
 				StartY + (HitNotifyIcon[i].V - HitNotifyTexture->GetSizeY() / 2 + Offsets[i].Y) * ScaleUI,
-				ScaleUI);
+				ScaleUI, FColor(255, 255, 255, FMath::Clamp(FMath::TruncToInt(Alpha * 255 * 1.5f), 0, 255)));
 		}
+		FlushIcons();
 	}
 }
 
@@ -1081,6 +1126,91 @@ void AShooterHUD::MakeUV(FCanvasIcon& Icon, FVector2D& UV0, FVector2D& UV1, uint
 	}
 }
 
+const FVector2D& AShooterHUD::GetTextSize(FHUDCachedText& Text, UFont* Font)
+{
+	if (Text.MeasuredFont != Font)
+	{
+		Canvas->StrLen(Font, Text.Text.ToString(), Text.Size.X, Text.Size.Y);
+		Text.MeasuredFont = Font;
+	}
+	return Text.Size;
+}
+
+void AShooterHUD::BatchIcon(const FCanvasIcon& Icon, float X, float Y, float Scale, const FColor& Color)
+{
+	const float SizeX = Icon.UL * Scale;
+	const float SizeY = Icon.VL * Scale;
+	if (Icon.Texture == NULL || SizeX <= 0.0f || SizeY <= 0.0f)
+	{
+		return;
+	}
+
+	// same clipping as Canvas->DrawTile: reject icons past the clip edges, trim the ones crossing them
+	const float MaxX = Canvas->OrgX + Canvas->ClipX;
+	const float MaxY = Canvas->OrgY + Canvas->ClipY;
+	if (X >= MaxX || Y >= MaxY)
+	{
+		return;
+	}
+	const float ClippedSizeX = FMath::Min(SizeX, MaxX - X);
+	const float ClippedSizeY = FMath::Min(SizeY, MaxY - Y);
+
+	const float Width = Icon.Texture->GetSurfaceWidth();
+	const float Height = Icon.Texture->GetSurfaceHeight();
+
+	FHUDBatchedIcon& BatchedIcon = BatchedIcons[BatchedIcons.AddUninitialized()];
+	BatchedIcon.Texture = Icon.Texture;
+	BatchedIcon.Position = FVector2D(X, Y);
+	BatchedIcon.Size = FVector2D(ClippedSizeX, ClippedSizeY);
+	BatchedIcon.UV0 = FVector2D(Icon.U / Width, Icon.V / Height);
+	BatchedIcon.UV1 = FVector2D((Icon.U + Icon.UL * ClippedSizeX / SizeX) / Width, (Icon.V + Icon.VL * ClippedSizeY / SizeY) / Height);
+	BatchedIcon.Color = FLinearColor(Color);
+}
+
+void AShooterHUD::FlushIcons()
+{
+	FCanvas* const DrawCanvas = Canvas ? Canvas->Canvas : NULL;
+	if (DrawCanvas)
+	{
+		const FHitProxyId HitProxyId = DrawCanvas->GetHitProxyId();
+
+		// submit runs of icons sharing a texture at once, instead of one tile item per icon
+		int32 RunStart = 0;
+		while (RunStart < BatchedIcons.Num())
+		{
+			UTexture* const Texture = BatchedIcons[RunStart].Texture;
+			int32 RunEnd = RunStart + 1;
+			while (RunEnd < BatchedIcons.Num() && BatchedIcons[RunEnd].Texture == Texture)
+			{
+				RunEnd++;
+			}
+
+			const FTexture* const TextureResource = Texture->Resource;
+			if (TextureResource)
+			{
+				FBatchedElements* BatchedElements = DrawCanvas->GetBatchedElements(FCanvas::ET_Triangle, NULL, TextureResource, SE_BLEND_Translucent);
+				BatchedElements->ReserveVertices((RunEnd - RunStart) * 4);
+				BatchedElements->ReserveTriangles((RunEnd - RunStart) * 2, TextureResource, SE_BLEND_Translucent);
+
+				for (int32 i = RunStart; i < RunEnd; i++)
+				{
+					const FHUDBatchedIcon& Icon = BatchedIcons[i];
+					const FVector2D BottomRight = Icon.Position + Icon.Size;
+					const int32 V00 = BatchedElements->AddVertex(FVector4(Icon.Position.X, Icon.Position.Y, 0.0f, 1.0f), FVector2D(Icon.UV0.X, Icon.UV0.Y), Icon.Color, HitProxyId);
+					const int32 V10 = BatchedElements->AddVertex(FVector4(BottomRight.X, Icon.Position.Y, 0.0f, 1.0f), FVector2D(Icon.UV1.X, Icon.UV0.Y), Icon.Color, HitProxyId);
+					const int32 V01 = BatchedElements->AddVertex(FVector4(Icon.Position.X, BottomRight.Y, 0.0f, 1.0f), FVector2D(Icon.UV0.X, Icon.UV1.Y), Icon.Color, HitProxyId);
+					const int32 V11 = BatchedElements->AddVertex(FVector4(BottomRight.X, BottomRight.Y, 0.0f, 1.0f), FVector2D(Icon.UV1.X, Icon.UV1.Y), Icon.Color, HitProxyId);
+					BatchedElements->AddTriangle(V00, V10, V11, TextureResource, SE_BLEND_Translucent);
+					BatchedElements->AddTriangle(V00, V11, V01, TextureResource, SE_BLEND_Translucent);
+				}
+			}
+			RunStart = RunEnd;
+		}
+	}
+
+	BatchedIcons.Reset();
+}
+
 bool AShooterHUD::TryCreateChatWidget()
 {
 	bool bCreated = false;
@@ -1109,9 +1239,9 @@ bool AShooterHUD::IsMatchOver() const
 	return GetMatchState() == EShooterMatchState::Lost || GetMatchState() == EShooterMatchState::Won;
 }
 
-void AShooterHUD::AddMatchInfoString(const FCanvasTextItem InInfoItem )
+void AShooterHUD::AddMatchInfoString(const FCanvasTextItem InInfoItem, const FVector2D& InTextSize)
 {
-	InfoItems.Add(InInfoItem);
+	InfoItems.Add(FHUDInfoItem(InInfoItem, InTextSize));
 }
 
 float AShooterHUD::ShowInfoItems(float YOffset, float ScaleUI, float TextScale)
@@ -1121,12 +1251,11 @@ float AShooterHUD::ShowInfoItems(float YOffset, float ScaleUI, float TextScale)
 
 	for (int32 iItem = 0; iItem < InfoItems.Num() ; iItem++)
 	{
-		float X = 0.0f;
-		float SizeX, SizeY; 
-		Canvas->StrLen(InfoItems[iItem].Font, InfoItems[iItem].Text.ToString(), SizeX, SizeY);
-		X = CanvasCentre - ( SizeX * InfoItems[iItem].Scale.X)/2.0f;
-		Canvas->DrawItem(InfoItems[iItem], X, Y);
-		Y += SizeY * InfoItems[iItem].Scale.Y;
+		FCanvasTextItem& TextItem = InfoItems[iItem].TextItem;
+		const FVector2D& Size = InfoItems[iItem].Size;
+		const float X = CanvasCentre - ( Size.X * TextItem.Scale.X)/2.0f;
+		Canvas->DrawItem(TextItem, X, Y);
+		Y += Size.Y * TextItem.Scale.Y;
 	}
 	return Y;
 }
@@ -1142,18 +1271,18 @@ float AShooterHUD::DrawRecentlyKilledPlayer()
 		{
 			FCanvasTextItem TextItem(FVector2D::ZeroVector, FText::GetEmpty(), NormalFont, HUDDark);
 			TextItem.EnableShadow(FLinearColor::Black);
-			float SizeX, SizeY;
 			float TextScale = 0.71f;
-			FString Text = CenteredKillMessage.ToString();
 
 			const float Alpha = FMath::Min(1.0f, 1 - (CurrentTime - LastKillTime) / KillFadeOutTime);
 			TextItem.Font = BigFont;
-			Canvas->StrLen(BigFont, Text, SizeX, SizeY);
+			const FVector2D& CenteredKillMessageSize = GetTextSize(CenteredKillMessage, BigFont);
+			const float SizeX = CenteredKillMessageSize.X;
+			const float SizeY = CenteredKillMessageSize.Y;
 			Canvas->SetDrawColor(255, 255, 255, 255 * Alpha);
 			Canvas->DrawIcon(KilledIcon, Canvas->OrgX + Canvas->ClipX / 2 - (KilledIcon.UL * ScaleUI + SizeX * TextScale * ScaleUI) / 2.0f,
 				DrawPos - (Offset * 4 - SizeY / 2 * TextScale + KilledIcon.VL / 2) * ScaleUI, ScaleUI);
 			TextItem.SetColor(FColor(HUDLight.R, HUDLight.G, HUDLight.B, HUDLight.A*Alpha));
-			TextItem.Text = FText::FromString(Text);
+			TextItem.Text = CenteredKillMessage.Text;
 			TextItem.Scale = FVector2D(TextScale*ScaleUI, TextScale*ScaleUI);
 			LastYPos = (DrawPos - (Offset * 4 * ScaleUI)) + SizeY;
 			Canvas->DrawItem(TextItem, Canvas->OrgX + Canvas->ClipX / 2 - (KilledIcon.UL * ScaleUI + SizeX * TextScale * ScaleUI) / 2.0f + KilledIcon.UL * ScaleUI,
@@ -17,9 +17,13 @@ void FShooterStyle::Initialize()
 
 void FShooterStyle::Shutdown()
 {
-	FSlateStyleRegistry::UnRegisterSlateStyle( *ShooterStyleInstance );
-	ensure( ShooterStyleInstance.IsUnique() );
-	ShooterStyleInstance.Reset();
+	// never created on dedicated servers
+	if ( ShooterStyleInstance.IsValid() )
+	{
+		FSlateStyleRegistry::UnRegisterSlateStyle( *ShooterStyleInstance );
+		ensure( ShooterStyleInstance.IsUnique() );
+		ShooterStyleInstance.Reset();
+	}
 }
 
 FName FShooterStyle::GetStyleSetName()
@@ -26,8 +26,7 @@ void SShooterScoreboardWidget::Construct(const FArguments& InArgs)
 
 	ScoreboardStartTime = FPlatformTime::Seconds();
 	MatchState = InArgs._MatchState.Get();
-
-	UpdatePlayerStateMaps();
+	LastRankedVersion = INDEX_NONE;
 	
 	Columns.Add(FColumnData(LOCTEXT("KillsColumn", "Kills").ToString(),
 		ScoreboardStyle->KillStatColor,
@@ -106,7 +105,8 @@ void SShooterScoreboardWidget::Construct(const FArguments& InArgs)
 	[
 		SAssignNew(ScoreboardData, SVerticalBox)
 	];
-	UpdateScoreboardGrid();
+	UpdatePlayerStateMaps();
+	UpdateRowText();
 
 	SBorder::Construct(
 		SBorder::FArguments()
@@ -184,13 +184,23 @@ FString SShooterScoreboardWidget::GetMatchOutcomeText() const
 void SShooterScoreboardWidget::UpdateScoreboardGrid()
 {
 	ScoreboardData->ClearChildren();
+	TeamRowBoxes.Reset();
+	TeamRowOrder.Reset();
+	TeamRowOrder.SetNum(PlayerStateMaps.Num());
+	TeamTotalValues.Init(MIN_int32, PlayerStateMaps.Num());
+	TeamTotalText.Init(FText::GetEmpty(), PlayerStateMaps.Num());
+	TeamTotalScratch.Init(0, PlayerStateMaps.Num());
+
 	for (uint8 TeamNum = 0; TeamNum < PlayerStateMaps.Num(); TeamNum++)
 	{
-		//Player rows from each team
+		//Player rows from each team, filled by UpdatePlayerRows
+		TSharedPtr<SVerticalBox> TeamRows;
 		ScoreboardData->AddSlot() .AutoHeight()
 			[
-				MakePlayerRows(TeamNum)
+				SAssignNew(TeamRows, SVerticalBox)
 			];
+		TeamRowBoxes.Add(TeamRows);
+
 		//If we have more than one team, we are playing team based game mode, add totals
 		if (PlayerStateMaps.Num() > 1 && PlayerStateMaps[TeamNum].Num() > 0)
 		{
@@ -258,15 +268,139 @@ void SShooterScoreboardWidget::UpdateScoreboardGrid()
 	}
 }
 
+void SShooterScoreboardWidget::UpdatePlayerRows()
+{
+	for (TMap<int32, TSharedRef<FScoreboardRow> >::TIterator It(PlayerRows); It; ++It)
+	{
+		It.Value()->bInRanking = false;
+	}
+
+	TArray<int32> NewRowOrder;
+	for (uint8 TeamNum = 0; TeamNum < PlayerStateMaps.Num(); TeamNum++)
+	{
+		// rows are matched by PlayerId, so players keep their widgets while their rank changes
+		NewRowOrder.Reset();
+		for (int32 Rank = 0; Rank < PlayerStateMaps[TeamNum].Num(); Rank++)
+		{
+			AShooterPlayerState* PlayerState = PlayerStateMaps[TeamNum].FindRef(Rank).Get();
+			if (PlayerState == NULL)
+			{
+				continue;
+			}
+
+			TSharedRef<FScoreboardRow>* ExistingRow = PlayerRows.Find(PlayerState->PlayerId);
+			if (ExistingRow == NULL || (*ExistingRow)->PlayerState.Get() != PlayerState)
+			{
+				TSharedRef<FScoreboardRow> NewRow = MakeShareable(new FScoreboardRow());
+				NewRow->PlayerState = PlayerState;
+				NewRow->ColumnValues.Init(MIN_int32, Columns.Num());
+				NewRow->ColumnText.Init(FText::GetEmpty(), Columns.Num());
+				UpdateRowText(*NewRow);
+				PlayerRowWidgets.Add(PlayerState->PlayerId, MakePlayerRow(NewRow));
+				ExistingRow = &PlayerRows.Add(PlayerState->PlayerId, NewRow);
+			}
+
+			FScoreboardRow& Row = ExistingRow->Get();
+			Row.TeamPlayer = FTeamPlayer(TeamNum, Rank);
+			Row.bInRanking = true;
+			NewRowOrder.Add(PlayerState->PlayerId);
+		}
+
+		// only touch the container if somebody joined, left or moved
+		if (TeamRowBoxes.IsValidIndex(TeamNum) && NewRowOrder != TeamRowOrder[TeamNum])
+		{
+			TeamRowBoxes[TeamNum]->ClearChildren();
+			for (int32 i = 0; i < NewRowOrder.Num(); i++)
+			{
+				TeamRowBoxes[TeamNum]->AddSlot() .AutoHeight()
+					[
+						PlayerRowWidgets.FindChecked(NewRowOrder[i])
+					];
+			}
+			TeamRowOrder[TeamNum] = NewRowOrder;
+		}
+	}
+
+	for (TMap<int32, TSharedRef<FScoreboardRow> >::TIterator It(PlayerRows); It; ++It)
+	{
+		if (!It.Value()->bInRanking)
+		{
+			PlayerRowWidgets.Remove(It.Key());
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void SShooterScoreboardWidget::UpdateRowText()
+{
+	for (int32 i = 0; i < TeamTotalScratch.Num(); i++)
+	{
+		TeamTotalScratch[i] = 0;
+	}
+
+	for (TMap<int32, TSharedRef<FScoreboardRow> >::TIterator It(PlayerRows); It; ++It)
+	{
+		FScoreboardRow& Row = It.Value().Get();
+		UpdateRowText(Row);
+
+		AShooterPlayerState* PlayerState = Row.PlayerState.Get();
+		if (PlayerState && TeamTotalScratch.IsValidIndex(Row.TeamPlayer.TeamNum))
+		{
+			TeamTotalScratch[Row.TeamPlayer.TeamNum] += Columns.Last().AttributeGetter.Execute(PlayerState);
+		}
+	}
+
+	for (int32 TeamNum = 0; TeamNum < TeamTotalScratch.Num(); TeamNum++)
+	{
+		UpdateCachedStat(TeamTotalScratch[TeamNum], TeamTotalValues[TeamNum], TeamTotalText[TeamNum]);
+	}
+}
+
+void SShooterScoreboardWidget::UpdateRowText(FScoreboardRow& Row)
+{
+	AShooterPlayerState* PlayerState = Row.PlayerState.Get();
+	if (PlayerState == NULL)
+	{
+		return;
+	}
+
+	if (PlayerState->PlayerName != Row.PlayerName)
+	{
+		Row.PlayerName = PlayerState->PlayerName;
+		Row.ShortName = PlayerState->GetShortPlayerName();
+		Row.NameText = FText::FromString(Row.ShortName);
+	}
+
+	for (int32 ColIdx = 0; ColIdx < Columns.Num(); ColIdx++)
+	{
+		UpdateCachedStat(Columns[ColIdx].AttributeGetter.Execute(PlayerState), Row.ColumnValues[ColIdx], Row.ColumnText[ColIdx]);
+	}
+}
+
+void SShooterScoreboardWidget::UpdateCachedStat(int32 Value, int32& CachedValue, FText& CachedText) const
+{
+	const int32 DisplayedValue = LerpForCountup(Value);
+	if (DisplayedValue != CachedValue)
+	{
+		CachedValue = DisplayedValue;
+		CachedText = FText::AsNumber(DisplayedValue);
+	}
+}
+
 void SShooterScoreboardWidget::UpdatePlayerStateMaps()
 {
+	SCOPE_CYCLE_COUNTER(STAT_ShooterUpdatePlayerStateMaps);
+
 	if (PCOwner.IsValid())
 	{
 		AShooterGameState* const GameState = Cast<AShooterGameState>(PCOwner->GetWorld()->GameState);
-		if (GameState)
+		const int32 RankedVersion = GameState ? GameState->GetRankedVersion() : INDEX_NONE;
+		if (GameState && RankedVersion != LastRankedVersion)
 		{
-			bool bRequiresWidgetUpdate = false;
+			LastRankedVersion = RankedVersion;
+
 			const int32 NumTeams = FMath::Max(GameState->NumTeams, 1);
+			bool bRequiresWidgetUpdate = (NumTeams != TeamRowBoxes.Num());
 			LastTeamPlayerCount.Reset();
 			LastTeamPlayerCount.AddZeroed(PlayerStateMaps.Num());
 			for (int32 i = 0; i < PlayerStateMaps.Num(); i++)
@@ -281,7 +415,8 @@ void SShooterScoreboardWidget::UpdatePlayerStateMaps()
 			{
 				GameState->GetRankedMap(i, PlayerStateMaps[i]);
 
-				if (LastTeamPlayerCount.Num() > 0 && PlayerStateMaps[i].Num() != LastTeamPlayerCount[i])
+				// totals are only shown for teams with players
+				if (LastTeamPlayerCount.IsValidIndex(i) && (PlayerStateMaps[i].Num() > 0) != (LastTeamPlayerCount[i] > 0))
 				{
 					bRequiresWidgetUpdate = true;
 				}
@@ -290,6 +425,7 @@ void SShooterScoreboardWidget::UpdatePlayerStateMaps()
 			{
 				UpdateScoreboardGrid();
 			}
+			UpdatePlayerRows();
 		}
 	}
 
@@ -299,6 +435,7 @@ void SShooterScoreboardWidget::UpdatePlayerStateMaps()
 void SShooterScoreboardWidget::Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime)
 {
 	UpdatePlayerStateMaps();
+	UpdateRowText();
 }
 
 bool SShooterScoreboardWidget::SupportsKeyboardFocus() const
@@ -366,12 +503,12 @@ void SShooterScoreboardWidget::PlaySound(const FSlateSound& SoundToPlay) const
 	}
 }
 
-FReply SShooterScoreboardWidget::OnMouseOverPlayer(const FGeometry& Geometry, const FPointerEvent& Event, const FTeamPlayer TeamPlayer)
+FReply SShooterScoreboardWidget::OnMouseOverPlayer(const FGeometry& Geometry, const FPointerEvent& Event, TSharedRef<FScoreboardRow> Row)
 {
 #if INTERACTIVE_SCOREBOARD
-	if( !(SelectedPlayer == TeamPlayer) )
+	if( !(SelectedPlayer == Row->TeamPlayer) )
 	{
-		SelectedPlayer = TeamPlayer;
+		SelectedPlayer = Row->TeamPlayer;
 		PlaySound(ScoreboardStyle->PlayerChangeSound);
 	}
 #endif
@@ -565,30 +702,21 @@ bool SShooterScoreboardWidget::ProfileUIOpened() const
 	return false;
 }
 
-EVisibility SShooterScoreboardWidget::PlayerPresenceToItemVisibility(const FTeamPlayer TeamPlayer) const
-{
-	return GetSortedPlayerState(TeamPlayer) ? EVisibility::Visible : EVisibility::Collapsed;
-}
-
-EVisibility SShooterScoreboardWidget::SpeakerIconVisibility(const FTeamPlayer TeamPlayer) const
+EVisibility SShooterScoreboardWidget::SpeakerIconVisibility(TSharedRef<FScoreboardRow> Row) const
 {
-	AShooterPlayerState* PlayerState = GetSortedPlayerState(TeamPlayer);
-	if (PlayerState)
+	for (int32 i = 0; i < PlayersTalkingThisFrame.Num(); ++i)
 	{
-		FString PlayerName = PlayerState->GetShortPlayerName();
-		for (int32 i = 0; i < PlayersTalkingThisFrame.Num(); ++i)
+		if (Row->ShortName == PlayersTalkingThisFrame[i].Key && PlayersTalkingThisFrame[i].Value)
 		{
-			if (PlayerName == PlayersTalkingThisFrame[i].Key && PlayersTalkingThisFrame[i].Value)
-			{
-				return EVisibility::Visible;
-			}
+			return EVisibility::Visible;
 		}
 	}
 	return EVisibility::Hidden;
 }
 
-FSlateColor SShooterScoreboardWidget::GetScoreboardBorderColor(const FTeamPlayer TeamPlayer) const
+FSlateColor SShooterScoreboardWidget::GetScoreboardBorderColor(TSharedRef<FScoreboardRow> Row) const
 {
+	const FTeamPlayer& TeamPlayer = Row->TeamPlayer;
 	const bool bIsSelected = IsSelectedPlayer(TeamPlayer);
 	const int32 RedTeam = 0;
 	const float BaseValue = bIsSelected == true ? 0.15f : 0.0f;
@@ -598,21 +726,15 @@ FSlateColor SShooterScoreboardWidget::GetScoreboardBorderColor(const FTeamPlayer
 	return FLinearColor(BaseValue + RedValue, BaseValue, BaseValue + BlueValue, AlphaValue);
 }
 
-FString SShooterScoreboardWidget::GetPlayerName(const FTeamPlayer TeamPlayer) const
+FText SShooterScoreboardWidget::GetPlayerName(TSharedRef<FScoreboardRow> Row) const
 {
-	const AShooterPlayerState* PlayerState = GetSortedPlayerState(TeamPlayer);
-	if (PlayerState)
-	{
-		return PlayerState->GetShortPlayerName();
-	}
-
-	return TEXT("");
+	return Row->NameText;
 }
 
-FSlateColor SShooterScoreboardWidget::GetPlayerColor(const FTeamPlayer TeamPlayer) const
+FSlateColor SShooterScoreboardWidget::GetPlayerColor(TSharedRef<FScoreboardRow> Row) const
 {
 	// If this is the owner players row, tint the text color to show ourselves more clearly
-	if( IsOwnerPlayer(TeamPlayer) )
+	if( PCOwner.IsValid() && PCOwner->PlayerState && PCOwner->PlayerState == Row->PlayerState.Get() )
 	{
 		return FSlateColor(FLinearColor::Yellow);
 	}
@@ -621,10 +743,10 @@ FSlateColor SShooterScoreboardWidget::GetPlayerColor(const FTeamPlayer TeamPlaye
 	return TextStyle.ColorAndOpacity;
 }
 
-FSlateColor SShooterScoreboardWidget::GetColumnColor(const FTeamPlayer TeamPlayer, uint8 ColIdx) const
+FSlateColor SShooterScoreboardWidget::GetColumnColor(TSharedRef<FScoreboardRow> Row, uint8 ColIdx) const
 {
 	// If this is the owner players row, tint the text color to show ourselves more clearly
-	if( IsOwnerPlayer(TeamPlayer) )
+	if( PCOwner.IsValid() && PCOwner->PlayerState && PCOwner->PlayerState == Row->PlayerState.Get() )
 	{
 		return FSlateColor(FLinearColor::Yellow);
 	}
@@ -638,30 +760,14 @@ bool SShooterScoreboardWidget::IsOwnerPlayer(const FTeamPlayer& TeamPlayer) cons
 	return ( PCOwner.IsValid() && PCOwner->PlayerState && PCOwner->PlayerState == GetSortedPlayerState(TeamPlayer) );
 }
 
-FString SShooterScoreboardWidget::GetStat(FOnGetPlayerStateAttribute Getter, const FTeamPlayer TeamPlayer) const
+FText SShooterScoreboardWidget::GetStat(TSharedRef<FScoreboardRow> Row, uint8 ColIdx) const
 {
-	int32 StatTotal = 0;
-	if (TeamPlayer.PlayerId != SpecialPlayerIndex::All)
-	{
-		AShooterPlayerState* PlayerState = GetSortedPlayerState(TeamPlayer);
-		if (PlayerState)
-		{
-			StatTotal = Getter.Execute(PlayerState);
-		}
-	} 
-	else
-	{
-		for (RankedPlayerMap::TConstIterator PlayerIt(PlayerStateMaps[TeamPlayer.TeamNum]); PlayerIt; ++PlayerIt)
-		{
-			AShooterPlayerState* PlayerState = PlayerIt.Value().Get();
-			if (PlayerState)
-			{
-				StatTotal += Getter.Execute(PlayerState);
-			}
-		}
-	}
+	return Row->ColumnText.IsValidIndex(ColIdx) ? Row->ColumnText[ColIdx] : FText::GetEmpty();
+}
 
-	return FText::AsNumber(LerpForCountup(StatTotal)).ToString();
+FText SShooterScoreboardWidget::GetTeamTotal(uint8 TeamNum) const
+{
+	return TeamTotalText.IsValidIndex(TeamNum) ? TeamTotalText[TeamNum] : FText::GetEmpty();
 }
 
 int32 SShooterScoreboardWidget::LerpForCountup(int32 ScoreValue) const
@@ -730,7 +836,7 @@ TSharedRef<SWidget> SShooterScoreboardWidget::MakeTotalsRow(uint8 TeamNum) const
 			.HAlign(HAlign_Center)
 			[
 				SNew(STextBlock)
-				.Text(this, &SShooterScoreboardWidget::GetStat, Columns.Last().AttributeGetter, FTeamPlayer(TeamNum, SpecialPlayerIndex::All))
+				.Text(this, &SShooterScoreboardWidget::GetTeamTotal, TeamNum)
 				.TextStyle(FShooterStyle::Get(), "ShooterGame.DefaultScoreboard.Row.HeaderTextStyle")
 			]
 		]
@@ -739,22 +845,7 @@ TSharedRef<SWidget> SShooterScoreboardWidget::MakeTotalsRow(uint8 TeamNum) const
 	return TotalsRow.ToSharedRef();
 }
 
-TSharedRef<SWidget> SShooterScoreboardWidget::MakePlayerRows(uint8 TeamNum) const
-{
-	TSharedRef<SVerticalBox> PlayerRows = SNew(SVerticalBox);
-
-	for (int32 PlayerIndex=0; PlayerIndex < PlayerStateMaps[TeamNum].Num(); PlayerIndex++ )
-	{
-		PlayerRows->AddSlot() .AutoHeight()
-		[
-			MakePlayerRow(FTeamPlayer(TeamNum, PlayerIndex))
-		];
-	}
-
-	return PlayerRows;
-}
-
-TSharedRef<SWidget> SShooterScoreboardWidget::MakePlayerRow(const FTeamPlayer& TeamPlayer) const
+TSharedRef<SWidget> SShooterScoreboardWidget::MakePlayerRow(TSharedRef<FScoreboardRow> Row) const
 {
 	// Make the padding here slightly smaller than NORM_PADDING, to fit in more players
 	const FMargin Pad = FMargin(5,1);
@@ -766,7 +857,7 @@ TSharedRef<SWidget> SShooterScoreboardWidget::MakePlayerRow(const FTeamPlayer& T
 	[
 		SNew(SImage)
 		.Image(FShooterStyle::Get().GetBrush("ShooterGame.Speaker"))
-		.Visibility(this, &SShooterScoreboardWidget::SpeakerIconVisibility, TeamPlayer)
+		.Visibility(this, &SShooterScoreboardWidget::SpeakerIconVisibility, Row)
 	];
 
 	//first autosized row with player name
@@ -776,15 +867,14 @@ TSharedRef<SWidget> SShooterScoreboardWidget::MakePlayerRow(const FTeamPlayer& T
 		.Padding(Pad)
 		.HAlign(HAlign_Right)
 		.VAlign(VAlign_Center)
-		.Visibility(this, &SShooterScoreboardWidget::PlayerPresenceToItemVisibility, TeamPlayer)
-		.OnMouseMove(this, &SShooterScoreboardWidget::OnMouseOverPlayer, TeamPlayer)
-		.BorderBackgroundColor(this, &SShooterScoreboardWidget::GetScoreboardBorderColor, TeamPlayer)
+		.OnMouseMove(this, &SShooterScoreboardWidget::OnMouseOverPlayer, Row)
+		.BorderBackgroundColor(this, &SShooterScoreboardWidget::GetScoreboardBorderColor, Row)
 		.BorderImage(&ScoreboardStyle->ItemBorderBrush)
 		[
 			SNew(STextBlock)
-			.Text(this, &SShooterScoreboardWidget::GetPlayerName, TeamPlayer)
+			.Text(this, &SShooterScoreboardWidget::GetPlayerName, Row)
 			.TextStyle(FShooterStyle::Get(), "ShooterGame.DefaultScoreboard.Row.StatTextStyle")
-			.ColorAndOpacity(this, &SShooterScoreboardWidget::GetPlayerColor, TeamPlayer)
+			.ColorAndOpacity(this, &SShooterScoreboardWidget::GetPlayerColor, Row)
 		]
 	];
 	//attributes rows (kills, deaths, score/captures)
@@ -797,9 +887,8 @@ TSharedRef<SWidget> SShooterScoreboardWidget::MakePlayerRow(const FTeamPlayer& T
 			.Padding(Pad)
 			.VAlign(VAlign_Center)
 			.HAlign(HAlign_Center)
-			.Visibility(this, &SShooterScoreboardWidget::PlayerPresenceToItemVisibility, TeamPlayer)
-			.OnMouseMove(this, &SShooterScoreboardWidget::OnMouseOverPlayer, TeamPlayer)
-			.BorderBackgroundColor(this, &SShooterScoreboardWidget::GetScoreboardBorderColor, TeamPlayer)
+			.OnMouseMove(this, &SShooterScoreboardWidget::OnMouseOverPlayer, Row)
+			.BorderBackgroundColor(this, &SShooterScoreboardWidget::GetScoreboardBorderColor, Row)
 			.BorderImage(&ScoreboardStyle->ItemBorderBrush)
 			[
 				SNew(SBox)
@@ -807,9 +896,9 @@ TSharedRef<SWidget> SShooterScoreboardWidget::MakePlayerRow(const FTeamPlayer& T
 				.HAlign(HAlign_Center)
 				[
 					SNew(STextBlock)
-					.Text(this, &SShooterScoreboardWidget::GetStat, Columns[ColIdx].AttributeGetter, TeamPlayer)
+					.Text(this, &SShooterScoreboardWidget::GetStat, Row, ColIdx)
 					.TextStyle(FShooterStyle::Get(), "ShooterGame.DefaultScoreboard.Row.StatTextStyle")
-					.ColorAndOpacity(this, &SShooterScoreboardWidget::GetColumnColor, TeamPlayer, ColIdx)
+					.ColorAndOpacity(this, &SShooterScoreboardWidget::GetColumnColor, Row, ColIdx)
 				]
 			]
 		];
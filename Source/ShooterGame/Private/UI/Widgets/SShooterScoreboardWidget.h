@@ -71,6 +71,38 @@ struct FTeamPlayer
 	}
 };
 
+/** retained widget and cached display strings for one player */
+struct FScoreboardRow
+{
+	/** player shown in this row */
+	TWeakObjectPtr<AShooterPlayerState> PlayerState;
+
+	/** current team and rank of the player, updated when the ranking changes */
+	FTeamPlayer TeamPlayer;
+
+	/** full player name the cached name was made from */
+	FString PlayerName;
+
+	/** cached short player name */
+	FString ShortName;
+
+	/** cached short player name, as displayed */
+	FText NameText;
+
+	/** last displayed value of each column */
+	TArray<int32> ColumnValues;
+
+	/** cached ColumnValues, as displayed */
+	TArray<FText> ColumnText;
+
+	/** still in the ranking, rows that are not get dropped */
+	bool bInRanking;
+
+	FScoreboardRow()
+		: bInRanking(false)
+	{
+	}
+};
 
 //class declare
 class SShooterScoreboardWidget : public SBorder
@@ -105,50 +137,56 @@ class SShooterScoreboardWidget : public SBorder
 
 protected:
 
-	/** updates widgets when players leave or join */
+	/** lays out team sections, totals and match outcome; player rows are reused */
 	void UpdateScoreboardGrid();
 
+	/** matches retained rows to the ranking: creates rows for new players, drops rows of leaving ones and reorders the rest */
+	void UpdatePlayerRows();
+
+	/** refreshes cached text of rows and totals whose values changed */
+	void UpdateRowText();
+
+	/** refreshes cached name and stats of one row */
+	void UpdateRowText(FScoreboardRow& Row);
+
+	/** updates cached value and text if displayed value changed */
+	void UpdateCachedStat(int32 Value, int32& CachedValue, FText& CachedText) const;
+
 	/** makes total row widget */
 	TSharedRef<SWidget> MakeTotalsRow(uint8 TeamNum) const;
 
-	/** makes player rows */
-	TSharedRef<SWidget> MakePlayerRows(uint8 TeamNum) const;
-
 	/** makes player row */
-	TSharedRef<SWidget> MakePlayerRow(const FTeamPlayer& TeamPlayer) const;
+	TSharedRef<SWidget> MakePlayerRow(TSharedRef<FScoreboardRow> Row) const;
 
 	/** updates PlayerState maps to display accurate scores */
 	void UpdatePlayerStateMaps();
 
-	/** gets ranked map for specific team */
-	void GetRankedMap(int32 TeamIndex, RankedPlayerMap& OutRankedMap) const;
-
 	/** gets PlayerState for specific team and player */
 	AShooterPlayerState* GetSortedPlayerState(const FTeamPlayer& TeamPlayer) const;
 
-	/** get player visibility */
-	EVisibility PlayerPresenceToItemVisibility(const FTeamPlayer TeamPlayer) const;
-
 	/** get speaker icon visibility */
-	EVisibility SpeakerIconVisibility(const FTeamPlayer TeamPlayer) const;
+	EVisibility SpeakerIconVisibility(TSharedRef<FScoreboardRow> Row) const;
 
 	/** get scoreboard border color */
-	FSlateColor GetScoreboardBorderColor(const FTeamPlayer TeamPlayer) const;
+	FSlateColor GetScoreboardBorderColor(TSharedRef<FScoreboardRow> Row) const;
 
 	/** get player name */
-	FString GetPlayerName(const FTeamPlayer TeamPlayer) const;
+	FText GetPlayerName(TSharedRef<FScoreboardRow> Row) const;
 
 	/** get player color */
-	FSlateColor GetPlayerColor(const FTeamPlayer TeamPlayer) const;
+	FSlateColor GetPlayerColor(TSharedRef<FScoreboardRow> Row) const;
 
 	/** get the column color */
-	FSlateColor GetColumnColor(const FTeamPlayer TeamPlayer, uint8 ColIdx) const;
+	FSlateColor GetColumnColor(TSharedRef<FScoreboardRow> Row, uint8 ColIdx) const;
 
 	/** checks to see if the specified player is the owner */
 	bool IsOwnerPlayer(const FTeamPlayer& TeamPlayer) const;
 
-	/** get specific stat for team number and optionally player */
-	FString GetStat(FOnGetPlayerStateAttribute Getter, const FTeamPlayer TeamPlayer) const;
+	/** get cached stat of player row */
+	FText GetStat(TSharedRef<FScoreboardRow> Row, uint8 ColIdx) const;
+
+	/** get cached team total */
+	FText GetTeamTotal(uint8 TeamNum) const;
 
 	/** linear interpolated score for match outcome animation */
 	int32 LerpForCountup(int32 ScoreValue) const;
@@ -172,7 +210,7 @@ protected:
 	void PlaySound(const FSlateSound& SoundToPlay) const;
 
 	/** handle the mouse moving over scoreboard entry */
-	FReply OnMouseOverPlayer(const FGeometry& Geometry, const FPointerEvent& Event, const FTeamPlayer TeamPlayer);
+	FReply OnMouseOverPlayer(const FGeometry& Geometry, const FPointerEvent& Event, TSharedRef<FScoreboardRow> Row);
 
 	/** called when the previous player wants to be selected */
 	void OnSelectedPlayerPrev();
@@ -216,12 +254,36 @@ protected:
 	/** the player currently selected in the scoreboard */
 	FTeamPlayer SelectedPlayer;
 
-	/** the Ranked PlayerState map...cleared every frame */
+	/** the Ranked PlayerState map...refreshed when GameState ranking changes */
 	TArray<RankedPlayerMap> PlayerStateMaps;
 
+	/** GameState ranked version PlayerStateMaps were built from */
+	int32 LastRankedVersion;
+
 	/** player count in each team in the last tick */
 	TArray<int32> LastTeamPlayerCount;
 
+	/** retained player rows, by PlayerId */
+	TMap<int32, TSharedRef<FScoreboardRow> > PlayerRows;
+
+	/** widgets of PlayerRows, by PlayerId; kept apart since the widgets reference their rows */
+	TMap<int32, TSharedRef<SWidget> > PlayerRowWidgets;
+
+	/** container of player rows, per team */
+	TArray<TSharedPtr<SVerticalBox> > TeamRowBoxes;
+
+	/** PlayerIds of rows currently in each team container, in display order */
+	TArray<TArray<int32> > TeamRowOrder;
+
+	/** last displayed total of each team */
+	TArray<int32> TeamTotalValues;
+
+	/** cached TeamTotalValues, as displayed */
+	TArray<FText> TeamTotalText;
+
+	/** team totals summed during UpdateRowText, reused every tick */
+	TArray<int32> TeamTotalScratch;
+
 	/** holds talking player data */
 	TArray<TPair<FString, bool>> PlayersTalkingThisFrame;
 
@@ -2,6 +2,7 @@
 
 #include "ShooterGame.h"
 #include "Particles/ParticleSystemComponent.h"
+#include "Online/ShooterMatchEvents.h"
 
 AShooterProjectile::AShooterProjectile(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
@@ -83,7 +84,15 @@ void AShooterProjectile::Explode(const FHitResult& Impact)
 
 	if (WeaponConfig.ExplosionDamage > 0 && WeaponConfig.ExplosionRadius > 0 && WeaponConfig.DamageType)
 	{
-		UGameplayStatics::ApplyRadialDamage(this, WeaponConfig.ExplosionDamage, NudgedImpactLocation, WeaponConfig.ExplosionRadius, WeaponConfig.DamageType, TArray<AActor*>(), this, MyController.Get());
+		const bool bDamagedAnything = UGameplayStatics::ApplyRadialDamage(this, WeaponConfig.ExplosionDamage, NudgedImpactLocation, WeaponConfig.ExplosionRadius, WeaponConfig.DamageType, TArray<AActor*>(), this, MyController.Get());
+
+		AShooterGameMode* GameMode = GetWorld()->GetAuthGameMode<AShooterGameMode>();
+		AShooterPlayerState* ShooterPlayerState = MyController.IsValid() ? Cast<AShooterPlayerState>(MyController->PlayerState) : NULL;
+		if (bDamagedAnything && GameMode && ShooterPlayerState)
+		{
+			FShooterMatchEvent HitEvent(EShooterMatchEvent::Hit, ShooterPlayerState, NULL, (int32)AShooterWeapon::EAmmoType::ERocket);
+			GameMode->BroadcastMatchEvent(HitEvent);
+		}
 	}
 
 	if (ExplosionTemplate)
@@ -123,6 +132,7 @@ void AShooterProjectile::OnRep_Exploded()
 	const FVector EndTrace = GetActorLocation() + ProjDirection * 150;
 	FHitResult Impact;
 	
+	INC_DWORD_STAT(STAT_ShooterWeaponTraces);
 	if (!GetWorld()->LineTraceSingle(Impact, StartTrace, EndTrace, COLLISION_PROJECTILE, FCollisionQueryParams(TEXT("ProjClient"), true, Instigator)))
 	{
 		// failsafe
@@ -2,6 +2,9 @@
 
 #include "ShooterGame.h"
 #include "Particles/ParticleSystemComponent.h"
+#include "Online/ShooterMatchEvents.h"
+#include "Online/ShooterRpcLimiter.h"
+#include "ShooterSoakTest.h"
 
 AShooterWeapon::AShooterWeapon(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
@@ -395,10 +398,21 @@ void AShooterWeapon::UseAmmo()
 				break;			
 		}
 	}
+
+	AShooterGameMode* GameMode = GetWorld()->GetAuthGameMode<AShooterGameMode>();
+	AShooterPlayerState* ShooterPlayerState = MyPawn ? Cast<AShooterPlayerState>(MyPawn->PlayerState) : NULL;
+	if (GameMode && ShooterPlayerState)
+	{
+		FShooterMatchEvent ShotEvent(EShooterMatchEvent::Shot, ShooterPlayerState, NULL, (int32)GetAmmoType());
+		GameMode->BroadcastMatchEvent(ShotEvent);
+	}
 }
 
 void AShooterWeapon::HandleFiring()
 {
+	SCOPE_CYCLE_COUNTER(STAT_ShooterHandleFiring);
+	FShooterSoakScope SoakScope(EShooterSoakSubsystem::Weapons);
+
 	if ((CurrentAmmoInClip > 0 || HasInfiniteClip() || HasInfiniteAmmo()) && CanFire())
 	{
 		if (GetNetMode() != NM_DedicatedServer)
@@ -467,11 +481,16 @@ void AShooterWeapon::HandleFiring()
 
 bool AShooterWeapon::ServerHandleFiring_Validate()
 {
-	return true;
+	return FShooterRpcLimiter::ValidateRpc(this, EShooterServerRpc::HandleFiring);
 }
 
 void AShooterWeapon::ServerHandleFiring_Implementation()
 {
+	if (FShooterRpcLimiter::IsRpcDropped(this, EShooterServerRpc::HandleFiring))
+	{
+		return;
+	}
+
 	const bool bShouldUpdateAmmo = (CurrentAmmoInClip > 0 && CanFire());
 
 	HandleFiring();
@@ -719,6 +738,7 @@ FHitResult AShooterWeapon::WeaponTrace(const FVector& StartTrace, const FVector&
 	TraceParams.bReturnPhysicalMaterial = true;
 
 	FHitResult Hit(ForceInit);
+	INC_DWORD_STAT(STAT_ShooterWeaponTraces);
 	GetWorld()->LineTraceSingle(Hit, StartTrace, EndTrace, COLLISION_WEAPON, TraceParams);
 
 	return Hit;
@@ -2,6 +2,9 @@
 
 #include "ShooterGame.h"
 #include "Particles/ParticleSystemComponent.h"
+#include "Online/ShooterMatchEvents.h"
+#include "Online/ShooterRpcLimiter.h"
+#include "ShooterNetTest.h"
 
 AShooterWeapon_Instant::AShooterWeapon_Instant(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
@@ -31,11 +34,19 @@ void AShooterWeapon_Instant::FireWeapon()
 
 bool AShooterWeapon_Instant::ServerNotifyHit_Validate(const FHitResult Impact, FVector_NetQuantizeNormal ShootDir, int32 RandomSeed, float ReticleSpread)
 {
-	return true;
+	return FShooterRpcLimiter::ValidateRpc(this, EShooterServerRpc::NotifyHit);
 }
 
 void AShooterWeapon_Instant::ServerNotifyHit_Implementation(const FHitResult Impact, FVector_NetQuantizeNormal ShootDir, int32 RandomSeed, float ReticleSpread)
 {
+	SCOPE_CYCLE_COUNTER(STAT_ShooterServerNotifyHit);
+
+	if (FShooterRpcLimiter::IsRpcDropped(this, EShooterServerRpc::NotifyHit))
+	{
+		FShooterNetTest::CountHit(EShooterNetTestHit::RejectedRateLimit);
+		return;
+	}
+
 	const float WeaponAngleDot = FMath::Abs(FMath::Sin(ReticleSpread * PI / 180.f));
 
 	// if we have an instigator, calculate dot between the view and the shot
@@ -54,6 +65,7 @@ void AShooterWeapon_Instant::ServerNotifyHit_Implementation(const FHitResult Imp
 				{
 					if (Impact.bBlockingHit)
 					{
+						FShooterNetTest::CountHit(EShooterNetTestHit::Accepted);
 						ProcessInstantHit_Confirmed(Impact, Origin, ShootDir, RandomSeed, ReticleSpread);
 					}
 				}
@@ -61,6 +73,7 @@ void AShooterWeapon_Instant::ServerNotifyHit_Implementation(const FHitResult Imp
 				// usually doesn't have significant gameplay implications
 				else if (Impact.GetActor()->IsRootComponentStatic() || Impact.GetActor()->IsRootComponentStationary())
 				{
+					FShooterNetTest::CountHit(EShooterNetTestHit::Accepted);
 					ProcessInstantHit_Confirmed(Impact, Origin, ShootDir, RandomSeed, ReticleSpread);
 				}
 				else
@@ -85,21 +98,30 @@ void AShooterWeapon_Instant::ServerNotifyHit_Implementation(const FHitResult Imp
 						FMath::Abs(Impact.Location.X - BoxCenter.X) < BoxExtent.X &&
 						FMath::Abs(Impact.Location.Y - BoxCenter.Y) < BoxExtent.Y)
 					{
+						FShooterNetTest::CountHit(EShooterNetTestHit::Accepted);
 						ProcessInstantHit_Confirmed(Impact, Origin, ShootDir, RandomSeed, ReticleSpread);
 					}
 					else
 					{
+						FShooterNetTest::CountHit(EShooterNetTestHit::RejectedBounds);
 						UE_LOG(LogShooterWeapon, Log, TEXT("%s Rejected client side hit of %s (outside bounding box tolerance)"), *GetNameSafe(this), *GetNameSafe(Impact.GetActor()));
 					}
 				}
 			}
+			else
+			{
+				FShooterNetTest::CountHit(EShooterNetTestHit::RejectedIdle);
+				UE_LOG(LogShooterWeapon, Log, TEXT("%s Rejected client side hit of %s (weapon is not firing on the server)"), *GetNameSafe(this), *GetNameSafe(Impact.GetActor()));
+			}
 		}
 		else if (ViewDotHitDir <= InstantConfig.AllowedViewDotHitDir)
 		{
+			FShooterNetTest::CountHit(EShooterNetTestHit::RejectedAngle);
 			UE_LOG(LogShooterWeapon, Log, TEXT("%s Rejected client side hit of %s (facing too far from the hit direction)"), *GetNameSafe(this), *GetNameSafe(Impact.GetActor()));
 		}
 		else
 		{
+			FShooterNetTest::CountHit(EShooterNetTestHit::Rejected);
 			UE_LOG(LogShooterWeapon, Log, TEXT("%s Rejected client side hit of %s"), *GetNameSafe(this), *GetNameSafe(Impact.GetActor()));
 		}
 	}
@@ -107,11 +129,16 @@ void AShooterWeapon_Instant::ServerNotifyHit_Implementation(const FHitResult Imp
 
 bool AShooterWeapon_Instant::ServerNotifyMiss_Validate(FVector_NetQuantizeNormal ShootDir, int32 RandomSeed, float ReticleSpread)
 {
-	return true;
+	return FShooterRpcLimiter::ValidateRpc(this, EShooterServerRpc::NotifyMiss);
 }
 
 void AShooterWeapon_Instant::ServerNotifyMiss_Implementation(FVector_NetQuantizeNormal ShootDir, int32 RandomSeed, float ReticleSpread)
 {
+	if (FShooterRpcLimiter::IsRpcDropped(this, EShooterServerRpc::NotifyMiss))
+	{
+		return;
+	}
+
 	const FVector Origin = GetMuzzleLocation();
 
 	// play FX on remote clients
@@ -211,6 +238,14 @@ void AShooterWeapon_Instant::DealDamage(const FHitResult& Impact, const FVector&
 		PointDmg.Damage *= 0.1f;
 	}
 	Impact.GetActor()->TakeDamage(PointDmg.Damage, PointDmg, MyPawn->Controller, this);
+
+	AShooterGameMode* GameMode = GetWorld()->GetAuthGameMode<AShooterGameMode>();
+	AShooterPlayerState* ShooterPlayerState = Cast<AShooterPlayerState>(MyPawn->PlayerState);
+	if (GameMode && ShooterPlayerState && Cast<AShooterCharacter>(Impact.GetActor()))
+	{
+		FShooterMatchEvent HitEvent(EShooterMatchEvent::Hit, ShooterPlayerState, NULL, (int32)GetAmmoType());
+		GameMode->BroadcastMatchEvent(HitEvent);
+	}
 }
 
 void AShooterWeapon_Instant::OnBurstFinished()
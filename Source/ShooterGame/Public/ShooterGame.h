@@ -15,6 +15,24 @@
 DECLARE_LOG_CATEGORY_EXTERN(LogShooter, Log, All);
 DECLARE_LOG_CATEGORY_EXTERN(LogShooterWeapon, Log, All);
 
+/** game code hot paths, see "stat ShooterGame"; cycle counters also report how often they were hit. Compiled out with stats, e.g. in Shipping */
+DECLARE_STATS_GROUP(TEXT("ShooterGame"), STATGROUP_ShooterGame, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("PerformMovement"), STAT_ShooterPerformMovement, STATGROUP_ShooterGame, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("PhysWalking"), STAT_ShooterPhysWalking, STATGROUP_ShooterGame, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("ComputeFloorDist"), STAT_ShooterComputeFloorDist, STATGROUP_ShooterGame, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("HandleFiring"), STAT_ShooterHandleFiring, STATGROUP_ShooterGame, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("ServerNotifyHit"), STAT_ShooterServerNotifyHit, STATGROUP_ShooterGame, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("FindClosestEnemyWithLOS"), STAT_ShooterFindClosestEnemyWithLOS, STATGROUP_ShooterGame, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("ChoosePlayerStart"), STAT_ShooterChoosePlayerStart, STATGROUP_ShooterGame, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("DrawHUD"), STAT_ShooterDrawHUD, STATGROUP_ShooterGame, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("UpdatePlayerStateMaps"), STAT_ShooterUpdatePlayerStateMaps, STATGROUP_ShooterGame, );
+
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Gravity flips"), STAT_ShooterGravityFlips, STATGROUP_ShooterGame, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Movement traces"), STAT_ShooterMovementTraces, STATGROUP_ShooterGame, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Weapon traces"), STAT_ShooterWeaponTraces, STATGROUP_ShooterGame, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("AI traces"), STAT_ShooterAITraces, STATGROUP_ShooterGame, );
+
 /** when you modify this, please note that this information can be saved with instances
  * also DefaultEngine.ini [/Script/Engine.CollisionProfile] should match with this list **/
 #define COLLISION_WEAPON		ECC_GameTraceChannel1
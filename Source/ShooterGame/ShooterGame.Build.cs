@@ -35,6 +35,7 @@ public class ShooterGame : ModuleRules
 				"Slate",
 				"SlateCore",
 				"ShooterGameLoadingScreen",
+				"Sockets",
 			}
 		);
 
@@ -6,9 +6,13 @@
 #include "SlateBasics.h"
 #include "SlateExtras.h"
 #include "MoviePlayer.h"
+#include "Engine.h"
 
 // This module must be loaded "PreLoadingScreen" in the .uproject file, otherwise it will not hook in time!
 
+/** longest time a load waits for streaming levels and async loads after PostLoadMap, before it's logged anyway (seconds) */
+static const double MaxStreamingSeconds = 60.0;
+
 struct FShooterGameLoadingScreenBrush : public FSlateDynamicImageBrush, public FGCObject
 {
 	FShooterGameLoadingScreenBrush( const FName InTextureName, const FVector2D& InImageSize )
@@ -26,14 +30,60 @@ struct FShooterGameLoadingScreenBrush : public FSlateDynamicImageBrush, public F
 	}
 };
 
+namespace EShooterLoadPhase
+{
+	enum Type
+	{
+		/** no map change in progress, packages may be preloading */
+		Idle,
+		/** between PreLoadMap and world initialization */
+		PackageLoad,
+		/** between world initialization and PostLoadMap */
+		WorldInit,
+		/** map loaded, waiting for streaming levels and pending async loads */
+		Streaming,
+	};
+}
+
+/** progress of the current load, written on the game thread and read by the loading screen on the movie player thread */
+struct FShooterLoadingProgress
+{
+	/** EShooterLoadPhase */
+	FThreadSafeCounter Phase;
+
+	/** progress of async package loading, in 1/1000 */
+	FThreadSafeCounter PackagePermille;
+
+	/** loaded streaming levels, in 1/1000 */
+	FThreadSafeCounter StreamingPermille;
+
+	/** get overall progress (0..1) */
+	float Get() const
+	{
+		switch (Phase.GetValue())
+		{
+			case EShooterLoadPhase::WorldInit:
+				return 0.7f;
+			case EShooterLoadPhase::Streaming:
+				return 0.85f + 0.15f * StreamingPermille.GetValue() / 1000.0f;
+			default:
+				return 0.6f * PackagePermille.GetValue() / 1000.0f;
+		}
+	}
+};
+
 class SShooterLoadingScreen2 : public SCompoundWidget
 {
 public:
 	SLATE_BEGIN_ARGS(SShooterLoadingScreen2) {}
+		SLATE_ARGUMENT(TSharedPtr<FShooterLoadingProgress>, Progress)
 	SLATE_END_ARGS()
 
 	void Construct(const FArguments& InArgs)
 	{
+		Progress = InArgs._Progress;
+		DisplayedProgress = Progress.IsValid() ? Progress->Get() : 0.0f;
+
 		static const FName LoadingScreenName(TEXT("/Game/UI/Menu/LoadingScreen.LoadingScreen"));
 
 		//since we are not using game styles here, just load one image
@@ -59,31 +109,89 @@ public:
 				.Padding(10.0f)
 				.IsTitleSafe(true)
 				[
-					SNew(SThrobber)
-					.Visibility(this, &SShooterLoadingScreen2::GetLoadIndicatorVisibility)
+					SNew(SVerticalBox)
+					+SVerticalBox::Slot()
+					.AutoHeight()
+					.HAlign(HAlign_Right)
+					[
+						SNew(SThrobber)
+						.Visibility(this, &SShooterLoadingScreen2::GetLoadIndicatorVisibility)
+					]
+					+SVerticalBox::Slot()
+					.AutoHeight()
+					[
+						SNew(SBox)
+						.WidthOverride(400.0f)
+						[
+							SNew(SProgressBar)
+							.Percent(this, &SShooterLoadingScreen2::GetProgressPercent)
+						]
+					]
 				]
 			]
 		];
 	}
 
+	/** ticked by the movie player thread, so the bar keeps moving while the game thread is busy loading */
+	virtual void Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime) override
+	{
+		SCompoundWidget::Tick(AllottedGeometry, InCurrentTime, InDeltaTime);
+
+		// ease towards reported progress, and creep slowly while nothing is reported so a long stall doesn't look like a hang
+		const float Target = Progress.IsValid() ? Progress->Get() : 0.0f;
+		if (DisplayedProgress < Target)
+		{
+			DisplayedProgress = FMath::FInterpTo(DisplayedProgress, Target, InDeltaTime, 5.0f);
+		}
+		else
+		{
+			DisplayedProgress = FMath::Min(DisplayedProgress + InDeltaTime * 0.005f, FMath::Max(Target, 0.95f));
+		}
+	}
+
 private:
 	EVisibility GetLoadIndicatorVisibility() const
 	{
 		return EVisibility::Visible;
 	}
 
+	TOptional<float> GetProgressPercent() const
+	{
+		return DisplayedProgress;
+	}
+
 	/** loading screen image brush */
 	TSharedPtr<FSlateDynamicImageBrush> LoadingScreenBrush;
+
+	/** progress shared with the module */
+	TSharedPtr<FShooterLoadingProgress> Progress;
+
+	/** progress shown by the bar, smoothed */
+	float DisplayedProgress;
 };
 
 class FShooterGameLoadingScreenModule : public IShooterGameLoadingScreenModule
 {
 public:
+	FShooterGameLoadingScreenModule()
+		: Progress(MakeShareable(new FShooterLoadingProgress()))
+		, LoadStartTime(0.0)
+		, WorldInitTime(0.0)
+		, MapLoadedTime(0.0)
+	{
+	}
+
 	virtual void StartupModule() override
 	{		
 		// Load for cooker reference
 		LoadObject<UObject>(NULL, TEXT("/Game/UI/Menu/LoadingScreen.LoadingScreen") );
 
+		FCoreUObjectDelegates::PreLoadMap.AddRaw(this, &FShooterGameLoadingScreenModule::OnPreLoadMap);
+		FCoreUObjectDelegates::PostLoadMap.AddRaw(this, &FShooterGameLoadingScreenModule::OnPostLoadMap);
+		FWorldDelegates::OnPostWorldInitialization.AddRaw(this, &FShooterGameLoadingScreenModule::OnPostWorldInitialization);
+		TickDelegate = FTickerDelegate::CreateRaw(this, &FShooterGameLoadingScreenModule::Tick);
+		FTicker::GetCoreTicker().AddTicker(TickDelegate);
+
 		if (IsMoviePlayerEnabled())
 		{
 			FLoadingScreenAttributes LoadingScreen;
@@ -93,6 +201,14 @@ public:
 		}
 	}
 	
+	virtual void ShutdownModule() override
+	{
+		FCoreUObjectDelegates::PreLoadMap.RemoveAll(this);
+		FCoreUObjectDelegates::PostLoadMap.RemoveAll(this);
+		FWorldDelegates::OnPostWorldInitialization.RemoveAll(this);
+		FTicker::GetCoreTicker().RemoveTicker(TickDelegate);
+	}
+	
 	virtual bool IsGameModule() const override
 	{
 		return true;
@@ -102,10 +218,122 @@ public:
 	{
 		FLoadingScreenAttributes LoadingScreen;
 		LoadingScreen.bAutoCompleteWhenLoadingCompletes = true;
-		LoadingScreen.WidgetLoadingScreen = SNew(SShooterLoadingScreen2);
+		LoadingScreen.WidgetLoadingScreen = SNew(SShooterLoadingScreen2).Progress(Progress);
 
 		GetMoviePlayer()->SetupLoadingScreen(LoadingScreen);
 	}
+
+	virtual void SetPackageLoadProgress(float InProgress) override
+	{
+		Progress->PackagePermille.Set(FMath::Clamp(FMath::RoundToInt(InProgress * 1000.0f), 0, 1000));
+	}
+
+	virtual void SetLevelStreamingProgress(int32 NumLoaded, int32 NumTotal) override
+	{
+		Progress->StreamingPermille.Set(NumTotal > 0 ? FMath::Clamp(NumLoaded * 1000 / NumTotal, 0, 1000) : 1000);
+	}
+
+	virtual float GetLoadingProgress() const override
+	{
+		return Progress->Get();
+	}
+
+private:
+	void OnPreLoadMap()
+	{
+		Progress->Phase.Set(EShooterLoadPhase::PackageLoad);
+		Progress->StreamingPermille.Set(0);
+		LoadStartTime = FPlatformTime::Seconds();
+		WorldInitTime = 0.0;
+		MapLoadedTime = 0.0;
+		MapName.Empty();
+	}
+
+	void OnPostWorldInitialization(UWorld* World, const UWorld::InitializationValues IVS)
+	{
+		// only the world of the map being loaded, not preview or editor worlds
+		if (Progress->Phase.GetValue() == EShooterLoadPhase::PackageLoad && World && World->IsGameWorld())
+		{
+			Progress->Phase.Set(EShooterLoadPhase::WorldInit);
+			WorldInitTime = FPlatformTime::Seconds();
+			MapName = World->GetMapName();
+		}
+	}
+
+	void OnPostLoadMap()
+	{
+		if (Progress->Phase.GetValue() != EShooterLoadPhase::Idle)
+		{
+			Progress->Phase.Set(EShooterLoadPhase::Streaming);
+			MapLoadedTime = FPlatformTime::Seconds();
+		}
+	}
+
+	/** core ticker, ends the streaming phase once every streaming level the game reported is in and nothing is loading anymore */
+	bool Tick(float DeltaSeconds)
+	{
+		if (Progress->Phase.GetValue() == EShooterLoadPhase::Streaming)
+		{
+			const double Now = FPlatformTime::Seconds();
+			const bool bStreamingDone = Progress->StreamingPermille.GetValue() >= 1000 && !IsAsyncLoading();
+			if (bStreamingDone || Now - MapLoadedTime > MaxStreamingSeconds)
+			{
+				WriteLoadTimes(Now);
+				Progress->Phase.Set(EShooterLoadPhase::Idle);
+				Progress->PackagePermille.Set(0);
+			}
+		}
+		return true;
+	}
+
+	/** append timings of the finished load to Saved/Logs/LoadTimes.csv, one line per map load */
+	void WriteLoadTimes(double StreamingDoneTime)
+	{
+		// world init is skipped when the map could not be loaded
+		const double PackageLoadEnd = WorldInitTime > 0.0 ? WorldInitTime : MapLoadedTime;
+		const double PackageLoadSeconds = PackageLoadEnd - LoadStartTime;
+		const double WorldInitSeconds = MapLoadedTime - PackageLoadEnd;
+		const double StreamingSeconds = StreamingDoneTime - MapLoadedTime;
+		const double TotalSeconds = StreamingDoneTime - LoadStartTime;
+
+		UE_LOG(LogLoad, Log, TEXT("Loaded %s in %.3fs: package load %.3fs, world init %.3fs, streaming %.3fs"),
+			*MapName, TotalSeconds, PackageLoadSeconds, WorldInitSeconds, StreamingSeconds);
+
+		const FString Path = FPaths::GameSavedDir() + TEXT("Logs/LoadTimes.csv");
+		const bool bNewFile = !IFileManager::Get().FileExists(*Path);
+		FArchive* File = IFileManager::Get().CreateFileWriter(*Path, FILEWRITE_Append);
+		if (File == NULL)
+		{
+			return;
+		}
+
+		FString Lines;
+		if (bNewFile)
+		{
+			Lines += TEXT("Date,Map,PackageLoad,WorldInit,Streaming,Total\r\n");
+		}
+		Lines += FString::Printf(TEXT("%s,%s,%.3f,%.3f,%.3f,%.3f\r\n"),
+			*FDateTime::Now().ToString(), *MapName, PackageLoadSeconds, WorldInitSeconds, StreamingSeconds, TotalSeconds);
+
+		FTCHARToUTF8 Utf8Lines(*Lines);
+		File->Serialize((void*)Utf8Lines.Get(), Utf8Lines.Length());
+		File->Close();
+		delete File;
+	}
+
+	/** progress shared with the loading screen widget */
+	TSharedRef<FShooterLoadingProgress> Progress;
+
+	/** when the current phases started, FPlatformTime::Seconds */
+	double LoadStartTime;
+	double WorldInitTime;
+	double MapLoadedTime;
+
+	/** map being loaded */
+	FString MapName;
+
+	/** delegate for the core ticker */
+	FTickerDelegate TickDelegate;
 };
 
 IMPLEMENT_GAME_MODULE(FShooterGameLoadingScreenModule, ShooterGameLoadingScreen);
@@ -12,6 +12,15 @@ class IShooterGameLoadingScreenModule : public IModuleInterface
 public:
 	/** Kicks off the loading screen for in game loading (not startup) */
 	virtual void StartInGameLoadingScreen() = 0;
+
+	/** Reports how far async loading of the map package has got (0..1), game thread only */
+	virtual void SetPackageLoadProgress(float Progress) = 0;
+
+	/** Reports how many of the streaming levels that should be loaded are loaded, game thread only. A map load ends once all are in and no async loads are pending */
+	virtual void SetLevelStreamingProgress(int32 NumLoaded, int32 NumTotal) = 0;
+
+	/** Gets overall progress of the current load (0..1), safe to call from the movie player thread */
+	virtual float GetLoadingProgress() const = 0;
 };
 
 #endif // __SHOOTERGAMELOADINGSCREEN_H__
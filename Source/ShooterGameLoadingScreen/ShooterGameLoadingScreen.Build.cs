@@ -14,6 +14,7 @@ public class ShooterGameLoadingScreen : ModuleRules
 			new string[] {
 				"Core",
 				"CoreUObject",
+				"Engine",
 				"MoviePlayer",
 				"Slate",
 				"SlateCore",